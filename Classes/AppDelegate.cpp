@@ -1,5 +1,15 @@
 #include "AppDelegate.h"
 #include "HelloWorldScene.h"
+#include "services/GameLog.h"
+
+#if CARD_PERF_GATE
+#include "services/PerfRegressionGate.h"
+#endif
+
+#if CARD_HEADLESS
+#include "services/HeadlessGLView.h"
+#include "services/HeadlessSession.h"
+#endif
 
 // 音频引擎选择（当前未启用）
 // #define USE_AUDIO_ENGINE 1
@@ -39,6 +49,9 @@ AppDelegate::~AppDelegate()
 #elif USE_SIMPLE_AUDIO_ENGINE
     SimpleAudioEngine::end();
 #endif
+
+    // 停止日志线程并输出残留日志，不留给静态析构
+    GameLog::getInstance().shutdown();
 }
 
 /**
@@ -67,10 +80,50 @@ static int register_all_packages()
  */
 bool AppDelegate::applicationDidFinishLaunching()
 {
+#if CARD_PERF_GATE
+    // 性能回归门禁模式：不创建窗口，跑完基准测试后以退出码报告结果
+    bool passed = PerfRegressionGate::run("level_1.json", "perf/perf_baseline.json");
+    GameLog::getInstance().shutdown();
+    exit(passed ? 0 : 1);
+#endif
+
     // 获取导演实例
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
 
+#if CARD_HEADLESS
+    // 无界面模式：隐藏窗口 + 虚拟时钟，跑完一局完整对局后以退出码报告结果
+    if (!glview)
+    {
+        glview = HeadlessGLView::create(
+            "card_game",
+            Rect(0, 0, designResolutionSize.width, designResolutionSize.height)
+        );
+        if (!glview)
+        {
+            exit(1);
+        }
+        director->setOpenGLView(glview);
+    }
+    glview->setDesignResolutionSize(
+        designResolutionSize.width,
+        designResolutionSize.height,
+        ResolutionPolicy::FIXED_WIDTH
+    );
+    register_all_packages();
+
+    HeadlessSessionOptions options;
+#if CARD_HEADLESS_RENDER
+    options.render = true;
+#endif
+#if CARD_HEADLESS_AUTO_PLAY
+    options.autoPlay = true;
+#endif
+    bool passed = HeadlessSession::run(HelloWorld::createScene(), options);
+    GameLog::getInstance().shutdown();
+    exit(passed ? 0 : 1);
+#endif
+
     // 创建OpenGL视图（根据平台适配）
     if (!glview)
     {
@@ -151,6 +204,13 @@ void AppDelegate::applicationDidEnterBackground()
     // 停止动画
     Director::getInstance()->stopAnimation();
 
+    // 移动平台进入后台后进程可能被直接杀掉，先保存对局并输出已缓冲的日志
+    if (auto scene = dynamic_cast<HelloWorld*>(Director::getInstance()->getRunningScene()))
+    {
+        scene->saveState();
+    }
+    GameLog::getInstance().flush();
+
     // 暂停音频
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
@@ -168,6 +228,12 @@ void AppDelegate::applicationWillEnterForeground()
     // 恢复动画
     Director::getInstance()->startAnimation();
 
+    // 进程没有被杀，进入后台时的存档已不再需要
+    if (auto scene = dynamic_cast<HelloWorld*>(Director::getInstance()->getRunningScene()))
+    {
+        scene->discardSavedState();
+    }
+
     // 恢复音频
 #if USE_AUDIO_ENGINE
     AudioEngine::resumeAll();
@@ -6,6 +6,62 @@
 #include "models/GameModel.h"
 #include "views/GameView.h"
 #include "services/GameModelFromLevelGenerator.h"
+#include "services/SessionJournal.h"
+#include "services/SaveStateCodec.h"
+#include "services/StatsStore.h"
+#include "services/AnalyticsPipeline.h"
+#include "services/GameLog.h"
+#include "services/SolutionTable.h"
+#include <cstdio>
+#include <ctime>
+
+#if CARD_STRESS_MODE
+#include "services/PerfMonitor.h"
+#include "services/StressLevelGenerator.h"
+#include "services/StressTestRunner.h"
+
+// 压力测试关卡的游戏区卡牌数量，可在编译时覆盖（如 500、5000）
+#ifndef CARD_STRESS_CARD_COUNT
+#define CARD_STRESS_CARD_COUNT 500
+#endif
+#endif
+
+// 会话日志（进程被杀后恢复对局），无界面模式下默认关闭，保证每次运行都从关卡初始状态开始
+#ifndef CARD_SESSION_JOURNAL
+#if CARD_HEADLESS
+#define CARD_SESSION_JOURNAL 0
+#else
+#define CARD_SESSION_JOURNAL 1
+#endif
+#endif
+
+// 存档（进入后台时保存对局，进程在后台被杀后下次启动直接载入），无界面模式下默认关闭
+#ifndef CARD_SAVE_STATE
+#if CARD_HEADLESS
+#define CARD_SAVE_STATE 0
+#else
+#define CARD_SAVE_STATE 1
+#endif
+#endif
+
+// 每日挑战：按当天日期的种子发牌代替level_1.json，默认关闭
+#ifndef CARD_DAILY_CHALLENGE
+#define CARD_DAILY_CHALLENGE 0
+#endif
+
+// 演示模式：进入关卡后由自动对局机器人走完整局，默认关闭
+#ifndef CARD_AUTO_PLAY
+#define CARD_AUTO_PLAY 0
+#endif
+
+// 离线分析事件管线，无界面模式下默认关闭
+#ifndef CARD_ANALYTICS
+#if CARD_HEADLESS
+#define CARD_ANALYTICS 0
+#else
+#define CARD_ANALYTICS 1
+#endif
+#endif
 
 USING_NS_CC;
 
@@ -14,6 +70,25 @@ Scene* HelloWorld::createScene()
     return HelloWorld::create();
 }
 
+HelloWorld::HelloWorld()
+    : _gameController(nullptr), _gameRecorded(false), _clearedSubscription(-1), _deadEndSubscription(-1),
+      _restartSubscription(-1)
+{
+}
+
+HelloWorld::~HelloWorld()
+{
+    if (_gameContext)
+    {
+        _gameContext->getEventBus().unsubscribe<LevelClearedEvent>(_clearedSubscription);
+        _gameContext->getEventBus().unsubscribe<NoMovesLeftEvent>(_deadEndSubscription);
+        _gameContext->getEventBus().unsubscribe<CommandAppliedEvent>(_restartSubscription);
+    }
+    _statsStore.reset();
+    _analytics.reset();
+    _journal.reset();
+}
+
 // 资源加载失败提示函数
 static void problemLoading(const char* filename)
 {
@@ -21,6 +96,32 @@ static void problemLoading(const char* filename)
     printf("Depending on how you compiled you might have to add 'Resources/' in front of filenames in HelloWorldScene.cpp\n");
 }
 
+// 存档文件路径（可写目录下的savestate.bin）
+static std::string saveStatePath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "savestate.bin";
+}
+
+// 存档的初始棋盘是否就是本关的初始棋盘（逐槽位比较卡牌ID、牌面、花色与区域）
+static bool sameInitialBoard(const GameModel& saved, const GameModel& level)
+{
+    const CardStore& a = saved.getCards();
+    const CardStore& b = level.getCards();
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (int slot = 0; slot < a.size(); ++slot)
+    {
+        if (a.getId(slot) != b.getId(slot) || a.getFace(slot) != b.getFace(slot) ||
+            a.getSuit(slot) != b.getSuit(slot) || a.getZone(slot) != b.getZone(slot))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 // 场景初始化方法
 bool HelloWorld::init()
 {
@@ -77,12 +178,195 @@ bool HelloWorld::init()
     addChild(bottomLayer, 0);
 
     // 4. 生成游戏模型和视图
-    auto gameModel = GameModelFromLevelGenerator::generateGameModel("level_1.json");
-    GameModelFromLevelGenerator::generateGameView(gameModel, this);
+#if CARD_STRESS_MODE
+    // 压力测试模式：生成超大合成关卡，并由脚本驱动节点逐帧操作和采样
+    const int stackCount = CARD_STRESS_CARD_COUNT / 10;
+    std::string levelFile = StressLevelGenerator::generateLevelFile(CARD_STRESS_CARD_COUNT, stackCount, 20240101);
+    auto gameModel = GameModelFromLevelGenerator::generateGameModel(levelFile);
+
+    PerfScope creationScope;
+    auto gameView = GameModelFromLevelGenerator::generateGameView(gameModel, this);
+    double creationMs = creationScope.elapsedNs() / 1e6;
+    if (gameView) {
+        this->addChild(StressTestRunner::create(gameView, CARD_STRESS_CARD_COUNT + stackCount, creationMs));
+    }
+#else
+#if CARD_DAILY_CHALLENGE
+    std::time_t now = std::time(nullptr);
+    std::tm today = *std::localtime(&now);
+    std::string levelFile = DealEngine::levelName(DealEngine::dailySeed(today.tm_year + 1900, today.tm_mon + 1, today.tm_mday));
+#else
+    std::string levelFile = "level_1.json";
+#endif
+#if CARD_SESSION_JOURNAL
+    // 上次会话被中断时，从会话日志恢复关卡与指令
+    const std::string journalPath = SessionJournal::defaultPath();
+    JournalContents recovered;
+    bool resumed = SessionJournal::recover(journalPath, recovered) && !recovered.levelFile.empty();
+    if (resumed)
+    {
+        levelFile = recovered.levelFile;
+    }
+#endif
+
+    _gameContext = std::make_shared<GameContext>();
+    auto gameModel = GameModelFromLevelGenerator::generateGameModel(levelFile, _gameContext->getLayout());
+    auto gameView = GameModelFromLevelGenerator::generateGameView(gameModel, this, _gameContext);
+    std::string solutionFile = SolutionTable::fileForLevel(levelFile);
+    if (gameView && !solutionFile.empty())
+    {
+        // 随关卡发布的预计算提示表，第一次查询时才读取
+        gameView->setSolutionTable(std::unique_ptr<SolutionTable>(new SolutionTable(solutionFile)));
+    }
+    _levelFile = levelFile;
+    _gameController = gameView ? gameView->getGameController() : nullptr;
+
+#if CARD_SESSION_JOURNAL
+    if (gameView)
+    {
+        // 进程在后台被杀时留下的存档属于本关时直接载入，不必重放；否则重放指令重建棋盘与撤销历史
+        // （关卡文件已改动时丢弃旧日志），之后继续记录本次会话
+        const int cardCount = gameModel.getCards().size();
+        if (loadSavedState())
+        {
+            // 日志以存档的撤销历史为起点重写，与载入的棋盘保持一致
+            SessionJournal::commandsFromUndo(_gameController->getGameModel().getUndoModel(), recovered.commands);
+        }
+        else if (resumed && recovered.cardCount == cardCount)
+        {
+            gameView->getGameController()->replayCommands(recovered.commands);
+        }
+        else
+        {
+            recovered.commands.clear();
+        }
+        _journal.reset(new SessionJournal());
+        _journal->start(journalPath, levelFile, cardCount, recovered.commands, &_gameContext->getEventBus());
+    }
+#else
+    // 进程在后台被杀时留下的存档属于本关时直接载入
+    loadSavedState();
+#endif
+
+#if CARD_AUTO_PLAY
+    if (gameView)
+    {
+        gameView->setAutoPlay(true);
+    }
+#endif
+
+#if CARD_ANALYTICS
+    // 分析事件在重放会话日志之后开始采集，每帧开始时重置每帧上限并交出超时的事件块
+    _analytics.reset(new AnalyticsPipeline());
+    _analytics->setUploader(&AnalyticsPipeline::logSummary);
+    _analytics->start(AnalyticsPipeline::defaultDirectory(), &_gameContext->getEventBus());
+    schedule([this](float) { _analytics->beginFrame(); }, "analytics_frame");
+#endif
+
+#if CARD_STATS_STORE && !CARD_HEADLESS
+    // 每局结束（过关或死局）写入本地统计库；在重放会话日志之后订阅，恢复的对局不会重复记录
+    _statsStore.reset(new StatsStore());
+    if (gameView && _statsStore->open(StatsStore::defaultPath()))
+    {
+        LevelStats stats;
+        if (_statsStore->queryLevelStats(levelFile, stats))
+        {
+            GLOG_INFO(u8"本关统计 - 对局：%d，过关：%d，最高分：%d，过关移动次数中位数：%.1f",
+                stats.attempts, stats.wins, stats.bestScore, stats.medianMoves);
+        }
+
+        _clearedSubscription = _gameContext->getEventBus().subscribe<LevelClearedEvent>(
+            [this](const LevelClearedEvent&) { recordGame(true); });
+        _deadEndSubscription = _gameContext->getEventBus().subscribe<NoMovesLeftEvent>(
+            [this](const NoMovesLeftEvent&) { recordGame(false); });
+        // 结束后撤销再结束仍是同一局，只有重新开始才算新的一局
+        _restartSubscription = _gameContext->getEventBus().subscribe<CommandAppliedEvent>(
+            [this](const CommandAppliedEvent& event)
+            {
+                if (event.accepted && event.command.type == GameCommandType::Restart)
+                {
+                    _gameRecorded = false;
+                }
+            });
+    }
+#endif
+#endif
 
     return true;
 }
 
+// 把刚结束的一局（含回放）交给统计库，由其后台线程批量写入；每局只记录第一次结束
+void HelloWorld::recordGame(bool won)
+{
+    if (!_statsStore || !_gameController || _gameRecorded)
+    {
+        return;
+    }
+    _gameRecorded = true;
+    GameRecord record;
+    record.levelFile = _levelFile;
+    record.won = won;
+    record.moveCount = _gameController->getMoveCount();
+    record.score = _gameController->getScore();
+    record.finishedAt = static_cast<int64_t>(std::time(nullptr));
+    SaveStateCodec::encode(_gameController->getInitialModel(), _gameController->getGameModel(),
+        record.moveCount, record.score, record.replay);
+    _statsStore->record(std::move(record));
+}
+
+void HelloWorld::saveState()
+{
+#if CARD_SAVE_STATE
+    if (!_gameController)
+    {
+        return;
+    }
+    // 已结束的对局不保存，下次启动从关卡初始状态开始
+    if (_gameController->getStatus() != GameStatus::Playing)
+    {
+        discardSavedState();
+        return;
+    }
+    std::vector<uint8_t> data;
+    if (SaveStateCodec::encode(_gameController->getInitialModel(), _gameController->getGameModel(),
+        _gameController->getMoveCount(), _gameController->getScore(), data) &&
+        SaveStateCodec::writeFile(saveStatePath(), data))
+    {
+        GLOG_INFO(u8"已保存存档 - 移动次数：%d，字节数：%d", _gameController->getMoveCount(), static_cast<int>(data.size()));
+    }
+#endif
+}
+
+void HelloWorld::discardSavedState()
+{
+#if CARD_SAVE_STATE
+    std::remove(saveStatePath().c_str());
+#endif
+}
+
+bool HelloWorld::loadSavedState()
+{
+#if CARD_SAVE_STATE
+    std::vector<uint8_t> data;
+    if (!_gameController || !SaveStateCodec::readFile(saveStatePath(), data))
+    {
+        return false;
+    }
+    // 存档只对紧接着的这次启动有效，之后的进度由会话日志记录
+    discardSavedState();
+    SaveState state;
+    if (!SaveStateCodec::decode(data.data(), data.size(), state) ||
+        !sameInitialBoard(state.initial, _gameController->getInitialModel()))
+    {
+        GLOG_WARN(u8"存档无效或不属于本关，忽略");
+        return false;
+    }
+    return _gameController->loadState(state.current, state.moveCount, state.score);
+#else
+    return false;
+#endif
+}
+
 // 关闭按钮点击事件回调
 void HelloWorld::menuCloseCallback(Ref* pSender)
 {
@@ -2,11 +2,22 @@
 #define __HELLOWORLD_SCENE_H__
 
 #include "cocos2d.h"
+#include <memory>
+#include <string>
+
+class GameContext;
+class SessionJournal;
+class StatsStore;
+class AnalyticsPipeline;
+class GameController;
 
  /**
   * @brief 游戏主场景类，继承自 cocos2d::Scene
   * 作为游戏的入口场景，负责初始化整体界面布局（包括背景分层）、
   * 加载关卡数据、创建游戏核心视图，并处理全局UI交互（如关闭按钮）
+  * 启动时若存在上次中断的会话日志，则恢复其关卡、棋盘与撤销历史，并继续记录本次会话
+  * 进入后台时把对局写入存档，进程在后台被杀后下次启动直接载入存档，不必重放会话日志
+  * 每局结束时把胜负、移动次数、得分与回放写入本地统计库；对局中的操作事件交给离线分析管线
   */
 class HelloWorld : public cocos2d::Scene
 {
@@ -18,6 +29,14 @@ public:
      */
     static cocos2d::Scene* createScene();
 
+    // 构造与析构在实现文件中定义（成员持有的类型在此只有前置声明）
+    HelloWorld();
+
+    /**
+     * @brief 析构函数：先退订统计记录、关闭统计库、停止分析管线与会话日志，再释放对局上下文
+     */
+    virtual ~HelloWorld();
+
     /**
      * @brief 初始化场景
      * 实现场景的核心初始化逻辑：设置背景分层、添加交互控件、
@@ -33,8 +52,42 @@ public:
      */
     void menuCloseCallback(cocos2d::Ref* pSender);
 
+    /**
+     * @brief 保存存档（应用进入后台时调用）；对局已结束时删除旧存档
+     */
+    void saveState();
+
+    /**
+     * @brief 删除存档（应用回到前台时调用：进程仍在，之后的进度由会话日志记录，旧存档已过时）
+     */
+    void discardSavedState();
+
     // 启用CREATE_FUNC宏，自动生成create()方法实现
     CREATE_FUNC(HelloWorld);
+
+private:
+    /**
+     * @brief 载入上次进入后台时保存的存档（读取后即删除）
+     * @return 存档属于本关且载入成功返回true
+     */
+    bool loadSavedState();
+
+    /**
+     * @brief 把刚结束的一局写入统计库（过关或死局事件回调）；结束后撤销再结束不重复记录
+     * @param won 是否过关
+     */
+    void recordGame(bool won);
+
+    std::shared_ptr<GameContext> _gameContext; // 对局上下文（与游戏视图共享）
+    std::unique_ptr<SessionJournal> _journal;  // 会话日志（声明在上下文之后，先于上下文释放）
+    std::unique_ptr<StatsStore> _statsStore;   // 本地统计库
+    std::unique_ptr<AnalyticsPipeline> _analytics; // 离线分析事件管线
+    std::string _levelFile;                    // 当前关卡文件
+    GameController* _gameController;           // 游戏视图的控制器（不持有）
+    bool _gameRecorded;                        // 本局已写入统计库（重新开始时清除）
+    int _clearedSubscription;                  // 记录过关对局的订阅句柄
+    int _deadEndSubscription;                  // 记录死局对局的订阅句柄
+    int _restartSubscription;                  // 重新开始时清除记录标记的订阅句柄
 };
 
 #endif // __HELLOWORLD_SCENE_H__
\ No newline at end of file
@@ -0,0 +1,28 @@
+// 由 level_pipeline builtin 生成，请勿手工修改；改动下列关卡文件后重新生成并提交
+// level_1.json
+#pragma once
+#ifndef CONFIGS_GENERATED_BUILTINLEVELS_H
+#define CONFIGS_GENERATED_BUILTINLEVELS_H
+
+#include "configs/models/BuiltinLevel.h"
+
+constexpr BuiltinCard kBuiltinLevel0Playfield[] = {
+    { 12, 0, 250, 1000 },
+    { 2, 0, 300, 800 },
+    { 2, 1, 350, 600 },
+    { 2, 0, 850, 1000 },
+    { 2, 0, 800, 800 },
+    { 1, 3, 750, 600 },
+};
+
+constexpr BuiltinCard kBuiltinLevel0Stack[] = {
+    { 2, 0, 0, 0 },
+    { 0, 2, 0, 0 },
+    { 3, 0, 0, 0 },
+};
+
+constexpr BuiltinLevel kBuiltinLevels[] = {
+    { "level_1.json", RuleVariant::Adjacent, -1, kBuiltinLevel0Playfield, 6, kBuiltinLevel0Stack, 3 },
+};
+
+#endif // CONFIGS_GENERATED_BUILTINLEVELS_H
@@ -0,0 +1,41 @@
+#include "configs/loaders/BuiltinLevelLoader.h"
+#include "configs/generated/BuiltinLevels.h"
+
+const BuiltinLevel* BuiltinLevelLoader::findLevel(const std::string& levelFile) {
+    for (const BuiltinLevel& level : kBuiltinLevels) {
+        if (levelFile == level.levelFile) {
+            return &level;
+        }
+    }
+    return nullptr;
+}
+
+bool BuiltinLevelLoader::loadLevel(const std::string& levelFile, const BoardLayout& layout, GameModel& outModel) {
+    const BuiltinLevel* level = findLevel(levelFile);
+    if (!level) {
+        return false;
+    }
+
+    RuleParams ruleParams;
+    ruleParams.variant = level->variant;
+    ruleParams.wildFace = level->wildFace;
+
+    // 与GameModel(LevelConfig*)相同：槽位与ID按 游戏区、牌堆区 的关卡顺序排列
+    GameModel gameModel(nullptr);
+    gameModel.setRuleParams(ruleParams);
+    gameModel.reserveZones(level->playfieldCount, level->stackCount);
+    int nextId = 0;
+    const CardZone zones[2] = { CardZone::Playfield, CardZone::Stack };
+    for (CardZone zone : zones) {
+        const BuiltinCard* cards = zone == CardZone::Playfield ? level->playfield : level->stack;
+        const int count = zone == CardZone::Playfield ? level->playfieldCount : level->stackCount;
+        for (int i = 0; i < count; ++i) {
+            cocos2d::Vec2 position(static_cast<float>(cards[i].x), static_cast<float>(cards[i].y));
+            position += layout.offsetFor(zone);
+            gameModel.addCard(CardModel(static_cast<CardFaceType>(cards[i].face),
+                static_cast<CardSuitType>(cards[i].suit), position, nextId++, zone));
+        }
+    }
+    outModel = std::move(gameModel);
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef CONFIGS_LOADERS_BUILTINLEVELLOADER_H
+#define CONFIGS_LOADERS_BUILTINLEVELLOADER_H
+
+#include "configs/models/BoardLayout.h"
+#include "configs/models/BuiltinLevel.h"
+#include "models/GameModel.h"
+#include <string>
+
+/*
+内置关卡加载器：从编译进程序的关卡数据（configs/generated/BuiltinLevels.h）生成GameModel
+核心功能：
+1. 按关卡文件名查找内置关卡，命中时不读取文件、不解析JSON，首次启动不依赖资源包布局
+2. 生成的GameModel与LevelConfigLoader加载同名关卡文件的结果相同：ID按 游戏区、牌堆区 顺序从0编号，
+   坐标按棋盘布局偏移，规则参数一致，因此会话日志、提示表与统计不区分关卡来自哪里
+3. 内置数据由关卡流水线离线生成，生成时已按LevelConfigLoader::validateLevelConfig严格校验，运行时不再校验
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class BuiltinLevelLoader final {
+public:
+    /**
+     * 查找内置关卡
+     * @param levelFile 关卡文件路径（相对于资源目录）
+     * @return 内置关卡，没有时返回nullptr
+     */
+    static const BuiltinLevel* findLevel(const std::string& levelFile);
+
+    /**
+     * 由内置关卡生成游戏模型
+     * @param levelFile 关卡文件路径（相对于资源目录）
+     * @param layout 棋盘布局，应与随后创建视图时使用的对局上下文一致
+     * @param outModel 输出参数，接收生成的游戏模型
+     * @return 关卡是内置关卡返回true，否则不修改outModel
+     */
+    static bool loadLevel(const std::string& levelFile, const BoardLayout& layout, GameModel& outModel);
+
+private:
+    BuiltinLevelLoader() = default;
+};
+
+#endif // CONFIGS_LOADERS_BUILTINLEVELLOADER_H
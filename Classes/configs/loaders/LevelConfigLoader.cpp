@@ -1,37 +1,66 @@
 #include "LevelConfigLoader.h"
-
-// 初始化静态成员变量：用于生成卡牌唯一ID的计数器
-int LevelConfigLoader::currentId = 0;
+#include <cstdarg>
+#include <cstdio>
 
 /*
 从指定JSON文件加载关卡配置数据并转换为LevelConfig对象
 @param fileName 配置文件路径（相对于资源目录）
+@param layout 棋盘布局，提供各区域的位置偏移
 @return 成功返回LevelConfig实例指针，解析失败返回nullptr
 */
-LevelConfig* LevelConfigLoader::loadLevelConfig(std::string fileName)
+LevelConfig* LevelConfigLoader::loadLevelConfig(std::string fileName, const BoardLayout& layout)
 {
     // 读取JSON文件内容到字符串
     std::string jsonStr = cocos2d::FileUtils::getInstance()->getStringFromFile(fileName);
+    return parseLevelConfig(jsonStr, layout);
+}
+
+namespace {
+    // 记录一处加载问题：写日志，需要时追加到问题列表
+    void reportIssue(std::vector<std::string>* outErrors, const char* format, ...)
+    {
+        char message[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(message, sizeof(message), format, args);
+        va_end(args);
+        CCLOG("LevelConfigLoader: %s", message);
+        if (outErrors)
+            outErrors->push_back(message);
+    }
+}
+
+/*
+从JSON文本解析关卡配置
+@param jsonStr 关卡JSON文本
+@param layout 棋盘布局，提供各区域的位置偏移
+@param outErrors 问题列表，为nullptr时只写日志
+@return 成功返回LevelConfig实例指针，JSON语法或根节点错误返回nullptr
+*/
+LevelConfig* LevelConfigLoader::parseLevelConfig(const std::string& jsonStr, const BoardLayout& layout,
+    std::vector<std::string>* outErrors)
+{
     rapidjson::Document doc;
     doc.Parse<rapidjson::kParseDefaultFlags>(jsonStr.c_str());
 
     // 检查JSON解析错误
     if (doc.HasParseError())
     {
-        CCLOG("JSON解析错误: %s", doc.GetParseError());
+        reportIssue(outErrors, "JSON解析错误: %d，偏移%u", static_cast<int>(doc.GetParseError()),
+            static_cast<unsigned>(doc.GetErrorOffset()));
         return nullptr;
     }
 
-    // 创建配置对象并验证根节点类型
-    auto config = new LevelConfig();
+    // 验证根节点类型后再创建配置对象（避免解析失败时泄漏）
     if (!doc.IsObject())
     {
-        CCLOG("LevelConfigLoader: 根节点不是JSON对象");
+        reportIssue(outErrors, "根节点不是JSON对象");
         return nullptr;
     }
+    auto config = new LevelConfig();
 
-    // 重置ID计数器（确保每次加载关卡时ID从0开始）
-    currentId = 0;
+    // 本次加载的ID计数器（每次加载关卡时ID从0开始，不与其他线程的加载共享）
+    int nextId = 0;
 
     // 解析Playfield区域卡牌数组
     if (doc.HasMember("Playfield") && doc["Playfield"].IsArray())
@@ -40,13 +69,31 @@ LevelConfig* LevelConfigLoader::loadLevelConfig(std::string fileName)
         for (rapidjson::SizeType i = 0; i < playfieldArray.Size(); ++i)
         {
             const rapidjson::Value& cardNode = playfieldArray[i];
-            if (!parseCardModel(cardNode, config->_playfieldCards, CardZone::Playfield))
+            if (!parseCardModel(cardNode, config->_playfieldCards, CardZone::Playfield, layout, nextId))
             {
-                CCLOG("LevelConfigLoader: Playfield区域第%d张卡牌解析失败", i);
+                reportIssue(outErrors, "Playfield区域第%u张卡牌解析失败", i);
             }
         }
     }
 
+    // 解析匹配规则变体（缺省或无法识别时使用默认的相邻规则）
+    if (doc.HasMember("RuleVariant") && doc["RuleVariant"].IsString())
+    {
+        const char* variantName = doc["RuleVariant"].GetString();
+        if (!RuleParams::parseVariant(variantName, config->_ruleParams.variant))
+        {
+            reportIssue(outErrors, "未知的规则变体%s，使用Adjacent", variantName);
+        }
+    }
+    if (doc.HasMember("WildFace") && doc["WildFace"].IsInt())
+    {
+        int wildFace = doc["WildFace"].GetInt();
+        if (wildFace >= 0 && wildFace <= 12)
+            config->_ruleParams.wildFace = wildFace;
+        else
+            reportIssue(outErrors, "WildFace超出范围: %d", wildFace);
+    }
+
     // 解析Stack区域卡牌数组
     if (doc.HasMember("Stack") && doc["Stack"].IsArray())
     {
@@ -54,9 +101,9 @@ LevelConfig* LevelConfigLoader::loadLevelConfig(std::string fileName)
         for (rapidjson::SizeType i = 0; i < stackArray.Size(); ++i)
         {
             const rapidjson::Value& cardNode = stackArray[i];
-            if (!parseCardModel(cardNode, config->_stackCards, CardZone::Stack))
+            if (!parseCardModel(cardNode, config->_stackCards, CardZone::Stack, layout, nextId))
             {
-                CCLOG("LevelConfigLoader: Stack区域第%d张卡牌解析失败", i);
+                reportIssue(outErrors, "Stack区域第%u张卡牌解析失败", i);
             }
         }
     }
@@ -64,16 +111,53 @@ LevelConfig* LevelConfigLoader::loadLevelConfig(std::string fileName)
     return config;
 }
 
+/*
+严格校验关卡JSON文本
+@param jsonStr 关卡JSON文本
+@param outErrors 问题列表，追加本关的全部问题
+@param layout 棋盘布局，提供各区域的位置偏移
+@return 没有任何问题返回LevelConfig实例指针，否则返回nullptr
+*/
+LevelConfig* LevelConfigLoader::validateLevelConfig(const std::string& jsonStr, std::vector<std::string>& outErrors,
+    const BoardLayout& layout)
+{
+    size_t issueCount = outErrors.size();
+    LevelConfig* config = parseLevelConfig(jsonStr, layout, &outErrors);
+    if (config && config->_playfieldCards.empty())
+    {
+        outErrors.push_back("Playfield区域没有卡牌");
+    }
+    if (config && outErrors.size() != issueCount)
+    {
+        releaseLevelConfig(config);
+        return nullptr;
+    }
+    return config;
+}
+
+/*
+释放由loadLevelConfig创建的关卡配置对象
+@param config 待释放的配置对象，允许为nullptr
+*/
+void LevelConfigLoader::releaseLevelConfig(LevelConfig* config)
+{
+    delete config;
+}
+
 /*
 将JSON中的单张卡牌节点解析为CardModel对象并添加到目标容器
 @param cardNode JSON中单个卡牌的节点数据
 @param target 存储解析结果的CardModel向量容器
 @param zone 该卡牌所属的游戏区域（Playfield/Stack）
+@param layout 棋盘布局，提供该区域的位置偏移
+@param nextId 本次加载的卡牌ID计数器，解析成功后递增
 @return 解析成功返回true，字段缺失或格式错误返回false
 */
 bool LevelConfigLoader::parseCardModel(const rapidjson::Value& cardNode,
     std::vector<CardModel>& target,
-    CardZone zone)
+    CardZone zone,
+    const BoardLayout& layout,
+    int& nextId)
 {
     // 基础校验：节点必须是JSON对象
     if (!cardNode.IsObject())
@@ -113,11 +197,8 @@ bool LevelConfigLoader::parseCardModel(const rapidjson::Value& cardNode,
     cocos2d::Vec2 pos(x, y);
 
     // 生成唯一ID并根据区域偏移位置（区分游戏区和牌堆区的显示位置）
-    int id = currentId++;
-    if (zone == CardZone::Stack)
-        pos += cocos2d::Vec2(300, 400);  // 牌堆区卡牌位置偏移
-    else
-        pos += cocos2d::Vec2(0, 600);    // 游戏区卡牌位置偏移
+    int id = nextId++;
+    pos += layout.offsetFor(zone);
 
     // 直接在容器中构造CardModel对象（避免临时对象拷贝）
     target.emplace_back(face, suit, pos, id, zone);
@@ -3,6 +3,7 @@
 #define CONFIGS_LOADERS_LEVELCONFIGLOADER_H
 
 #include "configs/models/LevelConfig.h"
+#include "configs/models/BoardLayout.h"
 #include "cocos2d.h"
 #include <memory>
 #include <fstream>
@@ -18,25 +19,39 @@ using namespace rapidjson;
 
 /*
 关卡配置加载器（单例模式）：负责加载JSON格式的关卡配置文件
+加载器不保存任何状态（卡牌ID计数器在每次加载内部从0开始），可在多个线程上同时加载
+游戏内加载时跳过无效的卡牌并记录日志；离线工具经validateLevelConfig取得全部问题，任一问题即判为无效关卡
  */
 class LevelConfigLoader final {
 public:
-    // 加载指定关卡配置文件
-    static LevelConfig* loadLevelConfig(std::string fileName);
+    // 加载指定关卡配置文件，卡牌坐标按棋盘布局偏移到所在区域
+    static LevelConfig* loadLevelConfig(std::string fileName, const BoardLayout& layout = BoardLayout());
+
+    // 从JSON文本解析关卡配置（不读取文件）；outErrors非空时追加每一处被跳过或回退为默认值的问题
+    static LevelConfig* parseLevelConfig(const std::string& jsonStr, const BoardLayout& layout = BoardLayout(),
+                                         std::vector<std::string>* outErrors = nullptr);
+
+    // 严格校验关卡JSON文本：结构、卡牌字段与取值范围均与游戏内加载一致，且游戏区不能为空
+    // 有效时返回配置（由调用方经releaseLevelConfig释放），无效时返回nullptr，问题追加到outErrors
+    static LevelConfig* validateLevelConfig(const std::string& jsonStr, std::vector<std::string>& outErrors,
+                                            const BoardLayout& layout = BoardLayout());
+
+    // 释放加载得到的关卡配置（LevelConfig析构函数私有，只能由加载器销毁）
+    static void releaseLevelConfig(LevelConfig* config);
 
 private:
-    static int currentId;  // 用于生成卡片唯一ID的计数器
-    
     LevelConfigLoader() = default;
     
     LevelConfigLoader(const LevelConfigLoader&) = delete;
     
     LevelConfigLoader& operator=(const LevelConfigLoader&) = delete;
     
-    // 解析卡片模型数据
+    // 解析卡片模型数据（nextId为本次加载的卡牌ID计数器）
     static bool parseCardModel(const rapidjson::Value& cardNode, 
                               std::vector<CardModel>& target, 
-                              CardZone zone);
+                              CardZone zone,
+                              const BoardLayout& layout,
+                              int& nextId);
 };
 
 #endif // CONFIGS_LOADERS_LEVELCONFIGLOADER_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef CONFIGS_MODELS_BOARDLAYOUT_H
+#define CONFIGS_MODELS_BOARDLAYOUT_H
+
+#include "cocos2d.h"
+#include "models/CardModel.h"
+
+/*
+棋盘布局配置：各区域在屏幕上的坐标，由对局上下文（GameContext）持有
+加载关卡时用于把关卡文件中的相对坐标偏移到对应区域，控制器移动卡牌到手牌区时用作目标位置
+分屏等多棋盘模式为每个棋盘构造不同的布局即可，不再依赖写死的屏幕坐标
+ */
+struct BoardLayout {
+    cocos2d::Vec2 playfieldOffset = cocos2d::Vec2(0, 600);  //< 游戏区卡牌位置偏移
+    cocos2d::Vec2 stackOffset = cocos2d::Vec2(300, 400);    //< 牌堆区卡牌位置偏移
+    cocos2d::Vec2 handPosition = cocos2d::Vec2(700, 400);   //< 手牌区卡牌位置
+
+    /**
+     * 获取区域的位置偏移
+     * @param zone 卡牌区域（游戏区或牌堆区）
+     * @return 该区域卡牌的位置偏移
+     */
+    cocos2d::Vec2 offsetFor(CardZone zone) const {
+        return zone == CardZone::Stack ? stackOffset : playfieldOffset;
+    }
+};
+
+#endif // CONFIGS_MODELS_BOARDLAYOUT_H
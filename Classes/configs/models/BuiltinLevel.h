@@ -0,0 +1,36 @@
+#pragma once
+#ifndef CONFIGS_MODELS_BUILTINLEVEL_H
+#define CONFIGS_MODELS_BUILTINLEVEL_H
+
+#include "models/MatchRules.h"
+#include <cstdint>
+
+/*
+编译进程序的关卡数据：由关卡流水线（level_pipeline builtin）从关卡JSON生成constexpr数组，
+见configs/generated/BuiltinLevels.h；只含字面量类型，整个表在编译期初始化，启动时不做任何构造
+ */
+
+/**
+ * 内置关卡的一张卡牌
+ */
+struct BuiltinCard {
+    uint8_t face;   // 牌面（0~12对应A~K）
+    uint8_t suit;   // 花色（0~3）
+    int32_t x;      // 关卡文件中的x坐标（未叠加区域偏移）
+    int32_t y;      // 关卡文件中的y坐标（未叠加区域偏移）
+};
+
+/**
+ * 一个内置关卡
+ */
+struct BuiltinLevel {
+    const char* levelFile;          // 对应的关卡文件名（相对于资源目录），按此名查找
+    RuleVariant variant;            // 规则变体
+    int wildFace;                   // 万能牌面（-1表示没有）
+    const BuiltinCard* playfield;   // 游戏区卡牌（关卡文件顺序）
+    int playfieldCount;             // 游戏区卡牌数
+    const BuiltinCard* stack;       // 牌堆区卡牌（关卡文件顺序，没有时为nullptr）
+    int stackCount;                 // 牌堆区卡牌数
+};
+
+#endif // CONFIGS_MODELS_BUILTINLEVEL_H
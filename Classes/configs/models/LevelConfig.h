@@ -7,12 +7,13 @@
 #include "json/rapidjson.h"
 #include "json/document.h"
 #include "models/CardModel.h"
+#include "models/MatchRules.h"
 
 using namespace rapidjson;
 
 /*
 关卡配置数据模型类，用于存储单关卡的静态卡牌配置信息
-包含游戏区（Playfield）和牌堆区（Stack）的卡牌数据集合
+包含游戏区（Playfield）和牌堆区（Stack）的卡牌数据集合，以及本关的匹配规则变体
 通过LevelConfigLoader加载JSON文件生成实例，外部通过公开接口访问数据
  */
 class LevelConfig final
@@ -30,9 +31,16 @@ public:
         return _stackCards;
     }
 
+    // 获取本关匹配规则参数
+    const RuleParams& getRuleParams() const
+    {
+        return _ruleParams;
+    }
+
 private:
     std::vector<CardModel> _playfieldCards;  //< 游戏区卡牌集合，对应JSON中的"Playfield"字段
     std::vector<CardModel> _stackCards;      //< 牌堆区卡牌集合，对应JSON中的"Stack"字段
+    RuleParams _ruleParams;                  //< 匹配规则，对应JSON中的"RuleVariant"与"WildFace"字段（缺省为Adjacent）
 
     // 限制实例化与拷贝：仅允许LevelConfigLoader创建和初始化
     LevelConfig() = default;                  //< 私有默认构造函数，禁止外部直接实例化
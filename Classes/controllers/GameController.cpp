@@ -1,199 +1,450 @@
 #include "controllers/GameController.h"
 #include <iostream>
-#include "services/CardIdManagerMap.h"
+#include "services/GameLog.h"
+#include "services/BoardSolver.h"
+#include "services/SolutionTable.h"
+#include "services/GameContext.h"
+#include "models/BoardSnapshot.h"
 #include "cocos2d.h"
 
-GameController::GameController(GameModel gameModel)
-    : _gameModel(gameModel), _undoManager(gameModel.getUndoModel()) {
-    CCLOG(u8"初始化时undoManager大小为：%d", _undoManager.getUndoSize());
+namespace {
+    const int kPendingChangesReserve = 16; // 状态差异缓冲区预留容量，避免批处理时扩容
 }
 
-GameController::~GameController() {}
+GameController::GameController(GameModel gameModel, GameContext* context)
+    : _gameModel(gameModel), _initialModel(gameModel), _undoManager(_gameModel.getUndoModel()),
+      _eventBus(context ? &context->getEventBus() : nullptr), _layout(context ? context->getLayout() : BoardLayout()),
+      _clickSubscription(-1), _moveCount(0), _score(0), _rules(RuleOps::forVariant(_gameModel.getRuleParams().variant)),
+      _hintService(nullptr), _solutionTable(nullptr), _status(GameStatus::Playing), _nextSequence(0) {
+    _pendingChanges.reserve(kPendingChangesReserve);
+    GLOG_INFO(u8"匹配规则：%s", RuleParams::variantName(_gameModel.getRuleParams().variant));
+    if (_eventBus) {
+        _clickSubscription = _eventBus->subscribe<CardClickedEvent>([this](const CardClickedEvent& event) {
+            onCardClicked(event.cardId);
+        });
+    }
+    GLOG_DEBUG(u8"初始化时undoManager大小为：%d", _undoManager.getUndoSize());
+}
+
+GameController::~GameController() {
+    if (_eventBus) {
+        _eventBus->unsubscribe<CardClickedEvent>(_clickSubscription);
+    }
+}
+
+void GameController::onCardClicked(int cardId) {
+    int slot = _gameModel.getCards().slotOf(cardId);
+    if (slot < 0) {
+        GLOG_WARN(u8"点击的卡牌不在模型中 - ID：%d", cardId);
+        return;
+    }
+
+    // 根据卡牌所在区域生成对应指令，到本帧批处理时再校验
+    CardZone zone = _gameModel.getCards().getZone(slot);
+    if (zone == CardZone::Playfield) {
+        enqueueCommand(GameCommand::selectPlayfield(cardId));
+    }
+    else if (zone == CardZone::Stack) {
+        enqueueCommand(GameCommand::drawStack(cardId));
+    }
+}
+
+void GameController::setHintService(BoardSolver* hintService) {
+    _hintService = hintService;
+    submitHintSnapshot();
+}
+
+void GameController::setSolutionTable(SolutionTable* solutionTable) {
+    _solutionTable = solutionTable;
+    submitHintSnapshot();
+}
+
+void GameController::submitHintSnapshot() {
+    if (!_hintService) {
+        return;
+    }
+    HintMove precomputed;
+    if (_solutionTable && _solutionTable->lookup(_gameModel, precomputed)) {
+        _hintService->cancel(); // 提示直接查表，不占用后台搜索
+        return;
+    }
+    _hintService->submit(BoardSnapshot::capture(_gameModel));
+}
+
+bool GameController::enqueueCommand(GameCommand command) {
+    // 玩家一有操作，进行中的提示搜索即已过期
+    if (_hintService) {
+        _hintService->cancel();
+    }
+
+    command.sequence = _nextSequence++;
+    if (!_commandQueue.push(command)) {
+        GLOG_WARN(u8"指令队列已满，丢弃指令 - 类型：%d，卡牌ID：%d", static_cast<int>(command.type), command.cardId);
+        return false;
+    }
+    return true;
+}
+
+int GameController::processCommands() {
+    // 只处理本帧开始时已排队的指令，执行中由订阅者新增的指令留到下一帧
+    int count = _commandQueue.size();
+    GameCommand command;
+    for (int i = 0; i < count && _commandQueue.pop(command); ++i) {
+        applyCommand(command);
+    }
+    publishPendingChanges();
+
+    // 入队时已取消旧搜索，无论指令是否生效都为当前局面重新搜索
+    if (count > 0) {
+        submitHintSnapshot();
+    }
+    return count;
+}
 
-bool GameController::selectCardFromPlayefieldAndMatch(CardModel& selectedCard) {
-    if (_undoManager.getUndoSize() == 0) {
-        CCLOG(u8"撤销栈为空，无法进行匹配操作");
+int GameController::replayCommands(const std::vector<GameCommand>& commands) {
+    if (_hintService) {
+        _hintService->cancel();
+    }
+
+    int accepted = 0;
+    for (GameCommand command : commands) {
+        command.sequence = _nextSequence++;
+        if (applyCommand(command)) {
+            ++accepted;
+        }
+    }
+    publishPendingChanges();
+    submitHintSnapshot();
+    GLOG_INFO(u8"重放指令 - 共%d条，生效%d条", static_cast<int>(commands.size()), accepted);
+    return accepted;
+}
+
+bool GameController::loadState(const GameModel& state, int moveCount, int score) {
+    CardStore& cards = _gameModel.getCards();
+    const CardStore& saved = state.getCards();
+    if (saved.size() != cards.size()) {
+        GLOG_WARN(u8"存档卡牌数与本关不符 - 存档：%d，本关：%d", saved.size(), cards.size());
         return false;
     }
+    for (int slot = 0; slot < cards.size(); ++slot) {
+        if (saved.getId(slot) != cards.getId(slot)) {
+            GLOG_WARN(u8"存档卡牌与本关不符 - 槽位：%d", slot);
+            return false;
+        }
+    }
+    if (_hintService) {
+        _hintService->cancel();
+    }
 
-    CardModel bottomCard = getBottomCard();
-    CCLOG(u8"Playfield区选中 - 选择卡牌ID：%d，匹配底部卡牌ID：%d",
-        selectedCard._id, bottomCard._id);
+    // 先替换手牌栈与撤销历史（撤销管理器引用的是同一个撤销模型）
+    _gameModel.getHand() = state.getHand();
+    _gameModel.getUndoModel() = state.getUndoModel();
+    for (int slot = 0; slot < cards.size(); ++slot) {
+        if (cards.getZone(slot) != saved.getZone(slot) || !cards.getPosition(slot).equals(saved.getPosition(slot)) ||
+            cards.getZOrder(slot) != saved.getZOrder(slot)) {
+            cards.setZone(slot, saved.getZone(slot));
+            cards.setPosition(slot, saved.getPosition(slot));
+            recordChange(slot, saved.getZOrder(slot));
+        }
+    }
+
+    _moveCount = moveCount;
+    _score = score;
+    updateStatus();
+    publishPendingChanges();
+    submitHintSnapshot();
+    GLOG_INFO(u8"载入存档 - 移动次数：%d，得分：%d，撤销历史：%d", moveCount, score, _undoManager.getUndoSize());
+    return true;
+}
 
-    if (isCardMatch(selectedCard, bottomCard)) {
+void GameController::publishPendingChanges() {
+    if (_pendingChanges.empty()) {
+        return;
+    }
+    if (_eventBus) {
+        _eventBus->publish(BoardDiffEvent{ _pendingChanges.data(), static_cast<int>(_pendingChanges.size()) });
+    }
+    _pendingChanges.clear();
+}
+
+bool GameController::applyCommand(const GameCommand& command) {
+    bool accepted = false;
+    if (command.type == GameCommandType::Undo) {
+        accepted = undo();
+    }
+    else if (command.type == GameCommandType::UndoTo) {
+        accepted = undoTo(command.cardId);
+    }
+    else if (command.type == GameCommandType::Restart) {
+        accepted = restart();
+    }
+    else {
+        // 入队后卡牌状态可能已被同批的前序指令改变（如连点），按执行时的区域重新校验
+        int slot = _gameModel.getCards().slotOf(command.cardId);
+        CardZone zone = slot >= 0 ? _gameModel.getCards().getZone(slot) : CardZone::Unknown;
+        if (slot < 0) {
+            GLOG_WARN(u8"指令目标卡牌不存在 - ID：%d", command.cardId);
+        }
+        else if (command.type == GameCommandType::SelectPlayfield && zone == CardZone::Playfield) {
+            accepted = selectCardFromPlayefieldAndMatch(command.cardId);
+        }
+        else if (command.type == GameCommandType::DrawStack && zone == CardZone::Stack) {
+            clickStackCard(command.cardId);
+            accepted = true;
+        }
+        else {
+            GLOG_DEBUG(u8"指令已失效 - 卡牌ID：%d 当前区域：%d", command.cardId, static_cast<int>(zone));
+        }
+    }
+
+    if (_eventBus) {
+        _eventBus->publish(CommandAppliedEvent{ command, accepted });
+    }
+    return accepted;
+}
+
+void GameController::recordChange(int slot, int zOrder) {
+    CardStore& cards = _gameModel.getCards();
+    cards.setZOrder(slot, zOrder);
+
+    const int cardId = cards.getId(slot);
+    for (auto& change : _pendingChanges) {
+        if (change.cardId == cardId) {
+            change.zone = cards.getZone(slot);
+            change.position = cards.getPosition(slot);
+            change.zOrder = zOrder;
+            return;
+        }
+    }
+    _pendingChanges.push_back(CardStateChange{ cardId, cards.getZone(slot), cards.getPosition(slot), zOrder });
+}
+
+bool GameController::selectCardFromPlayefieldAndMatch(int cardId) {
+    const CardStore& cards = _gameModel.getCards();
+    int slot = cards.slotOf(cardId);
+    int handSlot = getHandTopSlot();
+    if (slot < 0 || handSlot < 0) {
+        GLOG_DEBUG(u8"手牌区为空或卡牌不存在，无法进行匹配操作");
+        return false;
+    }
+
+    GLOG_DEBUG(u8"Playfield区选中 - 选择卡牌ID：%d，匹配手牌卡牌ID：%d",
+        cardId, cards.getId(handSlot));
+
+    if (isCardMatch(slot, handSlot)) {
         // 记录当前状态用于撤销
         UndoCardState state;
-        state.id = selectedCard._id;
-        state.position = selectedCard.getPosition();
-        state.zone = selectedCard.getZone();
+        state.id = cardId;
+        state.position = cards.getPosition(slot);
+        state.zone = cards.getZone(slot);
+        state.score = _rules.score(_gameModel.getRuleParams(),
+            static_cast<int>(cards.getFace(slot)), static_cast<int>(cards.getSuit(slot)),
+            static_cast<int>(cards.getFace(handSlot)), static_cast<int>(cards.getSuit(handSlot)));
         _undoManager.recordUndoState(state);
-        CCLOG(u8"卡牌匹配成功，已记录撤销状态 - ID：%d", selectedCard._id);
+        _score += state.score;
+        GLOG_DEBUG(u8"卡牌匹配成功，已记录撤销状态 - ID：%d，得分：%d", cardId, state.score);
 
-        handleCardClicked(selectedCard);
+        handleCardClicked(cardId);
         return true;
     }
 
-    CCLOG(u8"卡牌匹配失败 - 数值不相邻");
+    GLOG_DEBUG(u8"卡牌匹配失败 - 不符合规则%s", RuleParams::variantName(_gameModel.getRuleParams().variant));
     return false;
 }
 
-void GameController::clickStackCard(CardModel& card) {
+void GameController::clickStackCard(int cardId) {
+    const CardStore& cards = _gameModel.getCards();
+    int slot = cards.slotOf(cardId);
+    if (slot < 0) {
+        GLOG_WARN(u8"Stack区卡牌不存在 - ID：%d", cardId);
+        return;
+    }
+
     // 记录当前状态用于撤销
     UndoCardState state;
-    state.id = card._id;
-    state.position = card.getPosition();
-    state.zone = card.getZone();
+    state.id = cardId;
+    state.position = cards.getPosition(slot);
+    state.zone = cards.getZone(slot);
+    state.score = 0;
     _undoManager.recordUndoState(state);
-    CCLOG(u8"Stack区选中 - 已记录撤销状态 - ID：%d", card._id);
+    GLOG_DEBUG(u8"Stack区选中 - 已记录撤销状态 - ID：%d", cardId);
 
-    handleCardClicked(card);
+    handleCardClicked(cardId);
 }
 
 bool GameController::undo() {
     UndoCardState state;
     if (_undoManager.undo(state)) {
-        CCLOG(u8"执行撤销操作 - 卡牌ID：%d，目标区域：%d",
+        GLOG_DEBUG(u8"执行撤销操作 - 卡牌ID：%d，目标区域：%d",
             state.id, static_cast<int>(state.zone));
         moveCardToOriginalPosition(state);
         return true;
     }
 
-    CCLOG(u8"撤销栈为空，无法执行撤销操作");
+    GLOG_DEBUG(u8"撤销栈为空，无法执行撤销操作");
     return false;
 }
 
+bool GameController::undoTo(int historySize) {
+    bool undone = false;
+    while (_undoManager.getUndoSize() > historySize && undo()) {
+        undone = true;
+    }
+    return undone;
+}
+
+bool GameController::restart() {
+    // 控制器从不增删卡牌，当前存储与初始存储的槽位一一对应
+    CardStore& cards = _gameModel.getCards();
+    const CardStore& initial = _initialModel.getCards();
+    for (int slot = 0; slot < cards.size() && slot < initial.size(); ++slot) {
+        if (cards.getZone(slot) != initial.getZone(slot) || !cards.getPosition(slot).equals(initial.getPosition(slot))) {
+            cards.setZone(slot, initial.getZone(slot));
+            cards.setPosition(slot, initial.getPosition(slot));
+            recordChange(slot, cards.getHomeZOrder(slot));
+        }
+    }
+
+    _gameModel.getUndoModel().clearHistory();
+    _gameModel.getHand().clear();
+    _moveCount = 0;
+    _score = 0;
+    updateStatus();
+    GLOG_DEBUG(u8"重新开始本关 - 变化卡牌数：%d", static_cast<int>(_pendingChanges.size()));
+    return true;
+}
+
 // 专门处理Stack区域的卡牌撤销
 bool GameController::undoStack() {
     UndoCardState state;
     if (_undoManager.undoStack(state)) {
-        CCLOG(u8"执行Stack区撤销 - 卡牌ID：%d", state.id);
+        GLOG_DEBUG(u8"执行Stack区撤销 - 卡牌ID：%d", state.id);
         moveCardToOriginalPosition(state);
         return true;
     }
 
-    CCLOG(u8"没有可撤销的Stack区操作");
+    GLOG_DEBUG(u8"没有可撤销的Stack区操作");
     return false;
 }
 
-CardModel GameController::getBottomCard() {
-    UndoCardState state;
-    int currentSize = _undoManager.getUndoSize();
-    CCLOG(u8"获取栈底卡牌 - 当前撤销栈大小：%d", currentSize);
-
-    if (currentSize == 0) {
-        CCLOG(u8"撤销栈为空，返回默认卡牌");
-        return CardModel(CardFaceType::CFT_ACE, CardSuitType::CST_SPADES, cocos2d::Vec2::ZERO);
-    }
-
-    if (_undoManager.getLastState(state)) {
-        // 查找对应的卡牌模型
-        const auto& playfield = _gameModel.getPlayfield();
-        for (const auto& card : playfield) {
-            if (card._id == state.id) {
-                return card;
-            }
-        }
-
-        const auto& stackfield = _gameModel.getStackfield();
-        for (const auto& card : stackfield) {
-            if (card._id == state.id) {
-                return card;
-            }
-        }
-    }
-
-    CCLOG(u8"未找到栈底卡牌，返回默认卡牌");
-    return CardModel(CardFaceType::CFT_ACE, CardSuitType::CST_SPADES, cocos2d::Vec2::ZERO);
+int GameController::getHandTopSlot() const {
+    return _gameModel.getCards().slotOf(_gameModel.getHand().top());
 }
 
-bool GameController::isCardMatch(const CardModel& card1, const CardModel& card2) {
-    int face1 = static_cast<int>(card1.getFace());
-    int face2 = static_cast<int>(card2.getFace());
-    bool result = (face1 == face2 + 1) || (face1 == face2 - 1);
-    CCLOG(u8"卡牌匹配检查 - 卡牌1数值：%d，卡牌2数值：%d，结果：%s",
+bool GameController::isCardMatch(int slot1, int slot2) const {
+    const CardStore& cards = _gameModel.getCards();
+    int face1 = static_cast<int>(cards.getFace(slot1));
+    int face2 = static_cast<int>(cards.getFace(slot2));
+    bool result = _rules.matches(_gameModel.getRuleParams(), face1, static_cast<int>(cards.getSuit(slot1)),
+        face2, static_cast<int>(cards.getSuit(slot2)));
+    GLOG_DEBUG(u8"卡牌匹配检查 - 卡牌1数值：%d，卡牌2数值：%d，结果：%s",
         face1, face2, result ? u8"匹配" : u8"不匹配");
     return result;
 }
 
 void GameController::moveCardToOriginalPosition(const UndoCardState& state) {
-    // 先在Playfield中查找并移动卡牌
-    auto& playfield = _gameModel.getPlayfield();
-    for (auto& card : playfield) {  // 使用引用修改实际卡牌
-        if (card._id == state.id) {
-            CardManager* cardManager = getCardManager(card);
-            if (cardManager) {
-                card.setPosition(state.position);
-                card.setZone(state.zone);
-                cardManager->getView()->runAction(cocos2d::MoveTo::create(0.5f, state.position));
-                cardManager->getView()->setLocalZOrder(0);
-                CCLOG(u8"卡牌移回原位置 - ID：%d，区域：Playfield", state.id);
-            }
-            return;
-        }
+    CardStore& cards = _gameModel.getCards();
+    int slot = cards.slotOf(state.id);
+    if (slot < 0) {
+        GLOG_WARN(u8"未找到卡牌 - ID：%d，无法执行移动操作", state.id);
+        return;
     }
 
-    // 再在Stackfield中查找并移动卡牌
-    auto& stackfield = _gameModel.getStackfield();
-    for (auto& card : stackfield) {  // 使用引用修改实际卡牌
-        if (card._id == state.id) {
-            CardManager* cardManager = getCardManager(card);
-            if (cardManager) {
-                card.setPosition(state.position);
-                card.setZone(state.zone);
-                cardManager->getView()->runAction(cocos2d::MoveTo::create(0.5f, state.position));
-                cardManager->getView()->setLocalZOrder(0);
-                CCLOG(u8"卡牌移回原位置 - ID：%d，区域：Stackfield", state.id);
-            }
-            return;
+    // 从手牌区移除；若不在栈顶（牌堆区专用撤销），其上的卡牌依次下移一层
+    HandPileModel& hand = _gameModel.getHand();
+    int removedIndex = hand.remove(state.id);
+    for (int i = removedIndex; removedIndex >= 0 && i < hand.size(); ++i) {
+        int aboveSlot = cards.slotOf(hand.cardAt(i));
+        if (aboveSlot >= 0) {
+            recordChange(aboveSlot, hand.zOrderFor(CardZone::Hand, i));
         }
     }
 
-    CCLOG(u8"未找到卡牌 - ID：%d，无法执行移动操作", state.id);
+    _score -= state.score;
+    restoreCard(slot, state);
+    recordChange(slot, cards.getHomeZOrder(slot));
+    updateStatus();
+    GLOG_DEBUG(u8"卡牌移回原位置 - ID：%d，区域：%d", state.id, static_cast<int>(state.zone));
 }
 
-CardManager* GameController::getCardManager(const CardModel& card) {
-    CardManager* manager = CardIdManagerMap::getInstance().getCardManager(card._id);
-    if (!manager) {
-        CCLOG(u8"警告：未找到卡牌管理器 - ID：%d", card._id);
+void GameController::restoreCard(int slot, const UndoCardState& state) {
+    CardStore& cards = _gameModel.getCards();
+    cards.setPosition(slot, state.position);
+    cards.setZone(slot, state.zone);
+    if (_eventBus) {
+        _eventBus->publish(CardUndoneEvent{ state.id, state.zone, state.position });
     }
-    return manager;
 }
 
-void GameController::handleCardClicked(CardModel& card) {
-    CCLOG(u8"卡牌被点击 - ID：%d，当前区域：%d",
-        card._id, static_cast<int>(card.getZone()));
+void GameController::handleCardClicked(int cardId) {
+    CardStore& cards = _gameModel.getCards();
+    int slot = cards.slotOf(cardId);
+    if (slot < 0) {
+        return;
+    }
+    GLOG_DEBUG(u8"卡牌被点击 - ID：%d，当前区域：%d",
+        cardId, static_cast<int>(cards.getZone(slot)));
+
+    if (cards.getZone(slot) != CardZone::Hand) {
+        cocos2d::Vec2 newPos = _layout.handPosition;
+
+        // 更新卡牌状态（区域列表交换删除，O(1)）
+        CardZone fromZone = cards.getZone(slot);
+        cards.setZone(slot, CardZone::Hand);
+        cards.setPosition(slot, newPos);
 
-    if (card.getZone() != CardZone::Hand) {
-        cocos2d::Vec2 newPos(700, 400);
-        CardManager* cardManager = getCardManager(card);
+        // 入栈即得到手牌区层级，无需查询其他卡牌的视图
+        int newZOrder = _gameModel.getHand().push(cardId);
+        recordChange(slot, newZOrder);
 
-        if (cardManager) {
-            // 更新卡牌状态
-            card.setZone(CardZone::Hand);
-            card.setPosition(newPos);
+        ++_moveCount;
+        if (_eventBus) {
+            _eventBus->publish(CardMovedEvent{ cardId, fromZone, CardZone::Hand, newPos, newZOrder });
+        }
+        updateStatus();
 
-            // 执行移动动画
-            auto moveTo = cocos2d::MoveTo::create(0.5f, newPos);
-            cardManager->getView()->runAction(moveTo);
+        GLOG_DEBUG(u8"卡牌移动到Hand区域 - ID：%d，新位置：(%.0f, %.0f)，ZOrder：%d",
+            cardId, newPos.x, newPos.y, newZOrder);
+    }
+}
 
-            // 设置Z轴顺序确保正确显示层级
-            if (_undoManager.getUndoSize() > 1) {  // 大于1是因为包含了当前操作的记录
-                CardModel lastCard = getBottomCard();
-                CardManager* lastCardManager = getCardManager(lastCard);
-                if (lastCardManager) {
-                    int newZOrder = lastCardManager->getView()->getLocalZOrder() + 1;
-                    cardManager->getView()->setLocalZOrder(newZOrder);
-                    CCLOG(u8"更新卡牌Z轴顺序 - ID：%d，ZOrder：%d", card._id, newZOrder);
-                }
-            }
+void GameController::updateStatus() {
+    // 区域列表长度与游戏区计数均随换区维护，这里只做常数次查表
+    const CardStore& cards = _gameModel.getCards();
+    const int remaining = static_cast<int>(cards.getZoneMembers(CardZone::Playfield).size());
+    GameStatus status = GameStatus::Playing;
+    if (remaining == 0) {
+        status = GameStatus::Cleared;
+    }
+    else if (cards.getZoneMembers(CardZone::Stack).empty()) {
+        int handSlot = getHandTopSlot();
+        int playable = handSlot < 0 ? 0 : _rules.playableCount(_gameModel.getRuleParams(),
+            cards.getZoneCounts(CardZone::Playfield),
+            static_cast<int>(cards.getFace(handSlot)), static_cast<int>(cards.getSuit(handSlot)));
+        if (playable == 0) {
+            status = GameStatus::NoMovesLeft;
+        }
+    }
 
-            CCLOG(u8"卡牌移动到Hand区域 - ID：%d，新位置：(%.0f, %.0f)",
-                card._id, newPos.x, newPos.y);
+    if (status == _status) {
+        return;
+    }
+    _status = status;
+    if (status == GameStatus::Cleared) {
+        GLOG_INFO(u8"关卡完成 - 移动次数：%d，得分：%d", _moveCount, _score);
+        if (_eventBus) {
+            _eventBus->publish(LevelClearedEvent{ _moveCount });
+        }
+    }
+    else if (status == GameStatus::NoMovesLeft) {
+        GLOG_INFO(u8"死局 - 游戏区剩余卡牌：%d", remaining);
+        if (_eventBus) {
+            _eventBus->publish(NoMovesLeftEvent{ remaining });
         }
     }
 }
 
 void GameController::handleLabelClick() {
-    CCLOG(u8"标签被点击事件 - 执行撤销操作");
-    undo();
+    GLOG_DEBUG(u8"标签被点击事件 - 撤销指令入队");
+    enqueueCommand(GameCommand::undo());
 }
\ No newline at end of file
@@ -3,54 +3,118 @@
 #define GAME_CONTROLLER_H
 
 #include "models/GameModel.h"
+#include "models/GameCommand.h"
+#include "models/MatchRules.h"
 #include "managers/UndoManager.h"
-#include "managers/CardManager.h"
+#include "services/GameEventBus.h"
+#include "configs/models/BoardLayout.h"
 #include <vector>
 
-class CardManager;
+class BoardSolver;
+class SolutionTable;
+class GameContext;
+
+/**
+ * 对局状态
+ */
+enum class GameStatus {
+    Playing,        // 进行中
+    Cleared,        // 关卡完成：游戏区已清空
+    NoMovesLeft     // 死局：游戏区没有可匹配的卡牌且牌堆已空
+};
+
 /*
 用于衔接GameModel与GameView/CardView的控制器类
 核心职责：
-1. 处理卡牌选择与匹配逻辑（通过selectCardFromPlayefieldAndMatch验证匹配规则）
+1. 处理卡牌选择与匹配逻辑（通过selectCardFromPlayefieldAndMatch验证匹配规则，规则变体在关卡加载时选定）
 2. 管理Stack区域卡牌点击事件并通过UndoManager记录操作状态
 3. 实现撤销功能：基于UndoModel恢复卡牌位置和状态
-4. 作为视图层与数据层的桥梁：接收CardView点击事件并执行移动操作
+4. 指令队列：点击与撤销先转换为GameCommand排队，每帧由processCommands统一校验与执行，
+   避免连点、脚本输入与进行中的动画、撤销交错
+5. 向事件总线发布规则事件（卡牌移动、撤销、关卡完成、指令执行结果），
+   并在每批指令后发布一次合并的状态差异，由视图据此统一播放动画；控制器本身不访问任何视图
+6. 每次移动、撤销、重开后以O(1)代价（区域计数查表）判断关卡完成或死局，状态变化时发布对应事件
+7. 接入提示服务时，玩家一有操作就取消进行中的提示搜索，每批指令执行后提交新的棋盘快照
  */
 class GameController {
 public:
     /**
      * 构造函数
      * @param gameModel 游戏数据模型，用于初始化控制器状态
+     * @param context 对局上下文（不持有），提供事件总线与棋盘布局；
+     *                为nullptr时使用默认布局，且不订阅也不发布事件（如无界面基准测试、后台模拟）
      */
-    GameController(GameModel gameModel);
+    GameController(GameModel gameModel, GameContext* context = nullptr);
     
     /**
      * 析构函数
-     * 释放控制器相关资源
+     * 退订事件总线并释放控制器相关资源
      */
     ~GameController();
 
+    // 构造时以this订阅事件总线，禁止拷贝
+    GameController(const GameController&) = delete;
+    GameController& operator=(const GameController&) = delete;
+
+    /**
+     * 处理卡牌点击事件
+     * 按ID在控制器自身的模型中查找卡牌，并根据所在区域生成匹配或翻牌指令入队
+     * @param cardId 被点击卡牌ID
+     */
+    void onCardClicked(int cardId);
+
+    /**
+     * 指令入队，等待下一次processCommands统一执行
+     * @param command 玩家指令（序号由控制器分配）
+     * @return 入队成功返回true，队列已满返回false
+     */
+    bool enqueueCommand(GameCommand command);
+
+    /**
+     * 执行本帧开始时已排队的全部指令，并发布一次合并的状态差异
+     * 执行过程中新入队的指令留到下一帧处理
+     * @return 本次处理的指令数
+     */
+    int processCommands();
+
+    /**
+     * 立即按顺序执行一组指令（恢复会话日志、载入存档时调用），执行完发布一次合并的状态差异
+     * @param commands 指令序列（序号由控制器重新分配）
+     * @return 生效的指令数
+     */
+    int replayCommands(const std::vector<GameCommand>& commands);
+
+    /**
+     * 载入存档局面：把卡牌区域、坐标、手牌栈、撤销历史与本局统计整体替换为存档内容
+     * 只有状态改变过的卡牌会进入状态差异，载入后立即发布
+     * @param state 存档时的棋盘，槽位须与本关初始棋盘一一对应
+     * @param moveCount 本局累计移动次数
+     * @param score 本局当前得分
+     * @return 卡牌一致并载入返回true，否则不做任何修改并返回false
+     */
+    bool loadState(const GameModel& state, int moveCount, int score);
+
     /**
      * 从游戏区选择卡牌并验证匹配规则
-     * 检查选中卡牌与栈底卡牌是否符合相邻数值规则
-     * @param selectedCard 选中的游戏区卡牌模型
+     * 检查选中卡牌与手牌栈顶卡牌是否符合本关的匹配规则
+     * @param cardId 选中的游戏区卡牌ID
      * @return 匹配成功返回true，否则返回false
      */
-    bool selectCardFromPlayefieldAndMatch(CardModel& selectedCard);
+    bool selectCardFromPlayefieldAndMatch(int cardId);
 
     /**
      * 处理牌堆区(Stack)卡牌点击事件
      * 记录当前操作状态到撤销管理器，用于后续撤销操作
-     * @param card 被点击的牌堆区卡牌模型
+     * @param cardId 被点击的牌堆区卡牌ID
      */
-    void clickStackCard(CardModel& card);
+    void clickStackCard(int cardId);
 
     /**
      * 处理卡牌点击后的核心逻辑
-     * 包括移动卡牌到目标区域、更新状态及执行动画
-     * @param card 被点击的卡牌模型
+     * 移动卡牌到手牌区并更新状态，视图变化记入本批状态差异
+     * @param cardId 被点击的卡牌ID
      */
-    void handleCardClicked(CardModel& card);
+    void handleCardClicked(int cardId);
 
     /**
      * 执行撤销操作
@@ -60,28 +124,133 @@ public:
     bool undo();
 
     /**
-     * 处理标签点击事件（通常用于触发撤销操作）
+     * 撤销最近一次牌堆区(Stack)的操作
+     * 仅恢复来自Stack区的卡牌，不影响Playfield区的操作记录
+     * @return 撤销成功返回true，没有Stack区操作记录时返回false
+     */
+    bool undoStack();
+
+    /**
+     * 连续撤销直到历史长度不超过指定值（撤销到指定步）
+     * @param historySize 目标历史长度
+     * @return 至少撤销了一步返回true
+     */
+    bool undoTo(int historySize);
+
+    /**
+     * 重新开始本关：把所有卡牌恢复到关卡初始状态并清空撤销历史
+     * 只有状态改变过的卡牌会进入状态差异
+     * @return 总是返回true
+     */
+    bool restart();
+
+    /**
+     * 处理标签点击事件：撤销指令入队
      */
     void handleLabelClick();
 
+    /**
+     * 接入提示服务（不持有），并立即提交当前棋盘快照
+     * @param hintService 提示服务，为nullptr时断开
+     */
+    void setHintService(BoardSolver* hintService);
+
+    /**
+     * 接入关卡的预计算提示表（不持有），当前局面在表中时不再提交实时搜索
+     * @param solutionTable 提示表，为nullptr时断开
+     */
+    void setSolutionTable(SolutionTable* solutionTable);
+
+    /**
+     * 获取本局当前得分（撤销会扣回对应操作的得分）
+     * @return 当前得分
+     */
+    int getScore() const { return _score; }
+
+    /**
+     * 获取当前对局状态（随每次移动、撤销、重开更新）
+     * @return 对局状态
+     */
+    GameStatus getStatus() const { return _status; }
+
+    /**
+     * 获取本局累计移动次数
+     * @return 移动次数
+     */
+    int getMoveCount() const { return _moveCount; }
+
+    /**
+     * 获取当前棋盘（只读，用于存档）
+     * @return 游戏数据模型的常量引用
+     */
+    const GameModel& getGameModel() const { return _gameModel; }
+
+    /**
+     * 获取关卡初始棋盘（只读，用于存档）
+     * @return 初始数据模型的常量引用
+     */
+    const GameModel& getInitialModel() const { return _initialModel; }
+
 private:
     GameModel _gameModel;       // 游戏数据模型，存储卡牌集合及状态
+    GameModel _initialModel;    // 关卡初始状态，用于重新开始
     UndoManager _undoManager;   // 撤销管理器，负责记录和恢复操作状态
+    GameEventBus* _eventBus;    // 事件总线（来自对局上下文，不持有）
+    BoardLayout _layout;        // 棋盘布局（来自对局上下文）
+    int _clickSubscription;     // 卡牌点击事件的订阅句柄
+    int _moveCount;             // 本局累计移动次数
+    int _score;                 // 本局当前得分
+    RuleOps _rules;             // 本关匹配规则的函数表（构造时按规则变体选定一次）
+    BoardSolver* _hintService;  // 提示服务（不持有，可为nullptr）
+    SolutionTable* _solutionTable; // 预计算提示表（不持有，可为nullptr）
+    GameStatus _status;         // 当前对局状态
+    GameCommandQueue _commandQueue;               // 待执行的玩家指令
+    uint32_t _nextSequence;                       // 下一条指令的序号
+    std::vector<CardStateChange> _pendingChanges; // 本批指令产生的合并状态差异
+
+    /**
+     * 校验并执行一条指令，发布执行结果事件
+     * @param command 玩家指令
+     * @return 指令生效返回true，被规则拒绝返回false
+     */
+    bool applyCommand(const GameCommand& command);
+
+    /**
+     * 发布本批指令合并后的状态差异并清空缓冲区
+     */
+    void publishPendingChanges();
+
+    /**
+     * 重新判断对局状态（O(1)），进入关卡完成或死局时发布事件
+     */
+    void updateStatus();
+
+    /**
+     * 向提示服务提交当前棋盘快照（局面在预计算提示表中时改为取消搜索）
+     */
+    void submitHintSnapshot();
+
+    /**
+     * 更新卡牌层级，并把卡牌的最新状态记入本批状态差异（同一卡牌只保留最后一次）
+     * @param slot 状态已更新的卡牌槽位
+     * @param zOrder 目标层级
+     */
+    void recordChange(int slot, int zOrder);
 
     /**
-     * 获取撤销栈中最底部的卡牌模型
+     * 获取手牌区栈顶卡牌的槽位（O(1)）
      * 用于匹配验证时作为基准卡牌
-     * @return 栈底卡牌模型，栈为空时返回默认卡牌
+     * @return 栈顶卡牌槽位，手牌区为空时返回-1
      */
-    CardModel getBottomCard();
+    int getHandTopSlot() const;
 
     /**
-     * 验证两张卡牌是否符合匹配规则（数值相邻）
-     * @param card1 待匹配的第一张卡牌
-     * @param card2 待匹配的第二张卡牌
-     * @return 数值相邻返回true，否则返回false
+     * 验证两张卡牌是否符合本关的匹配规则
+     * @param slot1 待匹配的游戏区卡牌槽位
+     * @param slot2 手牌栈顶卡牌槽位
+     * @return 符合规则返回true，否则返回false
      */
-    bool isCardMatch(const CardModel& card1, const CardModel& card2);
+    bool isCardMatch(int slot1, int slot2) const;
 
     /**
      * 将卡牌恢复到指定的原始位置和区域
@@ -90,10 +259,10 @@ private:
     void moveCardToOriginalPosition(const UndoCardState& state);
 
     /**
-     * 通过卡牌模型获取对应的管理器实例
-     * @param card 目标卡牌模型
-     * @return 卡牌管理器指针，未找到时返回nullptr
+     * 把撤销状态写回卡牌存储并发布撤销事件
+     * @param slot 卡牌槽位
+     * @param state 撤销状态
      */
-    CardManager* getCardManager(const CardModel& card);
+    void restoreCard(int slot, const UndoCardState& state);
 };
 #endif
\ No newline at end of file
@@ -2,36 +2,59 @@
 #include <iostream>
 #include "views/CardView.h"  
 #include "services/CardIdManagerMap.h"
+#include "services/GameEventBus.h"
+#include "services/GameLog.h"
 #include "cocos2d.h"
 
-CardManager::CardManager(const CardModel& model)
-    : _model(model), _view(nullptr), _isSelected(false) {
-    CardIdManagerMap::getInstance().addCardManager(model._id, this);
-    CCLOG(u8"创建CardManager - 卡牌ID：%d", model._id);
+// 拖拽预测提前量（毫秒），0表示关闭预测；高延迟触摸屏上可设为一帧左右（如16）
+#ifndef CARD_DRAG_PREDICTION_MS
+#define CARD_DRAG_PREDICTION_MS 0
+#endif
+
+namespace {
+    const char* const kDragScheduleKey = "CardManager.drag"; // 拖拽每帧回调的调度键
+    const float kDragVelocitySmoothing = 0.5f;               // 速度平滑系数（新样本权重）
+    const float kDragMaxPrediction = 24.0f;                  // 预测偏移上限（点），防止甩动时过冲
+}
+
+CardManager::CardManager(const CardModel& model, CardIdManagerMap* cardManagers)
+    : _model(model), _view(nullptr), _isSelected(false), _isDragScheduled(false), _eventBus(nullptr),
+      _cardManagers(cardManagers) {
+    if (_cardManagers) {
+        _cardManagers->addCardManager(model._id, this);
+    }
+    GLOG_DEBUG(u8"创建CardManager - 卡牌ID：%d", model._id);
 }
 
 CardManager::~CardManager() {
-    // 从全局映射中移除当前管理器
-    CardIdManagerMap::getInstance().removeCardManager(_model._id);
-    CCLOG(u8"销毁CardManager - 卡牌ID：%d", _model._id);
+    if (_isDragScheduled) {
+        cocos2d::Director::getInstance()->getScheduler()->unschedule(kDragScheduleKey, this);
+    }
+    // 从所属对局的映射中移除当前管理器
+    if (_cardManagers) {
+        _cardManagers->removeCardManager(_model._id);
+    }
+    GLOG_DEBUG(u8"销毁CardManager - 卡牌ID：%d", _model._id);
 }
 
 void CardManager::setCard(const CardModel& model, CardView* view) {
     // 移除旧ID的映射
-    if (_model._id != model._id) {
-        CardIdManagerMap::getInstance().removeCardManager(_model._id);
+    if (_cardManagers && _model._id != model._id) {
+        _cardManagers->removeCardManager(_model._id);
     }
 
     _model = model;
     _view = view;
-    CardIdManagerMap::getInstance().addCardManager(model._id, this);
+    if (_cardManagers) {
+        _cardManagers->addCardManager(model._id, this);
+    }
     setupTouchEvents();
-    CCLOG(u8"更新卡牌信息 - ID：%d，区域：%d", model._id, static_cast<int>(model.getZone()));
+    GLOG_DEBUG(u8"更新卡牌信息 - ID：%d，区域：%d", model._id, static_cast<int>(model.getZone()));
 }
 
 void CardManager::setupTouchEvents() {
     if (!_view) {
-        CCLOG(u8"警告：CardView为空，无法设置触摸事件");
+        GLOG_WARN(u8"警告：CardView为空，无法设置触摸事件");
         return;
     }
 
@@ -49,7 +72,7 @@ void CardManager::setupTouchEvents() {
     touchListener->onTouchCancelled = CC_CALLBACK_2(CardManager::onTouchCancelled, this);
 
     dispatcher->addEventListenerWithSceneGraphPriority(touchListener, _view);
-    CCLOG(u8"为卡牌ID：%d 设置触摸事件", _model._id);
+    GLOG_DEBUG(u8"为卡牌ID：%d 设置触摸事件", _model._id);
 }
 
 bool CardManager::onTouchBegan(cocos2d::Touch* touch, cocos2d::Event* event) {
@@ -57,26 +80,72 @@ bool CardManager::onTouchBegan(cocos2d::Touch* touch, cocos2d::Event* event) {
 
     cocos2d::Vec2 touchPos = _view->convertToNodeSpace(touch->getLocation());
     if (!_view->isTouchInside(touchPos)) {
-        CCLOG(u8"触摸不在卡牌ID：%d 范围内", _model._id);
+        GLOG_VERBOSE(u8"触摸不在卡牌ID：%d 范围内", _model._id);
         return false;
     }
 
-    CCLOG(u8"开始触摸卡牌放大 - ID：%d", _model._id);
+    GLOG_DEBUG(u8"开始触摸卡牌放大 - ID：%d", _model._id);
     _view->setScale(1.1f);
     _isSelected = true;
+    _pendingDragDelta = cocos2d::Vec2::ZERO;
+    _dragVelocity = cocos2d::Vec2::ZERO;
+    _dragPosition = _view->getPosition();
     return true;
 }
 
 void CardManager::onTouchMoved(cocos2d::Touch* touch, cocos2d::Event* event) {
     if (!_view || !_isSelected) return;
 
-    // 实现拖拽逻辑：根据触摸偏移移动
-    cocos2d::Vec2 delta = touch->getDelta();
-    _view->setPosition(_view->getPosition() + delta);
+    // 高采样率触摸屏一帧内会送来多个移动事件，这里只累积偏移，视图在每帧回调中统一更新
+    _pendingDragDelta += touch->getDelta();
+    if (!_isDragScheduled) {
+        cocos2d::Director::getInstance()->getScheduler()->schedule(
+            CC_CALLBACK_1(CardManager::applyPendingDrag, this), this, 0, false, kDragScheduleKey);
+        _isDragScheduled = true;
+    }
+}
+
+void CardManager::applyPendingDrag(float dt) {
+    if (!_view) return;
 
-    // 同步更新模型位置
-    _model.setPosition(_view->getPosition() - _view->getParent()->getPosition());
-    CCLOG(u8"卡牌ID：%d 移动中，新位置：(%.0f, %.0f)",
+    _dragPosition += _pendingDragDelta;
+
+    // 按本帧位移估计速度并平滑，没有新输入的帧速度逐渐衰减
+    if (dt > 0) {
+        cocos2d::Vec2 sample = _pendingDragDelta / dt;
+        _dragVelocity = _dragVelocity + (sample - _dragVelocity) * kDragVelocitySmoothing;
+    }
+    _pendingDragDelta = cocos2d::Vec2::ZERO;
+
+    cocos2d::Vec2 displayPosition = _dragPosition;
+#if CARD_DRAG_PREDICTION_MS > 0
+    // 沿当前速度方向前推一小段，抵消触摸采样到画面显示之间的延迟
+    cocos2d::Vec2 lead = _dragVelocity * (CARD_DRAG_PREDICTION_MS / 1000.0f);
+    if (lead.length() > kDragMaxPrediction) {
+        lead = lead.getNormalized() * kDragMaxPrediction;
+    }
+    displayPosition += lead;
+#endif
+
+    if (!_view->getPosition().equals(displayPosition)) {
+        _view->setPosition(displayPosition);
+        GLOG_VERBOSE(u8"卡牌ID：%d 移动中，新位置：(%.0f, %.0f)", _model._id, displayPosition.x, displayPosition.y);
+    }
+}
+
+void CardManager::finishDrag() {
+    if (!_isDragScheduled) return;
+
+    cocos2d::Director::getInstance()->getScheduler()->unschedule(kDragScheduleKey, this);
+    _isDragScheduled = false;
+
+    // 落点使用不含预测量的实际位置，并在此时一次性写回模型
+    _dragPosition += _pendingDragDelta;
+    _pendingDragDelta = cocos2d::Vec2::ZERO;
+    _dragVelocity = cocos2d::Vec2::ZERO;
+    _view->setPosition(_dragPosition);
+    _model.setPosition(_dragPosition - _view->getParent()->getPosition());
+    GLOG_DEBUG(u8"卡牌ID：%d 拖拽结束，落点：(%.0f, %.0f)",
         _model._id, _model.getPosition().x, _model.getPosition().y);
 }
 
@@ -84,12 +153,13 @@ void CardManager::onTouchEnded(cocos2d::Touch* touch, cocos2d::Event* event) {
     if (!_view) return;
 
     _view->setScale(1.0f);
-    CCLOG(u8"触摸结束，卡牌恢复原大小 - ID：%d", _model._id);
+    finishDrag();
+    GLOG_DEBUG(u8"触摸结束，卡牌恢复原大小 - ID：%d", _model._id);
 
     cocos2d::Vec2 touchPos = _view->convertToNodeSpace(touch->getLocation());
-    if (_view->isTouchInside(touchPos) && _cardClickedCallback) {
-        CCLOG(u8"触发点击回调 - 卡牌ID：%d", _model._id);
-        _cardClickedCallback(_model);
+    if (_view->isTouchInside(touchPos) && _eventBus) {
+        GLOG_DEBUG(u8"发布点击事件 - 卡牌ID：%d", _model._id);
+        _eventBus->publish(CardClickedEvent{ _model._id });
     }
 
     _isSelected = false;
@@ -99,11 +169,7 @@ void CardManager::onTouchCancelled(cocos2d::Touch* touch, cocos2d::Event* event)
     if (!_view) return;
 
     _view->setScale(1.0f);
+    finishDrag();
     _isSelected = false;
-    CCLOG(u8"触摸取消 - 卡牌ID：%d 恢复原大小", _model._id);
+    GLOG_DEBUG(u8"触摸取消 - 卡牌ID：%d 恢复原大小", _model._id);
 }
-
-void CardManager::setCardClickedCallback(const std::function<void(CardModel&)>& callback) {
-    _cardClickedCallback = callback;
-    CCLOG(u8"设置卡牌ID：%d 的点击回调", _model._id);
-}
\ No newline at end of file
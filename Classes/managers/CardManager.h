@@ -5,28 +5,32 @@
 #include "models/CardModel.h"
 #include "views/CardView.h"
 #include "cocos2d.h"
-#include <functional>
 
 class CardView;
+class CardIdManagerMap;
+class GameEventBus;
 /*
 卡牌管理器类，负责卡牌的交互逻辑与数据视图绑定
 核心功能：
 1. 管理卡牌触摸事件生命周期（开始、移动、结束、取消）
 2. 作为CardModel与CardView的中间层，同步数据与视图状态
-3. 提供点击回调机制，将用户交互传递给控制器
+3. 通过事件总线发布卡牌点击事件，将用户交互传递给控制器
 4. 维护卡牌选中状态并提供视觉反馈（如缩放效果）
+5. 拖拽合帧：触摸移动只累积偏移，每帧统一应用一次到视图（可选速度预测），
+   松手或取消时才把最终位置写回模型
  */
 class CardManager {
 public:
     /**
      * 构造函数
      * @param model 卡牌数据模型，用于初始化管理器
+     * @param cardManagers 所属对局的卡牌管理器映射（不持有），为nullptr时不登记
      */
-    CardManager(const CardModel& model);
+    CardManager(const CardModel& model, CardIdManagerMap* cardManagers = nullptr);
     
     /**
      * 析构函数
-     * 清理资源并从全局映射中移除自身
+     * 清理资源并从所属对局的映射中移除自身
      */
     ~CardManager();
 
@@ -53,7 +57,7 @@ public:
     
     /**
      * 触摸移动事件回调
-     * 实现卡牌拖拽逻辑
+     * 只累积拖拽偏移，由每帧回调统一应用到视图
      * @param touch 触摸对象
      * @param event 事件对象
      */
@@ -61,7 +65,7 @@ public:
     
     /**
      * 触摸结束事件回调
-     * 恢复卡牌状态并触发点击回调（如果需要）
+     * 恢复卡牌状态并发布点击事件（如果落点仍在卡牌内）
      * @param touch 触摸对象
      * @param event 事件对象
      */
@@ -76,10 +80,10 @@ public:
     void onTouchCancelled(cocos2d::Touch* touch, cocos2d::Event* event);
 
     /**
-     * 设置卡牌点击回调函数
-     * @param callback 回调函数，触摸结束时触发
+     * 设置事件总线，触摸结束时向其发布卡牌点击事件
+     * @param eventBus 事件总线（由GameView持有），为nullptr时不发布
      */
-    void setCardClickedCallback(const std::function<void(CardModel&)>& callback);
+    void setEventBus(GameEventBus* eventBus) { _eventBus = eventBus; }
     
     /**
      * 获取关联的卡牌视图
@@ -89,15 +93,32 @@ public:
     
     /**
      * 获取关联的卡牌模型
-     * @return 卡牌数据模型
+     * 返回引用，控制器对模型的修改（区域、位置）需要同步保留在管理器中
+     * @return 卡牌数据模型的引用
      */
-    CardModel getModel() { return _model; }
+    CardModel& getModel() { return _model; }
 
 private:
+    /**
+     * 每帧回调：把本帧累积的拖拽偏移一次性应用到视图
+     * @param dt 帧间隔（秒）
+     */
+    void applyPendingDrag(float dt);
+
+    /**
+     * 结束拖拽：应用剩余偏移、去掉预测量、写回模型位置并取消每帧回调
+     */
+    void finishDrag();
+
     CardModel _model;                          // 卡牌数据模型
     CardView* _view;                           // 卡牌视图实例
     bool _isSelected;                          // 卡牌选中状态标记
-    std::function<void(CardModel&)> _cardClickedCallback;  // 点击回调函数
+    bool _isDragScheduled;                     // 是否已注册拖拽的每帧回调
+    cocos2d::Vec2 _pendingDragDelta;           // 尚未应用的累积拖拽偏移
+    cocos2d::Vec2 _dragPosition;               // 拖拽中的实际位置（不含预测量）
+    cocos2d::Vec2 _dragVelocity;               // 平滑后的拖拽速度（点/秒），用于预测
+    GameEventBus* _eventBus;                   // 事件总线（不持有）
+    CardIdManagerMap* _cardManagers;           // 所属对局的卡牌管理器映射（不持有）
 };
 
 #endif // CARD_MANAGER_H
\ No newline at end of file
@@ -14,7 +14,8 @@ class UndoManager {
 public:
     /**
      * 构造函数
-     * @param undoModel 撤销数据模型，用于存储操作历史
+     * @param undoModel 撤销数据模型（不持有），操作历史直接记录在该模型中，
+     *                  使GameModel携带完整历史（存档、重新开始都以它为准）
      */
     UndoManager(UndoModel& undoModel) 
         : _undoModel(undoModel) {}
@@ -36,6 +37,15 @@ public:
         return _undoModel.undo(outState);
     }
 
+    /**
+     * 撤销最近一次来自牌堆区(Stack)的操作
+     * @param outState 输出参数，用于接收被撤销的状态信息
+     * @return 撤销成功返回true，没有Stack区操作记录返回false
+     */
+    bool undoStack(UndoCardState& outState) {
+        return _undoModel.undoZone(CardZone::Stack, outState);
+    }
+
     /**
      * 检查是否有可撤销的操作
      * @return 存在撤销历史返回true，否则返回false
@@ -64,16 +74,12 @@ public:
      * @param outState 输出参数，用于接收最后一个状态信息
      * @return 成功获取返回true，无历史记录返回false
      */
-    bool getLastState(UndoCardState& outState) {
-        if (!_undoModel.canUndo()) {
-            return false;
-        }
-        // 创建一个临时副本用于获取最后状态
-        UndoModel tempModel = _undoModel;
-        return tempModel.undo(outState);
+    bool getLastState(UndoCardState& outState) const {
+        // 直接读取栈顶，避免拷贝整个历史记录（该方法位于每次匹配检查的热路径上）
+        return _undoModel.peek(outState);
     }
 
 private:
-    UndoModel _undoModel;  // 撤销数据模型，存储操作历史记录
+    UndoModel& _undoModel;  // 撤销数据模型（引用所属GameModel中的实例）
 };
 #endif
\ No newline at end of file
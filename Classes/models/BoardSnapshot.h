@@ -0,0 +1,86 @@
+#ifndef BOARD_SNAPSHOT_H_
+#define BOARD_SNAPSHOT_H_
+
+#include "GameModel.h"
+#include "MatchRules.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+棋盘快照：某一时刻全盘卡牌的只读副本，供后台线程（提示搜索等）在不接触主线程模型的情况下使用
+核心功能：
+1. 按CardStore的槽位顺序复制牌面、花色、区域、卡牌ID四列，以及手牌栈顶槽位与本关规则参数
+2. 创建后不可修改，以shared_ptr<const BoardSnapshot>在线程间传递，无需加锁
+3. 关卡标识：由全部卡牌的ID、牌面、花色计算，同一关卡的快照相同，供置换表判断能否跨步复用
+ */
+class BoardSnapshot {
+public:
+    /**
+     * 从游戏模型截取快照（主线程调用）
+     * @param model 游戏数据模型
+     * @return 只读快照
+     */
+    static std::shared_ptr<const BoardSnapshot> capture(const GameModel& model) {
+        std::shared_ptr<BoardSnapshot> snapshot(new BoardSnapshot());
+        const CardStore& cards = model.getCards();
+        snapshot->_faces = cards.getFaces();
+        snapshot->_suits = cards.getSuits();
+        snapshot->_zones = cards.getZones();
+        snapshot->_ids.reserve(cards.size());
+        for (int slot = 0; slot < cards.size(); ++slot) {
+            snapshot->_ids.push_back(cards.getId(slot));
+        }
+        snapshot->_handTopSlot = cards.slotOf(model.getHand().top());
+        snapshot->_ruleParams = model.getRuleParams();
+        snapshot->_levelKey = computeLevelKey(snapshot->_ids, snapshot->_faces, snapshot->_suits);
+        return snapshot;
+    }
+
+    // 卡牌总数
+    int size() const { return static_cast<int>(_ids.size()); }
+
+    // 整列只读访问（与CardStore的槽位一一对应）
+    const std::vector<int8_t>& getFaces() const { return _faces; }
+    const std::vector<int8_t>& getSuits() const { return _suits; }
+    const std::vector<uint8_t>& getZones() const { return _zones; }
+
+    // 槽位中的卡牌ID
+    int getId(int slot) const { return _ids[slot]; }
+
+    // 手牌栈顶槽位，手牌区为空时为-1
+    int getHandTopSlot() const { return _handTopSlot; }
+
+    // 本关匹配规则参数
+    const RuleParams& getRuleParams() const { return _ruleParams; }
+
+    // 关卡标识（同一关卡的全部快照相同）
+    uint64_t getLevelKey() const { return _levelKey; }
+
+private:
+    BoardSnapshot() : _handTopSlot(-1), _levelKey(0) {}
+
+    // FNV-1a散列卡牌的静态属性
+    static uint64_t computeLevelKey(const std::vector<int>& ids, const std::vector<int8_t>& faces,
+        const std::vector<int8_t>& suits) {
+        uint64_t hash = 1469598103934665603ULL;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            const uint32_t values[3] = { static_cast<uint32_t>(ids[i]),
+                static_cast<uint32_t>(static_cast<uint8_t>(faces[i])), static_cast<uint32_t>(static_cast<uint8_t>(suits[i])) };
+            for (uint32_t value : values) {
+                hash = (hash ^ value) * 1099511628211ULL;
+            }
+        }
+        return hash;
+    }
+
+    std::vector<int> _ids;          // 卡牌ID
+    std::vector<int8_t> _faces;     // 牌面
+    std::vector<int8_t> _suits;     // 花色
+    std::vector<uint8_t> _zones;    // 所在区域
+    int _handTopSlot;               // 手牌栈顶槽位
+    RuleParams _ruleParams;         // 匹配规则
+    uint64_t _levelKey;             // 关卡标识
+};
+
+#endif // BOARD_SNAPSHOT_H_
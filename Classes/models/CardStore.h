@@ -0,0 +1,203 @@
+#ifndef CARD_STORE_H_
+#define CARD_STORE_H_
+
+#include "cocos2d.h"
+#include "CardModel.h"
+#include "FaceCounts.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+全盘卡牌的结构数组（SoA）存储
+核心功能：
+1. 牌面、花色、区域、坐标、层级各占一个连续数组，以槽位号（0..n-1）索引，
+   匹配检查、走法生成、视图同步等逐卡遍历只读取需要的字段，顺序访问连续内存
+2. 每个区域维护一个槽位索引列表，卡牌换区时从原列表交换删除、追加到新列表，均为O(1)
+3. 卡牌ID到槽位号的映射，供事件与撤销记录（以ID标识卡牌）定位：各加载器的ID从0连续编号，
+   以ID为下标的数组直接查表；只有存档中解出的稀疏ID（远大于卡牌数或为负）才落到散列表
+4. 每个区域按牌面、花色计数，随换区O(1)更新，供死局判断与规则策略直接查询可匹配数
+槽位在加载后固定不变（卡牌只换区不删除），区域列表内的顺序不保证与关卡顺序一致
+ */
+class CardStore {
+public:
+    static const int kZoneCount = static_cast<int>(CardZone::Unknown) + 1; // 区域总数
+
+    /**
+     * 追加一张卡牌
+     * @param card 卡牌模型（使用其ID、牌面、花色、坐标、区域）
+     * @param homeZOrder 卡牌在原区域的层级
+     * @return 新卡牌的槽位号
+     */
+    int add(const CardModel& card, int homeZOrder) {
+        int slot = static_cast<int>(_ids.size());
+        _ids.push_back(card._id);
+        _faces.push_back(static_cast<int8_t>(card.getFace()));
+        _suits.push_back(static_cast<int8_t>(card.getSuit()));
+        _zones.push_back(static_cast<uint8_t>(card.getZone()));
+        _posX.push_back(card.getPosition().x);
+        _posY.push_back(card.getPosition().y);
+        _zOrders.push_back(homeZOrder);
+        _homeZOrders.push_back(homeZOrder);
+
+        std::vector<int>& members = _zoneMembers[zoneIndex(card.getZone())];
+        _zoneSlotPos.push_back(static_cast<int>(members.size()));
+        members.push_back(slot);
+        _zoneCounts[zoneIndex(card.getZone())].add(_faces[slot], _suits[slot]);
+
+        mapId(card._id, slot);
+        return slot;
+    }
+
+    /**
+     * 预留容量，避免加载时多次扩容
+     * @param count 卡牌总数
+     */
+    void reserve(int count) {
+        _ids.reserve(count);
+        _faces.reserve(count);
+        _suits.reserve(count);
+        _zones.reserve(count);
+        _posX.reserve(count);
+        _posY.reserve(count);
+        _zOrders.reserve(count);
+        _homeZOrders.reserve(count);
+        _zoneSlotPos.reserve(count);
+        _slotOfDenseId.reserve(count);
+    }
+
+    /**
+     * 把卡牌移到另一个区域（O(1)交换删除）
+     * @param slot 槽位号
+     * @param zone 目标区域
+     */
+    void setZone(int slot, CardZone zone) {
+        int from = _zones[slot];
+        int to = zoneIndex(zone);
+        if (from == to) {
+            return;
+        }
+
+        // 从原区域列表交换删除：用末尾元素填补空位
+        std::vector<int>& oldMembers = _zoneMembers[from];
+        int pos = _zoneSlotPos[slot];
+        int last = oldMembers.back();
+        oldMembers[pos] = last;
+        _zoneSlotPos[last] = pos;
+        oldMembers.pop_back();
+
+        std::vector<int>& newMembers = _zoneMembers[to];
+        _zoneSlotPos[slot] = static_cast<int>(newMembers.size());
+        newMembers.push_back(slot);
+        _zones[slot] = static_cast<uint8_t>(to);
+
+        _zoneCounts[from].remove(_faces[slot], _suits[slot]);
+        _zoneCounts[to].add(_faces[slot], _suits[slot]);
+    }
+
+    // 设置坐标
+    void setPosition(int slot, const cocos2d::Vec2& position) {
+        _posX[slot] = position.x;
+        _posY[slot] = position.y;
+    }
+
+    // 设置层级
+    void setZOrder(int slot, int zOrder) { _zOrders[slot] = zOrder; }
+
+    /**
+     * 按卡牌ID查找槽位号
+     * @param cardId 卡牌ID
+     * @return 槽位号，不存在时返回-1
+     */
+    int slotOf(int cardId) const {
+        if (cardId >= 0 && cardId < static_cast<int>(_slotOfDenseId.size())) {
+            return _slotOfDenseId[cardId];
+        }
+        if (_slotOfSparseId.empty()) {
+            return -1;
+        }
+        auto it = _slotOfSparseId.find(cardId);
+        return it != _slotOfSparseId.end() ? it->second : -1;
+    }
+
+    // 卡牌总数
+    int size() const { return static_cast<int>(_ids.size()); }
+
+    int getId(int slot) const { return _ids[slot]; }
+    CardFaceType getFace(int slot) const { return static_cast<CardFaceType>(_faces[slot]); }
+    CardSuitType getSuit(int slot) const { return static_cast<CardSuitType>(_suits[slot]); }
+    CardZone getZone(int slot) const { return static_cast<CardZone>(_zones[slot]); }
+    cocos2d::Vec2 getPosition(int slot) const { return cocos2d::Vec2(_posX[slot], _posY[slot]); }
+    int getZOrder(int slot) const { return _zOrders[slot]; }
+    int getHomeZOrder(int slot) const { return _homeZOrders[slot]; }
+
+    /**
+     * 获取区域内的槽位列表
+     * @param zone 区域
+     * @return 槽位号列表的常量引用
+     */
+    const std::vector<int>& getZoneMembers(CardZone zone) const { return _zoneMembers[zoneIndex(zone)]; }
+
+    /**
+     * 获取区域内按牌面、花色的卡牌计数
+     * @param zone 区域
+     * @return 计数的常量引用
+     */
+    const FaceCounts& getZoneCounts(CardZone zone) const { return _zoneCounts[zoneIndex(zone)]; }
+
+    // 整列只读访问（供批量遍历，如匹配内核）
+    const std::vector<int8_t>& getFaces() const { return _faces; }
+    const std::vector<int8_t>& getSuits() const { return _suits; }
+    const std::vector<uint8_t>& getZones() const { return _zones; }
+
+    /**
+     * 把槽位中的卡牌还原为CardModel（用于创建视图等非热路径）
+     * @param slot 槽位号
+     * @return 卡牌模型副本
+     */
+    CardModel toCardModel(int slot) const {
+        return CardModel(getFace(slot), getSuit(slot), getPosition(slot), _ids[slot], getZone(slot));
+    }
+
+private:
+    static const int kDenseIdSlack = 64; // ID不超过 2*卡牌数+该值 时视为连续编号，放入数组
+
+    static int zoneIndex(CardZone zone) { return static_cast<int>(zone); }
+
+    // 记录ID到槽位的映射：连续ID扩展数组（并把已落入散列表、如今在数组范围内的ID移入数组），稀疏ID放入散列表
+    void mapId(int cardId, int slot) {
+        if (cardId < 0 || cardId > 2 * (slot + 1) + kDenseIdSlack) {
+            _slotOfSparseId[cardId] = slot;
+            return;
+        }
+        if (cardId >= static_cast<int>(_slotOfDenseId.size())) {
+            _slotOfDenseId.resize(cardId + 1, -1);
+            for (auto it = _slotOfSparseId.begin(); it != _slotOfSparseId.end();) {
+                if (it->first >= 0 && it->first <= cardId) {
+                    _slotOfDenseId[it->first] = it->second;
+                    it = _slotOfSparseId.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+        _slotOfDenseId[cardId] = slot;
+    }
+
+    std::vector<int> _ids;              // 卡牌ID
+    std::vector<int8_t> _faces;         // 牌面
+    std::vector<int8_t> _suits;         // 花色
+    std::vector<uint8_t> _zones;        // 所在区域
+    std::vector<float> _posX;           // 横坐标
+    std::vector<float> _posY;           // 纵坐标
+    std::vector<int> _zOrders;          // 当前层级
+    std::vector<int> _homeZOrders;      // 原区域层级（撤销、重开时恢复）
+    std::vector<int> _zoneSlotPos;      // 槽位在其区域列表中的下标
+    std::vector<int> _zoneMembers[kZoneCount];  // 各区域的槽位列表
+    FaceCounts _zoneCounts[kZoneCount];         // 各区域按牌面、花色的计数
+    std::vector<int> _slotOfDenseId;            // 卡牌ID -> 槽位号（以ID为下标，-1表示没有）
+    std::unordered_map<int, int> _slotOfSparseId; // 稀疏卡牌ID -> 槽位号（仅存档中的非连续ID）
+};
+
+#endif // CARD_STORE_H_
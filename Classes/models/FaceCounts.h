@@ -0,0 +1,42 @@
+#ifndef FACE_COUNTS_H_
+#define FACE_COUNTS_H_
+
+/*
+按牌面、花色统计的卡牌计数（一个区域一份）
+核心功能：
+1. 卡牌进出区域时O(1)增减，供规则策略以常数次查表得出可匹配卡牌数
+2. 越界的牌面、花色查询返回0，调用方计算 栈顶±1 时无需额外判断边界
+ */
+struct FaceCounts {
+    static const int kFaces = 13;  // 牌面种数
+    static const int kSuits = 4;   // 花色种数
+
+    int total = 0;                          // 卡牌总数
+    int byFace[kFaces] = {};                // 各牌面的卡牌数
+    int byFaceSuit[kFaces][kSuits] = {};    // 各牌面、花色的卡牌数
+
+    // 计入一张卡牌
+    void add(int face, int suit) { adjust(face, suit, 1); }
+
+    // 移除一张卡牌
+    void remove(int face, int suit) { adjust(face, suit, -1); }
+
+    // 某牌面的卡牌数（越界返回0）
+    int face(int f) const { return f >= 0 && f < kFaces ? byFace[f] : 0; }
+
+    // 某牌面、花色的卡牌数（越界返回0）
+    int faceSuit(int f, int s) const { return f >= 0 && f < kFaces && s >= 0 && s < kSuits ? byFaceSuit[f][s] : 0; }
+
+private:
+    void adjust(int face, int suit, int delta) {
+        total += delta;
+        if (face >= 0 && face < kFaces) {
+            byFace[face] += delta;
+            if (suit >= 0 && suit < kSuits) {
+                byFaceSuit[face][suit] += delta;
+            }
+        }
+    }
+};
+
+#endif // FACE_COUNTS_H_
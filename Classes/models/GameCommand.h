@@ -0,0 +1,147 @@
+#ifndef GAME_COMMAND_H_
+#define GAME_COMMAND_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * 玩家指令类型
+ */
+enum class GameCommandType : uint8_t {
+    SelectPlayfield = 0,  // 选择游戏区卡牌与手牌匹配
+    DrawStack = 1,        // 翻开牌堆区卡牌
+    Undo = 2,             // 撤销最近一次操作
+    UndoTo = 3,           // 连续撤销直到历史长度不超过指定值
+    Restart = 4,          // 重新开始本关
+    Count                 // 指令类型总数（用于边界检查）
+};
+
+/*
+玩家指令：把一次输入意图（点击卡牌、撤销、重新开始）表示为可排队、可序列化的数据对象
+核心功能：
+1. 由控制器在输入时创建并排队，在每帧的批处理中统一校验与执行
+2. 固定长度的小端二进制编码，供回放、统计等模块在同一入口记录全部玩家操作
+ */
+struct GameCommand {
+    static const size_t kSerializedSize = 9; // 序列化长度：类型1字节 + 卡牌ID 4字节 + 序号4字节
+
+    GameCommandType type = GameCommandType::Undo; // 指令类型
+    int32_t cardId = -1;                          // 目标卡牌ID（UndoTo为目标历史长度，其余无目标的指令为-1）
+    uint32_t sequence = 0;                        // 指令序号（由控制器入队时分配，单调递增）
+
+    // 创建选择游戏区卡牌指令
+    static GameCommand selectPlayfield(int cardId) { return make(GameCommandType::SelectPlayfield, cardId); }
+
+    // 创建翻开牌堆卡牌指令
+    static GameCommand drawStack(int cardId) { return make(GameCommandType::DrawStack, cardId); }
+
+    // 创建撤销指令
+    static GameCommand undo() { return make(GameCommandType::Undo, -1); }
+
+    // 创建撤销到指定步的指令
+    static GameCommand undoTo(int historySize) { return make(GameCommandType::UndoTo, historySize); }
+
+    // 创建重新开始本关指令
+    static GameCommand restart() { return make(GameCommandType::Restart, -1); }
+
+    /**
+     * 序列化为固定长度的小端字节序列
+     * @param out 输出缓冲区，至少kSerializedSize字节
+     * @return 写入的字节数
+     */
+    size_t serialize(uint8_t* out) const {
+        out[0] = static_cast<uint8_t>(type);
+        writeU32(out + 1, static_cast<uint32_t>(cardId));
+        writeU32(out + 5, sequence);
+        return kSerializedSize;
+    }
+
+    /**
+     * 从字节序列反序列化
+     * @param in 输入缓冲区
+     * @param size 缓冲区长度
+     * @param outCommand 输出参数，接收解析结果
+     * @return 长度足够且类型合法返回true
+     */
+    static bool deserialize(const uint8_t* in, size_t size, GameCommand& outCommand) {
+        if (!in || size < kSerializedSize || in[0] >= static_cast<uint8_t>(GameCommandType::Count)) {
+            return false;
+        }
+        outCommand.type = static_cast<GameCommandType>(in[0]);
+        outCommand.cardId = static_cast<int32_t>(readU32(in + 1));
+        outCommand.sequence = readU32(in + 5);
+        return true;
+    }
+
+private:
+    static GameCommand make(GameCommandType type, int cardId) {
+        GameCommand command;
+        command.type = type;
+        command.cardId = cardId;
+        return command;
+    }
+
+    static void writeU32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    static uint32_t readU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+            (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+};
+
+/*
+指令队列：固定容量的环形缓冲区，入队出队不分配堆内存
+仅在主线程使用；队列满时拒绝新指令（一帧内不可能产生这么多真实输入）
+ */
+class GameCommandQueue {
+public:
+    static const int kCapacity = 64; // 队列容量（必须为2的幂）
+
+    GameCommandQueue() : _head(0), _tail(0) {}
+
+    /**
+     * 指令入队
+     * @param command 待执行指令
+     * @return 入队成功返回true，队列已满返回false
+     */
+    bool push(const GameCommand& command) {
+        if (size() >= kCapacity) {
+            return false;
+        }
+        _commands[_tail & (kCapacity - 1)] = command;
+        ++_tail;
+        return true;
+    }
+
+    /**
+     * 取出队首指令
+     * @param outCommand 输出参数，接收队首指令
+     * @return 队列非空返回true
+     */
+    bool pop(GameCommand& outCommand) {
+        if (_head == _tail) {
+            return false;
+        }
+        outCommand = _commands[_head & (kCapacity - 1)];
+        ++_head;
+        return true;
+    }
+
+    // 当前排队的指令数
+    int size() const { return static_cast<int>(_tail - _head); }
+
+    // 清空队列
+    void clear() { _head = _tail = 0; }
+
+private:
+    GameCommand _commands[kCapacity]; // 指令存储
+    uint32_t _head;                   // 读取位置
+    uint32_t _tail;                   // 写入位置
+};
+
+#endif // GAME_COMMAND_H_
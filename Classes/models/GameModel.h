@@ -4,20 +4,27 @@
 
 #include "cocos2d.h"
 #include "CardModel.h"
+#include "CardStore.h"
 #include "UndoModel.h"
+#include "HandPileModel.h"
+#include <cstdint>
 #include <vector>
 #include "configs/loaders/LevelConfigLoader.h"
 #include "configs/models/LevelConfig.h"
+#include "models/MatchRules.h"
+#include "services/MatchKernel.h"
 
 USING_NS_CC;
 
 /*
 游戏核心数据模型类，管理所有卡牌数据与操作历史
 主要职责：
-1. 存储游戏区（Playfield）和牌堆区（Stack）的卡牌集合
-2. 通过UndoModel维护操作历史，支持撤销功能
-3. 提供卡牌增删接口，供控制器修改游戏状态
-4. 从关卡配置（LevelConfig）初始化卡牌数据
+1. 以结构数组（CardStore）存储全盘卡牌，游戏区、牌堆区、手牌区的成员以槽位索引列表维护
+2. 通过UndoModel维护操作历史，支持撤销功能；通过HandPileModel维护手牌区的栈结构
+3. 提供卡牌添加与换区接口，供控制器修改游戏状态
+4. 按关卡的匹配规则变体，通过MatchKernel一次求出全部可与手牌栈顶匹配的游戏区卡牌，
+   或由区域计数O(1)得出可匹配卡牌数与是否死局
+5. 从关卡配置（LevelConfig）初始化卡牌数据与匹配规则
  */
 class GameModel {
 public:
@@ -27,9 +34,18 @@ public:
      */
     GameModel(LevelConfig* config) {
         if (config) {
-            // 从配置加载游戏区和牌堆区卡牌
-            _playfield = config->getPlayfield();
-            _stackfield = config->getStack();
+            _ruleParams = config->getRuleParams();
+
+            // 从配置加载游戏区和牌堆区卡牌，槽位按 游戏区、牌堆区 的关卡顺序排列
+            std::vector<CardModel> playfield = config->getPlayfield();
+            std::vector<CardModel> stack = config->getStack();
+            reserveZones(static_cast<int>(playfield.size()), static_cast<int>(stack.size()));
+            for (const auto& card : playfield) {
+                addCard(card);
+            }
+            for (const auto& card : stack) {
+                addCard(card);
+            }
 
             // 初始化时清空操作历史
             _undoModel.clearHistory();
@@ -37,19 +53,59 @@ public:
     }
 
     /**
-     * 获取游戏区卡牌列表（只读）
-     * @return 游戏区卡牌集合的常量引用
+     * 获取全盘卡牌存储（只读）
+     * @return 卡牌存储的常量引用
+     */
+    const CardStore& getCards() const {
+        return _cards;
+    }
+
+    /**
+     * 获取全盘卡牌存储（可修改）
+     * @return 卡牌存储的引用
      */
-    const std::vector<CardModel>& getPlayfield() const {
-        return _playfield;
+    CardStore& getCards() {
+        return _cards;
     }
 
     /**
-     * 获取牌堆区卡牌列表（只读）
-     * @return 牌堆区卡牌集合的常量引用
+     * 获取手牌区牌堆（只读）
+     * @return 手牌区牌堆的常量引用
      */
-    const std::vector<CardModel>& getStackfield() const {
-        return _stackfield;
+    const HandPileModel& getHand() const {
+        return _hand;
+    }
+
+    /**
+     * 获取手牌区牌堆（可修改）
+     * @return 手牌区牌堆的引用
+     */
+    HandPileModel& getHand() {
+        return _hand;
+    }
+
+    /**
+     * 获取本关匹配规则参数
+     * @return 规则参数的常量引用
+     */
+    const RuleParams& getRuleParams() const {
+        return _ruleParams;
+    }
+
+    /**
+     * 设置本关匹配规则参数（用于从存档重建棋盘）
+     * @param params 规则参数
+     */
+    void setRuleParams(const RuleParams& params) {
+        _ruleParams = params;
+    }
+
+    /**
+     * 获取撤销模型实例（只读）
+     * @return 撤销模型的常量引用
+     */
+    const UndoModel& getUndoModel() const {
+        return _undoModel;
     }
 
     /**
@@ -61,51 +117,125 @@ public:
     }
 
     /**
-     * 向游戏区添加卡牌
-     * @param card 待添加的卡牌模型
+     * 按各区域的卡牌数预留存储并划分层级区间（逐张添加卡牌前调用）
+     * @param playfieldCount 游戏区卡牌数
+     * @param stackCount 牌堆区卡牌数
      */
-    void addCardToPlayfield(const CardModel& card) {
-        _playfield.push_back(card);
+    void reserveZones(int playfieldCount, int stackCount) {
+        _cards.reserve(playfieldCount + stackCount);
+        _hand.setZoneSizes(playfieldCount, stackCount);
     }
 
     /**
-     * 向牌堆区添加卡牌
+     * 添加卡牌，层级为其所在区域层级区间内的下一层
      * @param card 待添加的卡牌模型
+     * @return 新卡牌的槽位号
      */
-    void addCardToStackfield(const CardModel& card) {
-        _stackfield.push_back(card);
+    int addCard(const CardModel& card) {
+        int indexInZone = static_cast<int>(_cards.getZoneMembers(card.getZone()).size());
+        CCASSERT(indexInZone < _hand.zoneBandWidth(card.getZone()), "GameModel: zone exceeds its z band, call reserveZones first");
+        return _cards.add(card, _hand.zOrderFor(card.getZone(), indexInZone));
     }
 
     /**
-     * 从游戏区移除指定ID的卡牌
-     * @param id 待移除卡牌的唯一标识符
+     * 把指定ID的卡牌移到另一个区域（O(1)）
+     * @param id 卡牌唯一标识符
+     * @param zone 目标区域
+     * @return 卡牌存在返回true
      */
-    void removeCardFromPlayfield(int id) {
-        for (auto it = _playfield.begin(); it != _playfield.end(); ++it) {
-            if (it->_id == id) {
-                _playfield.erase(it);
-                break;
-            }
+    bool moveCard(int id, CardZone zone) {
+        int slot = _cards.slotOf(id);
+        if (slot < 0) {
+            return false;
         }
+        _cards.setZone(slot, zone);
+        return true;
     }
 
     /**
-     * 从牌堆区移除指定ID的卡牌
-     * @param id 待移除卡牌的唯一标识符
+     * 按指定规则策略求出全部可与手牌栈顶匹配的游戏区卡牌（编译期特化，供求解器等内层循环调用）
+     * @param outMask 输出位掩码，第slot位表示槽位slot可走；会被调整为MatchKernel::wordCount(卡牌数)个字
+     * @return 可匹配的卡牌数，手牌区为空时返回0
      */
-    void removeCardFromStackfield(int id) {
-        for (auto it = _stackfield.begin(); it != _stackfield.end(); ++it) {
-            if (it->_id == id) {
-                _stackfield.erase(it);
-                break;
-            }
+    template <class Rule>
+    int findPlayableCards(std::vector<uint64_t>& outMask) const {
+        outMask.assign(MatchKernel::wordCount(_cards.size()), 0);
+        int topSlot = _cards.slotOf(_hand.top());
+        if (topSlot < 0) {
+            return 0;
         }
+        MatchQuery query = Rule::query(_ruleParams, static_cast<int>(_cards.getFace(topSlot)),
+            static_cast<int>(_cards.getSuit(topSlot)));
+        return MatchKernel::findPlayable(_cards.getFaces().data(), _cards.getSuits().data(), _cards.getZones().data(),
+            _cards.size(), query, outMask.data());
+    }
+
+    /**
+     * 按本关规则变体求出全部可与手牌栈顶匹配的游戏区卡牌
+     * @param outMask 输出位掩码，同上
+     * @return 可匹配的卡牌数，手牌区为空时返回0
+     */
+    int findPlayableCards(std::vector<uint64_t>& outMask) const {
+        return dispatchRuleVariant(_ruleParams.variant, FindPlayableVisitor{*this, outMask});
+    }
+
+    /**
+     * 按指定规则策略计算可与手牌栈顶匹配的游戏区卡牌数（O(1)）
+     * @return 可匹配的卡牌数，手牌区为空时返回0
+     */
+    template <class Rule>
+    int countPlayableCards() const {
+        int topSlot = _cards.slotOf(_hand.top());
+        if (topSlot < 0) {
+            return 0;
+        }
+        return Rule::playableCount(_ruleParams, _cards.getZoneCounts(CardZone::Playfield),
+            static_cast<int>(_cards.getFace(topSlot)), static_cast<int>(_cards.getSuit(topSlot)));
+    }
+
+    /**
+     * 按本关规则变体计算可与手牌栈顶匹配的游戏区卡牌数（O(1)）
+     * @return 可匹配的卡牌数，手牌区为空时返回0
+     */
+    int countPlayableCards() const {
+        return dispatchRuleVariant(_ruleParams.variant, CountPlayableVisitor{*this});
+    }
+
+    /**
+     * 是否已成死局：游戏区仍有卡牌，但牌堆已空且没有可匹配的卡牌（O(1)）
+     * @return 死局返回true
+     */
+    bool isDeadEnd() const {
+        return !_cards.getZoneMembers(CardZone::Playfield).empty() &&
+            _cards.getZoneMembers(CardZone::Stack).empty() && countPlayableCards() == 0;
     }
 
 private:
-    std::vector<CardModel> _playfield;   // 游戏区卡牌集合（玩家主要操作区域）
-    std::vector<CardModel> _stackfield;  // 牌堆区卡牌集合（待抽取的卡牌区域）
+    // 供dispatchRuleVariant调用：按策略类型转调findPlayableCards<Rule>
+    struct FindPlayableVisitor {
+        const GameModel& model;
+        std::vector<uint64_t>& outMask;
+
+        template <class Rule>
+        int operator()(Rule) const {
+            return model.findPlayableCards<Rule>(outMask);
+        }
+    };
+
+    // 供dispatchRuleVariant调用：按策略类型转调countPlayableCards<Rule>
+    struct CountPlayableVisitor {
+        const GameModel& model;
+
+        template <class Rule>
+        int operator()(Rule) const {
+            return model.countPlayableCards<Rule>();
+        }
+    };
+
+    CardStore _cards;                    // 全盘卡牌（结构数组）
+    RuleParams _ruleParams;              // 本关匹配规则
     UndoModel _undoModel;                // 撤销模型，记录操作历史用于回溯
+    HandPileModel _hand;                 // 手牌区牌堆（卡牌ID栈）
 };
 
-#endif // GAME_MODEL_H_
\ No newline at end of file
+#endif // GAME_MODEL_H_
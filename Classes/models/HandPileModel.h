@@ -0,0 +1,122 @@
+#ifndef HAND_PILE_MODEL_H_
+#define HAND_PILE_MODEL_H_
+
+#include "CardModel.h"
+#include <climits>
+#include <vector>
+
+/*
+手牌区牌堆模型：把手牌区显式建模为栈，并为每个区域预先划分层级区间
+核心功能：
+1. 按移入顺序保存手牌区卡牌ID，栈顶即当前用于匹配的卡牌，入栈、出栈、取栈顶均为O(1)
+2. 层级区间：游戏区、牌堆区、手牌区各占一段互不重叠的层级，区间起点在关卡加载时由各区域卡牌数推导
+   （游戏区从0开始，牌堆区紧随其后，手牌区位于最上方且不设上限），任意规模的关卡都不会重叠；
+   卡牌的层级由 区间起点 + 区内序号 直接算出，无需查询场景节点或重复排序
+3. 支持从中间移除卡牌（仅牌堆区专用撤销会用到），其上的卡牌依次下移一层
+ */
+class HandPileModel {
+public:
+    static const int kPlayfieldZBase = 0;        // 游戏区层级起点
+    static const int kDefaultZoneBandWidth = 1000; // 未设置区域规模时游戏区、牌堆区的层级区间宽度
+
+    /**
+     * 按关卡各区域的卡牌数划分层级区间（须在添加卡牌之前调用）
+     * @param playfieldCount 游戏区卡牌数
+     * @param stackCount 牌堆区卡牌数
+     */
+    void setZoneSizes(int playfieldCount, int stackCount) {
+        _stackZBase = kPlayfieldZBase + playfieldCount;
+        _handZBase = _stackZBase + stackCount;
+    }
+
+    /**
+     * 区域层级区间可容纳的卡牌数
+     * @param zone 卡牌区域
+     * @return 区间宽度，手牌区不设上限
+     */
+    int zoneBandWidth(CardZone zone) const {
+        switch (zone) {
+        case CardZone::Stack: return _handZBase - _stackZBase;
+        case CardZone::Hand: return INT_MAX;
+        default: return _stackZBase - kPlayfieldZBase;
+        }
+    }
+
+    /**
+     * 计算区域内第index张卡牌的层级
+     * @param zone 卡牌区域
+     * @param index 区内序号（游戏区、牌堆区为关卡中的顺序，手牌区为栈中位置）
+     * @return 层级
+     */
+    int zOrderFor(CardZone zone, int index) const {
+        switch (zone) {
+        case CardZone::Stack: return _stackZBase + index;
+        case CardZone::Hand: return _handZBase + index;
+        default: return kPlayfieldZBase + index;
+        }
+    }
+
+    /**
+     * 卡牌入栈
+     * @param cardId 卡牌ID
+     * @return 该卡牌在手牌区的层级
+     */
+    int push(int cardId) {
+        _cards.push_back(cardId);
+        return zOrderFor(CardZone::Hand, static_cast<int>(_cards.size()) - 1);
+    }
+
+    /**
+     * 栈顶卡牌出栈
+     * @return 出栈卡牌ID，栈为空时返回-1
+     */
+    int pop() {
+        if (_cards.empty()) {
+            return -1;
+        }
+        int cardId = _cards.back();
+        _cards.pop_back();
+        return cardId;
+    }
+
+    /**
+     * 移除指定卡牌（栈顶时等同于出栈）
+     * @param cardId 卡牌ID
+     * @return 被移除的位置，其上的卡牌层级均下移一层；卡牌不在手牌区时返回-1
+     */
+    int remove(int cardId) {
+        if (!_cards.empty() && _cards.back() == cardId) {
+            _cards.pop_back();
+            return static_cast<int>(_cards.size());
+        }
+        for (int i = static_cast<int>(_cards.size()) - 2; i >= 0; --i) {
+            if (_cards[i] == cardId) {
+                _cards.erase(_cards.begin() + i);
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // 栈顶卡牌ID，栈为空时返回-1
+    int top() const { return _cards.empty() ? -1 : _cards.back(); }
+
+    // 手牌区卡牌数
+    int size() const { return static_cast<int>(_cards.size()); }
+
+    // 手牌区是否为空
+    bool empty() const { return _cards.empty(); }
+
+    // 第index张卡牌的ID（0为最底下一张）
+    int cardAt(int index) const { return _cards[index]; }
+
+    // 清空手牌区
+    void clear() { _cards.clear(); }
+
+private:
+    std::vector<int> _cards;                                // 卡牌ID，按移入顺序从底到顶
+    int _stackZBase = kPlayfieldZBase + kDefaultZoneBandWidth; // 牌堆区层级起点
+    int _handZBase = _stackZBase + kDefaultZoneBandWidth;   // 手牌区层级起点（始终位于其他区域之上）
+};
+
+#endif // HAND_PILE_MODEL_H_
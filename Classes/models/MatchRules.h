@@ -0,0 +1,303 @@
+#ifndef MATCH_RULES_H_
+#define MATCH_RULES_H_
+
+#include "CardModel.h"
+#include "FaceCounts.h"
+#include "services/MatchKernel.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * 匹配规则变体（关卡文件"RuleVariant"字段）
+ */
+enum class RuleVariant : uint8_t {
+    Adjacent = 0,       // 牌面相差1（默认）
+    Wraparound = 1,     // 牌面相差1，K与A首尾相接
+    SameColor = 2,      // 牌面相差1且花色同色
+    SameSuitBonus = 3,  // 牌面相差1，同花色额外加分
+    Wildcard = 4,       // 牌面相差1，万能牌面（"WildFace"）可与任意卡牌匹配
+    Count               // 变体总数（用于边界检查）
+};
+
+/*
+关卡的匹配规则参数：规则变体及其附加参数，随关卡配置加载、由GameModel持有
+ */
+struct RuleParams {
+    RuleVariant variant = RuleVariant::Adjacent; // 规则变体
+    int wildFace = -1;                           // 万能牌面（仅Wildcard变体使用，-1表示没有万能牌）
+
+    /**
+     * 按名称解析规则变体
+     * @param name 变体名称，如"Wraparound"
+     * @param outVariant 输出参数，接收解析结果
+     * @return 名称有效返回true
+     */
+    static bool parseVariant(const char* name, RuleVariant& outVariant) {
+        for (int i = 0; i < static_cast<int>(RuleVariant::Count); ++i) {
+            if (name && std::strcmp(name, variantName(static_cast<RuleVariant>(i))) == 0) {
+                outVariant = static_cast<RuleVariant>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 获取规则变体名称（与关卡文件中的写法一致）
+     * @param variant 规则变体
+     * @return 变体名称
+     */
+    static const char* variantName(RuleVariant variant) {
+        switch (variant) {
+        case RuleVariant::Wraparound: return "Wraparound";
+        case RuleVariant::SameColor: return "SameColor";
+        case RuleVariant::SameSuitBonus: return "SameSuitBonus";
+        case RuleVariant::Wildcard: return "Wildcard";
+        default: return "Adjacent";
+        }
+    }
+};
+
+/*
+匹配规则策略：每种规则变体是一个只含静态内联函数的策略类，供模板化的走法生成、求解器在编译期特化
+每个策略提供：
+1. matches：单张卡牌能否与手牌栈顶匹配
+2. score：一次匹配得到的分数
+3. query：手牌栈顶对应的批量匹配查询（MatchKernel），与matches逐张判断的结果一致
+4. playableCount：由游戏区的牌面、花色计数以常数次查表得出可匹配卡牌数（O(1)，用于死局判断），
+   调用方保证手牌区非空
+调用方在关卡加载时按RuleVariant分派一次（dispatchRuleVariant / RuleOps::forVariant），之后不再按规则分支
+ */
+namespace MatchRuleDetail {
+    const int kFaceKinds = static_cast<int>(CardFaceType::CFT_NUM_CARD_FACE_TYPES); // 牌面种数
+    const int kMatchScore = 10;         // 每次匹配的基础分
+    const int kSameSuitBonus = 10;      // 同花色匹配的额外分（SameSuitBonus变体）
+
+    inline bool isAdjacent(int face, int handFace) {
+        return face == handFace + 1 || face == handFace - 1;
+    }
+
+    // 方块、红桃为红色，梅花、黑桃为黑色
+    inline bool isRed(int suit) {
+        return suit == static_cast<int>(CardSuitType::CST_DIAMONDS) || suit == static_cast<int>(CardSuitType::CST_HEARTS);
+    }
+
+    // 栈顶±1的游戏区卡牌数
+    inline int adjacentCount(const FaceCounts& playfield, int handFace) {
+        return playfield.face(handFace - 1) + playfield.face(handFace + 1);
+    }
+
+    // 栈顶±1的查询（越出牌面范围的一侧不填）
+    inline MatchQuery adjacentQuery(int handFace) {
+        MatchQuery query = MatchQuery::none();
+        if (handFace > 0) {
+            query.faces[0] = static_cast<int8_t>(handFace - 1);
+        }
+        if (handFace + 1 < kFaceKinds) {
+            query.faces[1] = static_cast<int8_t>(handFace + 1);
+        }
+        return query;
+    }
+}
+
+// 默认规则：牌面相差1
+struct AdjacentRule {
+    static const RuleVariant kVariant = RuleVariant::Adjacent;
+
+    static bool matches(const RuleParams&, int face, int, int handFace, int) {
+        return MatchRuleDetail::isAdjacent(face, handFace);
+    }
+
+    static int score(const RuleParams&, int, int, int, int) {
+        return MatchRuleDetail::kMatchScore;
+    }
+
+    static MatchQuery query(const RuleParams&, int handFace, int) {
+        return MatchRuleDetail::adjacentQuery(handFace);
+    }
+
+    static int playableCount(const RuleParams&, const FaceCounts& playfield, int handFace, int) {
+        return MatchRuleDetail::adjacentCount(playfield, handFace);
+    }
+};
+
+// 首尾相接：K与A相邻
+struct WraparoundRule {
+    static const RuleVariant kVariant = RuleVariant::Wraparound;
+
+    static bool matches(const RuleParams&, int face, int, int handFace, int) {
+        const int n = MatchRuleDetail::kFaceKinds;
+        return face == (handFace + 1) % n || face == (handFace + n - 1) % n;
+    }
+
+    static int score(const RuleParams&, int, int, int, int) {
+        return MatchRuleDetail::kMatchScore;
+    }
+
+    static MatchQuery query(const RuleParams&, int handFace, int) {
+        const int n = MatchRuleDetail::kFaceKinds;
+        MatchQuery query = MatchQuery::none();
+        query.faces[0] = static_cast<int8_t>((handFace + n - 1) % n);
+        query.faces[1] = static_cast<int8_t>((handFace + 1) % n);
+        return query;
+    }
+
+    static int playableCount(const RuleParams&, const FaceCounts& playfield, int handFace, int) {
+        const int n = MatchRuleDetail::kFaceKinds;
+        return playfield.face((handFace + n - 1) % n) + playfield.face((handFace + 1) % n);
+    }
+};
+
+// 同色：牌面相差1且与栈顶同为红色或同为黑色
+struct SameColorRule {
+    static const RuleVariant kVariant = RuleVariant::SameColor;
+
+    static bool matches(const RuleParams&, int face, int suit, int handFace, int handSuit) {
+        return MatchRuleDetail::isAdjacent(face, handFace) &&
+            MatchRuleDetail::isRed(suit) == MatchRuleDetail::isRed(handSuit);
+    }
+
+    static int score(const RuleParams&, int, int, int, int) {
+        return MatchRuleDetail::kMatchScore;
+    }
+
+    static MatchQuery query(const RuleParams&, int handFace, int handSuit) {
+        MatchQuery query = MatchRuleDetail::adjacentQuery(handFace);
+        const bool red = MatchRuleDetail::isRed(handSuit);
+        const int8_t first = static_cast<int8_t>(red ? CardSuitType::CST_DIAMONDS : CardSuitType::CST_CLUBS);
+        const int8_t second = static_cast<int8_t>(red ? CardSuitType::CST_HEARTS : CardSuitType::CST_SPADES);
+        query.suits[0] = first;
+        query.suits[1] = second;
+        query.suits[2] = first;
+        query.suits[3] = second;
+        return query;
+    }
+
+    static int playableCount(const RuleParams&, const FaceCounts& playfield, int handFace, int handSuit) {
+        const bool red = MatchRuleDetail::isRed(handSuit);
+        const int first = static_cast<int>(red ? CardSuitType::CST_DIAMONDS : CardSuitType::CST_CLUBS);
+        const int second = static_cast<int>(red ? CardSuitType::CST_HEARTS : CardSuitType::CST_SPADES);
+        return playfield.faceSuit(handFace - 1, first) + playfield.faceSuit(handFace - 1, second) +
+            playfield.faceSuit(handFace + 1, first) + playfield.faceSuit(handFace + 1, second);
+    }
+};
+
+// 同花加分：匹配条件同默认规则，与栈顶同花色时额外加分
+struct SameSuitBonusRule {
+    static const RuleVariant kVariant = RuleVariant::SameSuitBonus;
+
+    static bool matches(const RuleParams&, int face, int, int handFace, int) {
+        return MatchRuleDetail::isAdjacent(face, handFace);
+    }
+
+    static int score(const RuleParams&, int, int suit, int, int handSuit) {
+        return MatchRuleDetail::kMatchScore + (suit == handSuit ? MatchRuleDetail::kSameSuitBonus : 0);
+    }
+
+    static MatchQuery query(const RuleParams&, int handFace, int) {
+        return MatchRuleDetail::adjacentQuery(handFace);
+    }
+
+    static int playableCount(const RuleParams&, const FaceCounts& playfield, int handFace, int) {
+        return MatchRuleDetail::adjacentCount(playfield, handFace);
+    }
+};
+
+// 万能牌：万能牌面可以匹配任意栈顶，栈顶为万能牌面时任意卡牌均可匹配
+struct WildcardRule {
+    static const RuleVariant kVariant = RuleVariant::Wildcard;
+
+    static bool matches(const RuleParams& params, int face, int, int handFace, int) {
+        if (params.wildFace >= 0 && (face == params.wildFace || handFace == params.wildFace)) {
+            return face >= 0;
+        }
+        return MatchRuleDetail::isAdjacent(face, handFace);
+    }
+
+    static int score(const RuleParams&, int, int, int, int) {
+        return MatchRuleDetail::kMatchScore;
+    }
+
+    static MatchQuery query(const RuleParams& params, int handFace, int) {
+        MatchQuery query = MatchRuleDetail::adjacentQuery(handFace);
+        if (params.wildFace >= 0) {
+            if (handFace == params.wildFace) {
+                query.faceAbove = -1;
+                query.faceBelow = static_cast<int8_t>(MatchRuleDetail::kFaceKinds);
+            }
+            else {
+                query.faces[2] = static_cast<int8_t>(params.wildFace);
+            }
+        }
+        return query;
+    }
+
+    static int playableCount(const RuleParams& params, const FaceCounts& playfield, int handFace, int) {
+        if (params.wildFace < 0) {
+            return MatchRuleDetail::adjacentCount(playfield, handFace);
+        }
+        if (handFace == params.wildFace) {
+            return playfield.total;
+        }
+        const bool wildIsAdjacent = params.wildFace == handFace - 1 || params.wildFace == handFace + 1;
+        return MatchRuleDetail::adjacentCount(playfield, handFace) + (wildIsAdjacent ? 0 : playfield.face(params.wildFace));
+    }
+};
+
+/**
+ * 按规则变体调用一次以策略类型特化的函数对象，之后的内层循环不再按规则分支
+ * 用法：visitor为带模板调用运算符的函数对象，如 template <class Rule> R operator()(Rule) const { ... }
+ * @param variant 规则变体
+ * @param visitor 接受策略对象（空类型标签）的函数对象
+ * @return visitor的返回值
+ */
+template <class Visitor>
+auto dispatchRuleVariant(RuleVariant variant, Visitor&& visitor) -> decltype(visitor(AdjacentRule())) {
+    switch (variant) {
+    case RuleVariant::Wraparound: return visitor(WraparoundRule());
+    case RuleVariant::SameColor: return visitor(SameColorRule());
+    case RuleVariant::SameSuitBonus: return visitor(SameSuitBonusRule());
+    case RuleVariant::Wildcard: return visitor(WildcardRule());
+    default: return visitor(AdjacentRule());
+    }
+}
+
+/*
+规则函数表：把策略类的静态函数绑定为函数指针，供非模板代码（如控制器的单次点击）在加载时选定规则
+ */
+struct RuleOps {
+    bool (*matches)(const RuleParams&, int face, int suit, int handFace, int handSuit);
+    int (*score)(const RuleParams&, int face, int suit, int handFace, int handSuit);
+    MatchQuery (*query)(const RuleParams&, int handFace, int handSuit);
+    int (*playableCount)(const RuleParams&, const FaceCounts& playfield, int handFace, int handSuit);
+
+    // 从策略类生成函数表
+    template <class Rule>
+    static RuleOps make() {
+        RuleOps ops;
+        ops.matches = &Rule::matches;
+        ops.score = &Rule::score;
+        ops.query = &Rule::query;
+        ops.playableCount = &Rule::playableCount;
+        return ops;
+    }
+
+    // 供dispatchRuleVariant调用：按策略类型生成函数表
+    struct Maker {
+        template <class Rule>
+        RuleOps operator()(Rule) const {
+            return make<Rule>();
+        }
+    };
+
+    /**
+     * 按规则变体生成函数表
+     * @param variant 规则变体
+     * @return 对应策略的函数表
+     */
+    static RuleOps forVariant(RuleVariant variant) {
+        return dispatchRuleVariant(variant, Maker());
+    }
+};
+
+#endif // MATCH_RULES_H_
@@ -2,7 +2,9 @@
 #define UNDO_MODEL_H_
 
 #include "cocos2d.h"
-#include "CardModel.h"  
+#include "CardModel.h"
+#include <iterator>
+#include <vector>
 
 USING_NS_CC;
 
@@ -13,6 +15,7 @@ struct UndoCardState {
     int id;                 // 卡牌唯一标识符
     Vec2 position;          // 操作前的位置坐标
     CardZone zone;          // 操作前所在的区域
+    int score;              // 该次操作获得的分数（撤销时扣回）
 };
 
 /*
@@ -53,6 +56,37 @@ public:
         return true;
     }
 
+    /**
+     * 查看最近一次操作的状态但不从历史中移除（O(1)，不拷贝历史）
+     * @param outState 输出参数，用于接收历史状态
+     * @return 成功获取返回true，无历史记录返回false
+     */
+    bool peek(UndoCardState& outState) const {
+        if (_history.empty()) {
+            return false;
+        }
+        outState = _history.back();
+        return true;
+    }
+
+    /**
+     * 撤销指定区域最近一次的操作记录
+     * 从历史末尾向前查找第一条来源区域匹配的记录并将其移除
+     * @param zone 操作前所在的区域
+     * @param outState 输出参数，用于接收被撤销的状态
+     * @return 找到并移除返回true，否则返回false
+     */
+    bool undoZone(CardZone zone, UndoCardState& outState) {
+        for (auto it = _history.rbegin(); it != _history.rend(); ++it) {
+            if (it->zone == zone) {
+                outState = *it;
+                _history.erase(std::next(it).base());
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * 清空所有历史记录
      */
@@ -76,6 +110,14 @@ public:
         return _history.size(); 
     }
 
+    /**
+     * 获取全部历史记录（按操作顺序，只读）
+     * @return 历史状态列表的常量引用
+     */
+    const std::vector<UndoCardState>& getHistory() const {
+        return _history;
+    }
+
 private:
     std::vector<UndoCardState> _history;  // 按操作顺序存储的历史状态列表
 };
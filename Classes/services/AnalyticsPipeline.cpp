@@ -0,0 +1,391 @@
+#include "services/AnalyticsPipeline.h"
+#include "services/Crc32.h"
+#include "services/GameLog.h"
+#include "services/LzCodec.h"
+#include "services/PerfMonitor.h"
+#include "cocos2d.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    const char* const kFilePrefix = "analytics_";   // 文件名前缀，后接槽位号
+    const char* const kFileSuffix = ".bin";         // 文件名后缀
+    const size_t kFileHeaderSize = 4 + 1 + 4;       // 魔数 + 版本 + 文件序号
+    const size_t kBatchHeaderSize = 4 + 4 + 4;      // 原始长度 + 压缩长度 + 原始数据CRC32
+    const size_t kMaxBatchBytes = 1 << 20;          // 读取时单批原始长度上限（防止损坏的长度字段导致巨量分配）
+
+    void writeU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+    }
+
+    uint32_t readU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+            (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    // 读取文件头中的序号，文件不存在或文件头无效返回false
+    bool readSequence(const std::string& path, uint32_t& outSequence) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+        uint8_t header[kFileHeaderSize];
+        const bool valid = std::fread(header, 1, sizeof(header), file) == sizeof(header) &&
+            readU32(header) == AnalyticsPipeline::kMagic && header[4] == AnalyticsPipeline::kVersion;
+        std::fclose(file);
+        if (valid) {
+            outSequence = readU32(header + 5);
+        }
+        return valid;
+    }
+}
+
+AnalyticsPipeline::AnalyticsPipeline()
+    : _eventBus(nullptr), _clickSubscription(-1), _commandSubscription(-1), _clearedSubscription(-1),
+      _deadEndSubscription(-1), _startNs(0), _lastMoveMs(0), _currentBlock(-1), _currentFill(0),
+      _currentBlockStartMs(0), _frameEvents(0), _droppedCount(0), _file(nullptr), _fileBytes(0), _nextSequence(0),
+      _storage(static_cast<size_t>(kBlockCount) * kBlockEvents), _freeCount(0), _readyHead(0), _readyCount(0),
+      _running(false) {
+}
+
+AnalyticsPipeline::~AnalyticsPipeline() {
+    stop();
+}
+
+std::string AnalyticsPipeline::defaultDirectory() {
+    return cocos2d::FileUtils::getInstance()->getWritablePath();
+}
+
+std::string AnalyticsPipeline::slotPath(uint32_t sequence) const {
+    return _directory + kFilePrefix + std::to_string(sequence % kMaxFiles) + kFileSuffix;
+}
+
+bool AnalyticsPipeline::start(const std::string& directory, GameEventBus* eventBus) {
+    stop();
+    _directory = directory;
+    _startNs = PerfMonitor::nowNs();
+    _lastMoveMs = 0;
+    _frameEvents = 0;
+    _droppedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _freeCount = 0;
+        for (int block = kBlockCount - 1; block >= 0; --block) {
+            _freeBlocks[_freeCount++] = block;
+        }
+        _readyHead = 0;
+        _readyCount = 0;
+        acquireBlock();
+        _running = true;
+    }
+    _worker = std::thread(&AnalyticsPipeline::run, this);
+
+    _eventBus = eventBus;
+    if (_eventBus) {
+        _clickSubscription = _eventBus->subscribe<CardClickedEvent>([this](const CardClickedEvent& event) {
+            record(AnalyticsEventType::CardClicked, event.cardId, 0);
+        });
+        _commandSubscription = _eventBus->subscribe<CommandAppliedEvent>([this](const CommandAppliedEvent& event) {
+            const GameCommand& command = event.command;
+            if (command.type == GameCommandType::SelectPlayfield || command.type == GameCommandType::DrawStack) {
+                if (event.accepted) {
+                    const uint32_t now = static_cast<uint32_t>((PerfMonitor::nowNs() - _startNs) / 1000000);
+                    record(AnalyticsEventType::Move, command.cardId, static_cast<int>(now - _lastMoveMs));
+                    _lastMoveMs = now;
+                }
+                else if (command.type == GameCommandType::SelectPlayfield) {
+                    record(AnalyticsEventType::Mismatch, command.cardId, 0);
+                }
+            }
+            else if (event.accepted &&
+                (command.type == GameCommandType::Undo || command.type == GameCommandType::UndoTo)) {
+                record(AnalyticsEventType::Undo, -1, 0);
+            }
+        });
+        _clearedSubscription = _eventBus->subscribe<LevelClearedEvent>([this](const LevelClearedEvent& event) {
+            record(AnalyticsEventType::LevelCleared, -1, event.moveCount);
+        });
+        _deadEndSubscription = _eventBus->subscribe<NoMovesLeftEvent>([this](const NoMovesLeftEvent& event) {
+            record(AnalyticsEventType::NoMovesLeft, -1, event.remainingCards);
+        });
+    }
+    GLOG_INFO(u8"分析事件管线已开始：%s", directory.c_str());
+    return true;
+}
+
+void AnalyticsPipeline::stop() {
+    if (_eventBus) {
+        _eventBus->unsubscribe<CardClickedEvent>(_clickSubscription);
+        _eventBus->unsubscribe<CommandAppliedEvent>(_commandSubscription);
+        _eventBus->unsubscribe<LevelClearedEvent>(_clearedSubscription);
+        _eventBus->unsubscribe<NoMovesLeftEvent>(_deadEndSubscription);
+        _eventBus = nullptr;
+    }
+    if (!_worker.joinable()) {
+        return;
+    }
+    if (_currentBlock >= 0 && _currentFill > 0) {
+        submitCurrentBlock();
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _wake.notify_one();
+    _worker.join();
+    _currentBlock = -1;
+    _currentFill = 0;
+    if (_droppedCount > 0) {
+        GLOG_WARN(u8"分析事件管线丢弃了%d条事件", static_cast<int>(_droppedCount));
+    }
+}
+
+void AnalyticsPipeline::record(AnalyticsEventType type, int cardId, int value) {
+    if (_currentBlock < 0 || _frameEvents >= kMaxEventsPerFrame) {
+        ++_droppedCount;
+        return;
+    }
+    ++_frameEvents;
+
+    const uint32_t now = static_cast<uint32_t>((PerfMonitor::nowNs() - _startNs) / 1000000);
+    if (_currentFill == 0) {
+        _currentBlockStartMs = now;
+    }
+    AnalyticsEvent& event = _storage[static_cast<size_t>(_currentBlock) * kBlockEvents + _currentFill];
+    event.timeMs = now;
+    event.cardId = cardId;
+    event.value = value;
+    event.type = type;
+    event.reserved[0] = event.reserved[1] = event.reserved[2] = 0;
+    if (++_currentFill == kBlockEvents) {
+        submitCurrentBlock();
+    }
+}
+
+void AnalyticsPipeline::beginFrame() {
+    _frameEvents = 0;
+    if (!_worker.joinable()) {
+        return;
+    }
+    if (_currentBlock < 0) {
+        // 上一帧没有空闲块，后台线程可能已归还
+        std::lock_guard<std::mutex> lock(_mutex);
+        acquireBlock();
+        return;
+    }
+    const uint32_t now = static_cast<uint32_t>((PerfMonitor::nowNs() - _startNs) / 1000000);
+    if (_currentFill > 0 && now - _currentBlockStartMs >= static_cast<uint32_t>(kFlushIntervalMs)) {
+        submitCurrentBlock();
+    }
+}
+
+void AnalyticsPipeline::submitCurrentBlock() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const int tail = (_readyHead + _readyCount) % kBlockCount;
+        _readyBlocks[tail] = _currentBlock;
+        _readySizes[tail] = _currentFill;
+        ++_readyCount;
+        acquireBlock();
+    }
+    _wake.notify_one();
+}
+
+void AnalyticsPipeline::acquireBlock() {
+    _currentBlock = _freeCount > 0 ? _freeBlocks[--_freeCount] : -1;
+    _currentFill = 0;
+}
+
+void AnalyticsPipeline::run() {
+    // 启动时把上次遗留的文件按序号从旧到新交给上传回调，并接着最大序号编号
+    std::vector<std::pair<uint32_t, std::string>> leftovers;
+    for (int slot = 0; slot < kMaxFiles; ++slot) {
+        const std::string path = _directory + kFilePrefix + std::to_string(slot) + kFileSuffix;
+        uint32_t sequence = 0;
+        if (readSequence(path, sequence)) {
+            leftovers.emplace_back(sequence, path);
+        }
+    }
+    std::sort(leftovers.begin(), leftovers.end());
+    _nextSequence = leftovers.empty() ? 0 : leftovers.back().first + 1;
+    for (const auto& leftover : leftovers) {
+        upload(leftover.second);
+    }
+    openNextFile();
+
+    for (;;) {
+        int block = -1;
+        int count = 0;
+        bool running = true;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _readyCount > 0 || !_running; });
+            if (_readyCount > 0) {
+                block = _readyBlocks[_readyHead];
+                count = _readySizes[_readyHead];
+                _readyHead = (_readyHead + 1) % kBlockCount;
+                --_readyCount;
+            }
+            running = _running;
+        }
+
+        if (block >= 0) {
+            writeBlock(&_storage[static_cast<size_t>(block) * kBlockEvents], count);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _freeBlocks[_freeCount++] = block;
+            continue; // 停止前先写完全部待写块
+        }
+        if (!running) {
+            break;
+        }
+    }
+    closeFile();
+}
+
+void AnalyticsPipeline::writeBlock(const AnalyticsEvent* events, int count) {
+    // 字段逐个按小端编码，文件与平台字节序无关
+    _encoded.resize(static_cast<size_t>(count) * kEventSize);
+    uint8_t* out = _encoded.data();
+    for (int i = 0; i < count; ++i, out += kEventSize) {
+        writeU32(out, events[i].timeMs);
+        writeU32(out + 4, static_cast<uint32_t>(events[i].cardId));
+        writeU32(out + 8, static_cast<uint32_t>(events[i].value));
+        out[12] = static_cast<uint8_t>(events[i].type);
+        out[13] = out[14] = out[15] = 0;
+    }
+    _compressed.resize(kBatchHeaderSize);
+    LzCodec::compress(_encoded.data(), _encoded.size(), _compressed);
+    writeU32(_compressed.data(), static_cast<uint32_t>(_encoded.size()));
+    writeU32(_compressed.data() + 4, static_cast<uint32_t>(_compressed.size() - kBatchHeaderSize));
+    writeU32(_compressed.data() + 8, Crc32::compute(_encoded.data(), _encoded.size()));
+
+    if (_file && _fileBytes > kFileHeaderSize && _fileBytes + _compressed.size() > kMaxFileBytes) {
+        closeFile();
+        openNextFile();
+    }
+    if (!_file) {
+        return;
+    }
+    if (std::fwrite(_compressed.data(), 1, _compressed.size(), _file) != _compressed.size()) {
+        GLOG_ERROR(u8"分析文件写入失败：%s", _filePath.c_str());
+    }
+    std::fflush(_file);
+    _fileBytes += _compressed.size();
+}
+
+bool AnalyticsPipeline::openNextFile() {
+    const uint32_t sequence = _nextSequence++;
+    _filePath = slotPath(sequence);
+    // 槽位循环使用：打开即覆盖最旧的文件，文件数不超过kMaxFiles
+    _file = std::fopen(_filePath.c_str(), "wb");
+    if (!_file) {
+        GLOG_ERROR(u8"分析文件创建失败：%s", _filePath.c_str());
+        return false;
+    }
+    uint8_t header[kFileHeaderSize];
+    writeU32(header, kMagic);
+    header[4] = kVersion;
+    writeU32(header + 5, sequence);
+    std::fwrite(header, 1, sizeof(header), _file);
+    _fileBytes = sizeof(header);
+    return true;
+}
+
+void AnalyticsPipeline::closeFile() {
+    if (!_file) {
+        return;
+    }
+    std::fclose(_file);
+    _file = nullptr;
+    upload(_filePath);
+}
+
+void AnalyticsPipeline::upload(const std::string& path) {
+    if (!_uploader) {
+        return;
+    }
+    std::vector<AnalyticsEvent> events;
+    if (!readFile(path, events)) {
+        return;
+    }
+    // 空文件（只有文件头）无需上传
+    if (events.empty() || _uploader(events)) {
+        std::remove(path.c_str());
+    }
+}
+
+bool AnalyticsPipeline::logSummary(const std::vector<AnalyticsEvent>& events) {
+    int counts[static_cast<int>(AnalyticsEventType::NoMovesLeft) + 1] = {};
+    int64_t moveIntervalMs = 0;
+    for (const auto& event : events) {
+        const int type = static_cast<int>(event.type);
+        if (type > 0 && type <= static_cast<int>(AnalyticsEventType::NoMovesLeft)) {
+            ++counts[type];
+        }
+        if (event.type == AnalyticsEventType::Move) {
+            moveIntervalMs += event.value;
+        }
+    }
+    const int moves = counts[static_cast<int>(AnalyticsEventType::Move)];
+    GLOG_INFO(u8"分析事件（本地替身上传）- 共%d条：点击%d，不匹配%d，撤销%d，移动%d（平均间隔%d毫秒），过关%d，死局%d",
+        static_cast<int>(events.size()), counts[static_cast<int>(AnalyticsEventType::CardClicked)],
+        counts[static_cast<int>(AnalyticsEventType::Mismatch)], counts[static_cast<int>(AnalyticsEventType::Undo)],
+        moves, moves > 0 ? static_cast<int>(moveIntervalMs / moves) : 0,
+        counts[static_cast<int>(AnalyticsEventType::LevelCleared)],
+        counts[static_cast<int>(AnalyticsEventType::NoMovesLeft)]);
+    return false;
+}
+
+bool AnalyticsPipeline::readFile(const std::string& path, std::vector<AnalyticsEvent>& outEvents) {
+    outEvents.clear();
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    std::fclose(file);
+
+    if (data.size() < kFileHeaderSize || readU32(data.data()) != kMagic || data[4] != kVersion) {
+        GLOG_WARN(u8"分析文件头无效：%s", path.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> raw;
+    size_t offset = kFileHeaderSize;
+    while (offset + kBatchHeaderSize <= data.size()) {
+        const size_t rawSize = readU32(data.data() + offset);
+        const size_t compressedSize = readU32(data.data() + offset + 4);
+        const uint32_t crc = readU32(data.data() + offset + 8);
+        const uint8_t* body = data.data() + offset + kBatchHeaderSize;
+        if (rawSize > kMaxBatchBytes || rawSize % kEventSize != 0 ||
+            compressedSize > data.size() - offset - kBatchHeaderSize) {
+            break;
+        }
+        raw.resize(rawSize);
+        if (!LzCodec::decompress(body, compressedSize, raw.data(), rawSize) ||
+            Crc32::compute(raw.data(), rawSize) != crc) {
+            break;
+        }
+        for (size_t i = 0; i < rawSize; i += kEventSize) {
+            AnalyticsEvent event;
+            event.timeMs = readU32(raw.data() + i);
+            event.cardId = static_cast<int32_t>(readU32(raw.data() + i + 4));
+            event.value = static_cast<int32_t>(readU32(raw.data() + i + 8));
+            event.type = static_cast<AnalyticsEventType>(raw[i + 12]);
+            event.reserved[0] = event.reserved[1] = event.reserved[2] = 0;
+            outEvents.push_back(event);
+        }
+        offset += kBatchHeaderSize + compressedSize;
+    }
+    if (offset < data.size()) {
+        GLOG_WARN(u8"分析文件末尾有%d字节损坏，已忽略：%s", static_cast<int>(data.size() - offset), path.c_str());
+    }
+    return true;
+}
@@ -0,0 +1,200 @@
+#ifndef ANALYTICS_PIPELINE_H_
+#define ANALYTICS_PIPELINE_H_
+
+#include "services/GameEventBus.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 分析事件类型
+ */
+enum class AnalyticsEventType : uint8_t {
+    CardClicked = 1,    // 点击卡牌（视图发布的CardClickedEvent）
+    Mismatch,           // 选择的游戏区卡牌不匹配（被拒绝的SelectPlayfield指令）
+    Undo,               // 撤销生效（Undo / UndoTo）
+    Move,               // 移动生效，value为距上一次生效移动的毫秒数（本局第一次为距开始记录）
+    LevelCleared,       // 关卡完成，value为移动次数
+    NoMovesLeft         // 死局，value为游戏区剩余卡牌数
+};
+
+/**
+ * 一条分析事件（定长16字节，预分配的块中原地写入）
+ */
+struct AnalyticsEvent {
+    uint32_t timeMs;            // 距开始记录的毫秒数
+    int32_t cardId;             // 相关卡牌ID，无则为-1
+    int32_t value;              // 事件附带的数值（含义见AnalyticsEventType）
+    AnalyticsEventType type;    // 事件类型
+    uint8_t reserved[3];        // 保留，写入0
+};
+
+/*
+离线分析事件管线：采集对局中的点击、不匹配、撤销与移动间隔，压缩后写入本地轮转文件，留待上传
+核心功能：
+1. 订阅事件总线（视图发布的点击事件、控制器发布的指令结果与关卡结束事件），也可直接调用record；
+   热路径只向预分配的事件块写入16字节，不做I/O，不分配内存，不加锁（只在交出整块时加锁一次）
+2. 内存上限：kBlockCount个各kBlockEvents条的事件块循环使用；后台线程来不及处理、没有空闲块时丢弃事件并计数
+3. 每帧上限：每帧最多记录kMaxEventsPerFrame条，超出的丢弃并计数；beginFrame每帧调用一次，
+   并把开始超过kFlushIntervalMs的未满块交给后台线程
+4. 后台线程把整块事件编码为小端字段、经LzCodec压缩后加上CRC32追加到当前文件；
+   文件超过kMaxFileBytes时轮转，最多保留kMaxFiles个文件（覆盖最旧的一个），磁盘占用有上限
+5. 发件箱：文件关闭（轮转、停止）后及启动时遗留的文件交给上传回调，回调返回true即删除；
+   未设置回调时文件留在磁盘上，由轮转上限控制占用
+record与beginFrame只能在主线程调用；上传回调在后台线程执行
+ */
+class AnalyticsPipeline {
+public:
+    static const int kBlockEvents = 512;            // 每个事件块的容量
+    static const int kBlockCount = 4;               // 事件块数量（内存上限 = 4 * 512 * 16字节）
+    static const int kMaxEventsPerFrame = 64;       // 每帧最多记录的事件数
+    static const int kFlushIntervalMs = 2000;       // 未满的事件块最长多久交给后台线程（毫秒）
+    static const size_t kMaxFileBytes = 64 * 1024;  // 单个文件的大小上限，超过即轮转
+    static const int kMaxFiles = 8;                 // 最多保留的文件数
+    static const uint32_t kMagic = 0x45414743;      // 文件魔数（小端"CGAE"）
+    static const uint8_t kVersion = 1;              // 格式版本
+    static const size_t kEventSize = 16;            // 一条事件编码后的字节数
+
+    /**
+     * 上传回调：收到一个已关闭文件中的全部事件，返回true表示已送达，文件随即删除
+     */
+    typedef std::function<bool(const std::vector<AnalyticsEvent>&)> Uploader;
+
+    AnalyticsPipeline();
+
+    /**
+     * 析构函数：交出未满的事件块，写完并关闭文件后停止后台线程
+     */
+    ~AnalyticsPipeline();
+
+    AnalyticsPipeline(const AnalyticsPipeline&) = delete;
+    AnalyticsPipeline& operator=(const AnalyticsPipeline&) = delete;
+
+    /**
+     * 获取默认的文件目录（可写目录）
+     * @return 目录路径（以路径分隔符结尾）
+     */
+    static std::string defaultDirectory();
+
+    /**
+     * 设置上传回调（须在start之前调用）
+     * @param uploader 上传回调，为空时文件只保留在磁盘上
+     */
+    void setUploader(const Uploader& uploader) { _uploader = uploader; }
+
+    /**
+     * 开始记录：启动后台线程并订阅事件总线
+     * @param directory 文件目录（以路径分隔符结尾）
+     * @param eventBus 事件总线（不持有，须比管线后析构），为nullptr时只能手动record
+     * @return 后台线程启动成功返回true
+     */
+    bool start(const std::string& directory, GameEventBus* eventBus);
+
+    /**
+     * 停止记录：退订事件，交出未满的事件块，写完并关闭文件后结束后台线程（可重复调用）
+     */
+    void stop();
+
+    /**
+     * 记录一条事件（主线程，O(1)，不分配内存）
+     * @param type 事件类型
+     * @param cardId 相关卡牌ID，无则为-1
+     * @param value 事件附带的数值
+     */
+    void record(AnalyticsEventType type, int cardId, int value);
+
+    /**
+     * 每帧调用一次：重置每帧计数，补领空闲块，交出超时的未满块
+     */
+    void beginFrame();
+
+    /**
+     * 获取因内存或每帧上限被丢弃的事件数
+     * @return 丢弃的事件数
+     */
+    uint64_t getDroppedCount() const { return _droppedCount; }
+
+    /**
+     * 本地替身上传回调：只把事件按类型汇总写入日志并返回false（文件保留在磁盘上，待接入真正的上传服务）
+     * @param events 一个文件中的全部事件
+     * @return 总是返回false
+     */
+    static bool logSummary(const std::vector<AnalyticsEvent>& events);
+
+    /**
+     * 读取一个分析文件（上传、离线分析使用）；遇到不完整或校验失败的批次即停止
+     * @param path 文件路径
+     * @param outEvents 输出参数，接收文件中的事件
+     * @return 文件头有效返回true
+     */
+    static bool readFile(const std::string& path, std::vector<AnalyticsEvent>& outEvents);
+
+private:
+    // 后台线程主循环
+    void run();
+
+    // 把当前块交给后台线程并领取一个空闲块（主线程）
+    void submitCurrentBlock();
+
+    // 领取一个空闲块，没有时当前块为-1（主线程，调用方持锁）
+    void acquireBlock();
+
+    // 编码、压缩一个事件块并追加到当前文件，必要时轮转（后台线程）
+    void writeBlock(const AnalyticsEvent* events, int count);
+
+    // 打开下一个序号的文件（后台线程）
+    bool openNextFile();
+
+    // 关闭当前文件并交给上传回调（后台线程）
+    void closeFile();
+
+    // 把文件交给上传回调，送达后删除（后台线程）
+    void upload(const std::string& path);
+
+    // 文件槽位对应的路径
+    std::string slotPath(uint32_t sequence) const;
+
+    std::string _directory;                 // 文件目录
+    GameEventBus* _eventBus;                // 事件总线（不持有）
+    int _clickSubscription;                 // CardClickedEvent订阅句柄
+    int _commandSubscription;               // CommandAppliedEvent订阅句柄
+    int _clearedSubscription;               // LevelClearedEvent订阅句柄
+    int _deadEndSubscription;               // NoMovesLeftEvent订阅句柄
+    Uploader _uploader;                     // 上传回调
+
+    // 以下仅主线程访问
+    uint64_t _startNs;                      // 开始记录的时刻
+    uint32_t _lastMoveMs;                   // 上一次生效移动的时刻
+    int _currentBlock;                      // 正在写入的事件块，-1表示没有空闲块
+    int _currentFill;                       // 当前块已写入的事件数
+    uint32_t _currentBlockStartMs;          // 当前块第一条事件的时刻
+    int _frameEvents;                       // 本帧已记录的事件数
+    uint64_t _droppedCount;                 // 丢弃的事件数
+
+    // 以下仅后台线程访问
+    std::FILE* _file;                       // 当前文件
+    std::string _filePath;                  // 当前文件路径
+    size_t _fileBytes;                      // 当前文件已写入的字节数
+    uint32_t _nextSequence;                 // 下一个文件的序号
+    std::vector<uint8_t> _encoded;          // 编码缓冲区（复用）
+    std::vector<uint8_t> _compressed;       // 压缩缓冲区（复用）
+
+    std::vector<AnalyticsEvent> _storage;   // 全部事件块（kBlockCount * kBlockEvents，构造时分配）
+    std::mutex _mutex;                      // 保护以下块队列
+    std::condition_variable _wake;          // 唤醒后台线程
+    int _freeBlocks[kBlockCount];           // 空闲块栈
+    int _freeCount;                         // 空闲块数
+    int _readyBlocks[kBlockCount];          // 待写入块队列（环形）
+    int _readySizes[kBlockCount];           // 待写入块的事件数
+    int _readyHead;                         // 队首位置
+    int _readyCount;                        // 待写入块数
+    bool _running;                          // 后台线程运行标记
+    std::thread _worker;                    // 后台写入线程
+};
+
+#endif // ANALYTICS_PIPELINE_H_
@@ -0,0 +1,63 @@
+#include "services/AutoPlayer.h"
+#include "controllers/GameController.h"
+#include "models/BoardSnapshot.h"
+#include "services/GameLog.h"
+
+AutoPlayer::AutoPlayer(int budgetMs)
+    : _solver(budgetMs), _budgetMs(budgetMs), _nodeLimit(0) {
+}
+
+bool AutoPlayer::chooseMove(const GameModel& model, GameCommand& outCommand) {
+    const CardStore& cards = model.getCards();
+    if (cards.getZoneMembers(CardZone::Playfield).empty() || model.isDeadEnd()) {
+        return false;
+    }
+
+    std::shared_ptr<const BoardSnapshot> snapshot = BoardSnapshot::capture(model);
+    _lastResult = _nodeLimit > 0 ? _solver.solveNodes(*snapshot, _nodeLimit) : _solver.solveNow(*snapshot, _budgetMs);
+    const HintMove& best = _lastResult.best;
+    if (!best.isValid()) {
+        // 第一层都没搜完（预算过紧），或每一步都通向死局（搜索不给出走法）时兜底，把输局走到底
+        return fallbackMove(model, outCommand);
+    }
+
+    outCommand = best.fromStack ? GameCommand::drawStack(best.cardId) : GameCommand::selectPlayfield(best.cardId);
+    GLOG_DEBUG(u8"自动对局 - 卡牌ID：%d，来自牌堆区：%d，搜索深度：%d，节点数：%llu，已解出：%d",
+        best.cardId, best.fromStack ? 1 : 0, best.depth,
+        static_cast<unsigned long long>(_lastResult.nodes), _lastResult.solved ? 1 : 0);
+    return true;
+}
+
+bool AutoPlayer::step(GameController& controller) {
+    if (controller.getStatus() != GameStatus::Playing) {
+        return false;
+    }
+    GameCommand command;
+    if (!chooseMove(controller.getGameModel(), command)) {
+        return false;
+    }
+    return controller.enqueueCommand(command);
+}
+
+bool AutoPlayer::fallbackMove(const GameModel& model, GameCommand& outCommand) {
+    const CardStore& cards = model.getCards();
+    if (model.findPlayableCards(_playableMask) > 0) {
+        for (size_t word = 0; word < _playableMask.size(); ++word) {
+            if (_playableMask[word] != 0) {
+                int bit = 0;
+                while (!((_playableMask[word] >> bit) & 1)) {
+                    ++bit;
+                }
+                outCommand = GameCommand::selectPlayfield(cards.getId(static_cast<int>(word) * 64 + bit));
+                return true;
+            }
+        }
+    }
+
+    const std::vector<int>& stackSlots = cards.getZoneMembers(CardZone::Stack);
+    if (!stackSlots.empty()) {
+        outCommand = GameCommand::drawStack(cards.getId(stackSlots.back()));
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#ifndef AUTO_PLAYER_H_
+#define AUTO_PLAYER_H_
+
+#include "models/GameCommand.h"
+#include "models/GameModel.h"
+#include "services/BoardSolver.h"
+#include <vector>
+
+class GameController;
+
+/*
+自动对局机器人：每步在时间预算内迭代加深搜索当前局面，把找到的最佳走法作为普通指令交给控制器
+核心功能：
+1. 持有独立的BoardSolver并同步搜索（solveNow），不与视图的后台提示服务争用置换表；
+   置换表在同一关卡的连续局面之间保留，前几步搜过的子树在后续步中直接命中，预算越紧越受益
+2. 随时可停：每完成一层深度就更新最佳走法，预算耗尽时返回已完成的最深一层的结果；
+   连第一层都没搜完、或已经必输（每一步都通向死局）时退回到第一张可匹配的游戏区卡牌，再退回到翻开牌堆
+3. 走法经GameController::enqueueCommand进入指令队列，与玩家点击走同一条校验、动画、撤销与日志路径
+用于"自动完成"、演示模式、"帮我走"辅助功能与无界面浸泡测试；只能在主线程调用
+ */
+class AutoPlayer {
+public:
+    static const int kDefaultBudgetMs = 2; // 默认每步的搜索时间预算（毫秒）
+
+    /**
+     * 构造函数
+     * @param budgetMs 每步的搜索时间预算（毫秒）
+     */
+    explicit AutoPlayer(int budgetMs = kDefaultBudgetMs);
+
+    AutoPlayer(const AutoPlayer&) = delete;
+    AutoPlayer& operator=(const AutoPlayer&) = delete;
+
+    /**
+     * 接入残局库（不持有，须比机器人后析构），收录范围内的局面一次查表得出走法
+     * @param tablebase 已打开的残局库，为nullptr时断开
+     */
+    void setTablebase(const EndgameTablebase* tablebase) { _solver.setTablebase(tablebase); }
+
+    /**
+     * 改为按节点数上限搜索（离线工具使用）：走法只取决于局面，与机器速度、并行线程数无关
+     * @param nodeLimit 每步的节点数上限，0表示恢复按时间预算搜索
+     */
+    void setNodeLimit(uint64_t nodeLimit) { _nodeLimit = nodeLimit; }
+
+    /**
+     * 为当前局面选择一步走法
+     * @param model 当前棋盘
+     * @param outCommand 输出参数，接收走法对应的指令（选择游戏区卡牌或翻开牌堆）
+     * @return 有可用走法返回true，游戏区已清空或死局返回false
+     */
+    bool chooseMove(const GameModel& model, GameCommand& outCommand);
+
+    /**
+     * 走一步：对局进行中时选择走法并入队，由控制器在下一次processCommands时执行
+     * @param controller 游戏控制器
+     * @return 已入队一步走法返回true；对局已结束、没有可用走法或队列已满返回false
+     */
+    bool step(GameController& controller);
+
+    /**
+     * 获取最近一次搜索的结果（深度、节点数、是否已解出）
+     * @return 搜索结果
+     */
+    const SolveResult& getLastResult() const { return _lastResult; }
+
+private:
+    // 搜索没有得出走法时的兜底走法，没有可用走法返回false
+    bool fallbackMove(const GameModel& model, GameCommand& outCommand);
+
+    BoardSolver _solver;                // 同步搜索使用的求解器（不启动工作线程）
+    const int _budgetMs;                // 每步的搜索时间预算
+    uint64_t _nodeLimit;                // 每步的节点数上限（非0时代替时间预算）
+    SolveResult _lastResult;            // 最近一次搜索的结果
+    std::vector<uint64_t> _playableMask; // 兜底走法的可匹配位掩码（复用）
+};
+
+#endif // AUTO_PLAYER_H_
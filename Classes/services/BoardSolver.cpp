@@ -0,0 +1,423 @@
+#include "services/BoardSolver.h"
+#include "services/EndgameTablebase.h"
+#include "services/GameLog.h"
+#include "services/MatchKernel.h"
+#include "services/PerfMonitor.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+    const int kWinScore = 10000;         // 清空游戏区的估值基数（加上剩余深度，越快清空越高）
+    const int kDeadEndScore = -10000;    // 死局估值
+    const uint64_t kAbortCheckMask = 1023; // 每1024个节点检查一次截止时间与代号
+    const uint64_t kNsPerMs = 1000000ULL;
+    const uint8_t kPlayfieldZone = static_cast<uint8_t>(CardZone::Playfield);
+    const uint8_t kStackZone = static_cast<uint8_t>(CardZone::Stack);
+    const uint8_t kHandZone = static_cast<uint8_t>(CardZone::Hand);
+
+    // splitmix64：由关卡标识生成Zobrist键
+    uint64_t splitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // 最低置位的位序号（de Bruijn乘法，bits非0）
+    int lowestBit(uint64_t bits) {
+        static const int kIndex[64] = {
+            0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+            62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+            63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+            46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+        };
+        return kIndex[((bits & (0 - bits)) * 0x03f79d71b4cb0a89ULL) >> 58];
+    }
+}
+
+/*
+单次搜索的工作状态：快照区域列的可修改副本、手牌栈顶、增量维护的Zobrist键，以及按层复用的走法缓冲区
+ */
+struct BoardSolver::SearchContext {
+    const BoardSnapshot* snapshot = nullptr;
+    std::vector<uint8_t> zones;                 // 区域列副本（走子/撤回时修改）
+    std::vector<int> stackSlots;                // 搜索开始时位于牌堆区的槽位
+    std::vector<std::vector<uint64_t>> masks;   // 每层的可匹配位掩码
+    std::vector<std::vector<int>> moves;        // 每层的走法列表
+    int handTop = -1;                           // 手牌栈顶槽位
+    int playfieldLeft = 0;                      // 游戏区剩余卡牌数
+    int stackLeft = 0;                          // 牌堆区剩余卡牌数
+    FaceCounts playfieldCounts;                 // 游戏区按牌面、花色的计数（走子/撤回时增减，用于O(1)死局判断）
+    int ply = 0;                                // 当前层数
+    uint64_t key = 0;                           // 当前局面键
+    uint64_t deadlineNs = 0;                    // 截止时间，0表示不限时
+    uint64_t nodeLimit = 0;                     // 节点数上限，0表示不限
+    uint32_t generation = 0;                    // 本次搜索代号，0表示不检查
+    uint64_t nodes = 0;                         // 已搜索节点数
+    bool aborted = false;                       // 已放弃
+};
+
+/*
+供dispatchRuleVariant调用：按规则策略类型转调searchWith<Rule>
+ */
+struct BoardSolver::SearchVisitor {
+    BoardSolver& solver;
+    SearchContext& context;
+    int maxDepth;
+    uint32_t generation;
+
+    template <class Rule>
+    SolveResult operator()(Rule) const {
+        return solver.searchWith<Rule>(context, maxDepth, generation);
+    }
+};
+
+BoardSolver::BoardSolver(int budgetMs)
+    : _budgetMs(budgetMs), _tablebase(nullptr), _tableLevelKey(0), _generation(0), _bestMove(0),
+      _pendingGeneration(0), _running(false) {
+}
+
+BoardSolver::~BoardSolver() {
+    stop();
+}
+
+void BoardSolver::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_running) {
+        return;
+    }
+    _running = true;
+    _worker = std::thread(&BoardSolver::run, this);
+}
+
+void BoardSolver::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running) {
+            return;
+        }
+        _running = false;
+        _pending.reset();
+    }
+    _generation.fetch_add(1, std::memory_order_release);
+    _wake.notify_all();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+void BoardSolver::submit(std::shared_ptr<const BoardSnapshot> snapshot) {
+    if (!snapshot) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint32_t generation = _generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (generation == 0) {
+            generation = _generation.fetch_add(1, std::memory_order_acq_rel) + 1; // 0保留给同步搜索
+        }
+        _pending = std::move(snapshot);
+        _pendingGeneration = generation;
+    }
+    _wake.notify_one();
+}
+
+void BoardSolver::cancel() {
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.reset();
+}
+
+bool BoardSolver::getHint(HintMove& outMove) const {
+    const uint64_t packed = _bestMove.load(std::memory_order_acquire);
+    if (packed == 0 || static_cast<uint32_t>(packed >> 32) != _generation.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const uint32_t low = static_cast<uint32_t>(packed);
+    outMove.cardId = static_cast<int>(low & 0x7fffff) - 1;
+    outMove.fromStack = ((low >> 23) & 1) != 0;
+    outMove.depth = static_cast<int>(low >> 24);
+    return true;
+}
+
+SolveResult BoardSolver::solveNow(const BoardSnapshot& snapshot, int budgetMs, int maxDepth) {
+    uint64_t deadline = budgetMs > 0 ? PerfMonitor::nowNs() + static_cast<uint64_t>(budgetMs) * kNsPerMs : 0;
+    return search(snapshot, deadline, 0, maxDepth, 0);
+}
+
+SolveResult BoardSolver::solveNodes(const BoardSnapshot& snapshot, uint64_t nodeLimit, int maxDepth) {
+    return search(snapshot, 0, nodeLimit, maxDepth, 0);
+}
+
+void BoardSolver::run() {
+    for (;;) {
+        std::shared_ptr<const BoardSnapshot> snapshot;
+        uint32_t generation = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return !_running || _pending; });
+            if (!_running) {
+                return;
+            }
+            snapshot.swap(_pending);
+            generation = _pendingGeneration;
+        }
+        if (generation != _generation.load(std::memory_order_acquire)) {
+            continue; // 取出前已被新的操作取消
+        }
+
+        uint64_t deadline = PerfMonitor::nowNs() + static_cast<uint64_t>(_budgetMs) * kNsPerMs;
+        SolveResult result = search(*snapshot, deadline, 0, kMaxDepth, generation);
+        GLOG_DEBUG(u8"提示搜索结束 - 代号：%u，卡牌ID：%d，深度：%d，节点数：%llu，已解出：%d",
+            generation, result.best.cardId, result.best.depth,
+            static_cast<unsigned long long>(result.nodes), result.solved ? 1 : 0);
+    }
+}
+
+void BoardSolver::prepareTable(const BoardSnapshot& snapshot) {
+    if (_table.empty()) {
+        _table.resize(static_cast<size_t>(1) << kTableBits);
+    }
+    if (snapshot.getLevelKey() == _tableLevelKey && static_cast<int>(_zobristTop.size()) == snapshot.size()) {
+        return; // 同一关卡：保留上一步的置换表
+    }
+
+    uint64_t state = snapshot.getLevelKey();
+    _zobristRemoved.resize(snapshot.size());
+    _zobristTop.resize(snapshot.size());
+    for (int slot = 0; slot < snapshot.size(); ++slot) {
+        _zobristRemoved[slot] = splitMix64(state);
+        _zobristTop[slot] = splitMix64(state);
+    }
+    std::memset(_table.data(), 0, sizeof(TableEntry) * _table.size());
+    _tableLevelKey = snapshot.getLevelKey();
+}
+
+SolveResult BoardSolver::search(const BoardSnapshot& snapshot, uint64_t deadlineNs, uint64_t nodeLimit, int maxDepth,
+    uint32_t generation) {
+    SolveResult tablebaseResult;
+    if (probeTablebase(snapshot, maxDepth, tablebaseResult)) {
+        if (generation != 0) {
+            publish(generation, tablebaseResult.best);
+        }
+        return tablebaseResult;
+    }
+
+    prepareTable(snapshot);
+
+    SearchContext context;
+    context.snapshot = &snapshot;
+    context.zones = snapshot.getZones();
+    context.handTop = snapshot.getHandTopSlot();
+    context.deadlineNs = deadlineNs;
+    context.nodeLimit = nodeLimit;
+    context.generation = generation;
+    const int words = MatchKernel::wordCount(snapshot.size());
+    context.masks.assign(maxDepth + 1, std::vector<uint64_t>(words > 0 ? words : 1));
+    context.moves.resize(maxDepth + 1);
+    for (int slot = 0; slot < snapshot.size(); ++slot) {
+        if (context.zones[slot] == kPlayfieldZone) {
+            ++context.playfieldLeft;
+            context.playfieldCounts.add(snapshot.getFaces()[slot], snapshot.getSuits()[slot]);
+        }
+        else if (context.zones[slot] == kStackZone) {
+            context.stackSlots.push_back(slot);
+            ++context.stackLeft;
+        }
+        else if (context.zones[slot] == kHandZone) {
+            context.key ^= _zobristRemoved[slot];
+        }
+    }
+    if (context.handTop >= 0) {
+        context.key ^= _zobristTop[context.handTop];
+    }
+
+    return dispatchRuleVariant(snapshot.getRuleParams().variant, SearchVisitor{*this, context, maxDepth, generation});
+}
+
+bool BoardSolver::probeTablebase(const BoardSnapshot& snapshot, int maxDepth, SolveResult& outResult) const {
+    TablebaseProbe probe;
+    if (!_tablebase || !_tablebase->probe(snapshot, probe)) {
+        return false;
+    }
+    // 与迭代加深的估值口径一致：清空游戏区的估值为kWinScore加剩余深度
+    outResult.best = probe.move;
+    outResult.solved = probe.win;
+    outResult.value = probe.win ? kWinScore + std::max(0, maxDepth - probe.pliesToWin) : kDeadEndScore;
+    outResult.nodes = 0;
+    return true;
+}
+
+template <class Rule>
+SolveResult BoardSolver::searchWith(SearchContext& context, int maxDepth, uint32_t generation) {
+    SolveResult result;
+    const int movable = context.playfieldLeft + static_cast<int>(context.stackSlots.size());
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        int bestSlot = -1;
+        int value = searchNode<Rule>(context, depth, &bestSlot);
+        if (context.aborted) {
+            break;
+        }
+
+        // 只有完整搜完的深度才更新结果
+        result.value = value;
+        result.best.cardId = bestSlot >= 0 ? context.snapshot->getId(bestSlot) : -1;
+        result.best.fromStack = bestSlot >= 0 && context.snapshot->getZones()[bestSlot] == kStackZone;
+        result.best.depth = depth;
+        if (generation != 0) {
+            publish(generation, result.best);
+        }
+
+        if (value >= kWinScore) {
+            result.solved = true;
+            break;
+        }
+        if (bestSlot < 0 || depth >= movable) {
+            break; // 根节点无路可走，或已能搜到所有剩余卡牌
+        }
+    }
+    result.nodes = context.nodes;
+    return result;
+}
+
+template <class Rule>
+int BoardSolver::searchNode(SearchContext& context, int depth, int* outBestSlot) {
+    ++context.nodes;
+    if (context.nodeLimit != 0 && context.nodes > context.nodeLimit) {
+        context.aborted = true; // 节点数上限逐节点检查，中止位置只取决于搜索顺序
+    }
+    else if ((context.nodes & kAbortCheckMask) == 0) {
+        if ((context.deadlineNs != 0 && PerfMonitor::nowNs() > context.deadlineNs) ||
+            (context.generation != 0 && _generation.load(std::memory_order_relaxed) != context.generation)) {
+            context.aborted = true;
+        }
+    }
+    if (context.aborted) {
+        return 0;
+    }
+    if (context.playfieldLeft == 0) {
+        return kWinScore + depth;
+    }
+
+    // 死局：牌堆已空且游戏区没有可匹配的卡牌，由计数查表得出，不必生成走法
+    const BoardSnapshot& snapshot = *context.snapshot;
+    const int8_t* faces = snapshot.getFaces().data();
+    const int8_t* suits = snapshot.getSuits().data();
+    if (context.stackLeft == 0 && (context.handTop < 0 ||
+        Rule::playableCount(snapshot.getRuleParams(), context.playfieldCounts, faces[context.handTop], suits[context.handTop]) == 0)) {
+        return kDeadEndScore;
+    }
+    if (depth == 0) {
+        return 0;
+    }
+
+    // 置换表：深度足够直接返回，否则只取最佳走法用于排序
+    TableEntry& entry = _table[context.key & (_table.size() - 1)];
+    int tableBest = -1;
+    if (entry.key == context.key) {
+        if (entry.depth >= depth) {
+            if (outBestSlot) {
+                *outBestSlot = entry.bestSlot;
+            }
+            return entry.value;
+        }
+        tableBest = entry.bestSlot;
+    }
+
+    // 走法生成：游戏区可匹配卡牌（向量化）+ 牌堆区卡牌（牌面、花色相同的只取一张）
+    std::vector<uint64_t>& mask = context.masks[context.ply];
+    std::vector<int>& moves = context.moves[context.ply];
+    moves.clear();
+    if (context.handTop >= 0) {
+        MatchQuery query = Rule::query(snapshot.getRuleParams(), faces[context.handTop], suits[context.handTop]);
+        MatchKernel::findPlayable(faces, suits, context.zones.data(), snapshot.size(), query, mask.data());
+        for (size_t w = 0; w < mask.size(); ++w) {
+            uint64_t bits = mask[w];
+            while (bits) {
+                moves.push_back(static_cast<int>(w) * 64 + lowestBit(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+    uint64_t seenStackCards = 0;
+    for (int slot : context.stackSlots) {
+        if (context.zones[slot] != kStackZone) {
+            continue;
+        }
+        uint64_t bit = 1ULL << ((faces[slot] * 4 + suits[slot]) & 63);
+        if (!(seenStackCards & bit)) {
+            seenStackCards |= bit;
+            moves.push_back(slot);
+        }
+    }
+    for (size_t i = 1; i < moves.size(); ++i) {
+        if (moves[i] == tableBest) {
+            std::swap(moves[0], moves[i]);
+            break;
+        }
+    }
+
+    int bestValue = kDeadEndScore;
+    int bestSlot = -1;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const int slot = moves[i];
+        const uint8_t fromZone = context.zones[slot];
+        const int prevTop = context.handTop;
+        const int gain = fromZone == kPlayfieldZone ? 1 : 0;
+
+        // 走子
+        context.zones[slot] = kHandZone;
+        context.key ^= _zobristRemoved[slot] ^ _zobristTop[slot] ^ (prevTop >= 0 ? _zobristTop[prevTop] : 0);
+        context.handTop = slot;
+        context.playfieldLeft -= gain;
+        if (gain) {
+            context.playfieldCounts.remove(faces[slot], suits[slot]);
+        }
+        else {
+            --context.stackLeft;
+        }
+        ++context.ply;
+
+        int value = gain + searchNode<Rule>(context, depth - 1, nullptr);
+
+        // 撤回
+        --context.ply;
+        if (gain) {
+            context.playfieldCounts.add(faces[slot], suits[slot]);
+        }
+        else {
+            ++context.stackLeft;
+        }
+        context.playfieldLeft += gain;
+        context.handTop = prevTop;
+        context.key ^= _zobristRemoved[slot] ^ _zobristTop[slot] ^ (prevTop >= 0 ? _zobristTop[prevTop] : 0);
+        context.zones[slot] = fromZone;
+
+        if (context.aborted) {
+            return 0;
+        }
+        if (value > bestValue) {
+            bestValue = value;
+            bestSlot = slot;
+        }
+    }
+
+    if (entry.key != context.key || entry.depth <= depth) {
+        entry.key = context.key;
+        entry.value = static_cast<int16_t>(bestValue);
+        entry.bestSlot = static_cast<int16_t>(bestSlot);
+        entry.depth = static_cast<uint8_t>(depth);
+    }
+    if (outBestSlot) {
+        *outBestSlot = bestSlot;
+    }
+    return bestValue;
+}
+
+void BoardSolver::publish(uint32_t generation, const HintMove& move) {
+    uint32_t low = static_cast<uint32_t>(move.cardId + 1) & 0x7fffff;
+    low |= (move.fromStack ? 1u : 0u) << 23;
+    low |= static_cast<uint32_t>(move.depth > 255 ? 255 : move.depth) << 24;
+    _bestMove.store((static_cast<uint64_t>(generation) << 32) | low, std::memory_order_release);
+}
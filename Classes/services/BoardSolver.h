@@ -0,0 +1,187 @@
+#ifndef BOARD_SOLVER_H_
+#define BOARD_SOLVER_H_
+
+#include "models/BoardSnapshot.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class EndgameTablebase;
+
+/**
+ * 提示走法
+ */
+struct HintMove {
+    int cardId = -1;        // 建议操作的卡牌ID，-1表示没有可用走法
+    bool fromStack = false; // true为翻开牌堆区卡牌，false为游戏区卡牌与手牌匹配
+    int depth = 0;          // 得出该走法时已完成的搜索深度
+
+    // 是否为有效走法
+    bool isValid() const { return cardId >= 0; }
+};
+
+/**
+ * 一次搜索的结果
+ */
+struct SolveResult {
+    HintMove best;          // 根节点最佳走法
+    int value = 0;          // 最佳走法的估值
+    bool solved = false;    // 在已完成的深度内找到了清空游戏区的走法序列
+    uint64_t nodes = 0;     // 搜索的节点数
+};
+
+/*
+后台提示服务：在工作线程上搜索当前棋盘的最佳走法，主线程无锁读取结果
+核心功能：
+1. 控制器在每次操作后提交不可变的棋盘快照（BoardSnapshot），工作线程在时间预算内迭代加深搜索；
+   离线工具改用节点数上限（solveNodes），结果可复现
+2. 置换表（Zobrist键、定长开放表）在同一关卡的连续快照之间保留，新局面通常是上一局面的子节点，可直接命中
+3. 每完成一层深度，把最佳走法连同代号打包写入一个64位原子量，主线程getHint读取时只接受当前代号的结果
+4. 代号计数：提交新快照或cancel时代号加一，工作线程每隔一批节点检查代号，发现过期立即放弃本次搜索
+5. 搜索按关卡规则变体（MatchRules.h）分派一次，走法生成使用对应策略特化的MatchKernel查询
+6. 搜索中增量维护游戏区牌面计数与牌堆剩余数，死局在进入节点时以O(1)判定并立即返回，不再生成走法
+7. 接入残局库时，局面在其收录范围内且已收录则一次查表得出结果，不再搜索
+搜索目标：尽快清空游戏区；死局（无牌可走且游戏区未清空）估值最低
+ */
+class BoardSolver {
+public:
+    static const int kDefaultBudgetMs = 200; // 默认每次提交的搜索时间预算（毫秒）
+    static const int kMaxDepth = 64;         // 迭代加深的最大深度
+    static const int kTableBits = 18;        // 置换表容量为2^kTableBits项（每项16字节）
+
+    /**
+     * 构造函数（不启动工作线程）
+     * @param budgetMs 每次提交的搜索时间预算（毫秒）
+     */
+    explicit BoardSolver(int budgetMs = kDefaultBudgetMs);
+
+    /**
+     * 析构函数：停止并等待工作线程退出
+     */
+    ~BoardSolver();
+
+    BoardSolver(const BoardSolver&) = delete;
+    BoardSolver& operator=(const BoardSolver&) = delete;
+
+    /**
+     * 启动工作线程（重复调用无副作用）
+     */
+    void start();
+
+    /**
+     * 停止工作线程，正在进行的搜索会在下一次检查时放弃
+     */
+    void stop();
+
+    /**
+     * 接入残局库（不持有，须在start之前调用，且比求解器后析构）
+     * @param tablebase 已打开的残局库，为nullptr时断开
+     */
+    void setTablebase(const EndgameTablebase* tablebase) { _tablebase = tablebase; }
+
+    /**
+     * 提交新的棋盘快照（主线程调用），取消正在进行的搜索并开始搜索新局面
+     * @param snapshot 棋盘快照
+     */
+    void submit(std::shared_ptr<const BoardSnapshot> snapshot);
+
+    /**
+     * 取消正在进行与尚未开始的搜索（玩家开始操作时调用），已发布的提示随之失效
+     */
+    void cancel();
+
+    /**
+     * 读取当前局面的提示（主线程调用，无锁）
+     * @param outMove 输出参数，接收最佳走法
+     * @return 当前局面已有搜索结果返回true
+     */
+    bool getHint(HintMove& outMove) const;
+
+    /**
+     * 在调用线程上同步搜索（供离线工具使用，不能与已启动的工作线程同时使用）
+     * @param snapshot 棋盘快照
+     * @param budgetMs 时间预算（毫秒），<=0表示不限时
+     * @param maxDepth 最大搜索深度
+     * @return 搜索结果
+     */
+    SolveResult solveNow(const BoardSnapshot& snapshot, int budgetMs, int maxDepth = kMaxDepth);
+
+    /**
+     * 在调用线程上按节点数上限同步搜索（供离线工具使用）：结果只取决于局面与此前的搜索序列，
+     * 与机器速度、并行线程数无关，同一输入每次得到相同结果
+     * @param snapshot 棋盘快照
+     * @param nodeLimit 节点数上限（>0）
+     * @param maxDepth 最大搜索深度
+     * @return 搜索结果
+     */
+    SolveResult solveNodes(const BoardSnapshot& snapshot, uint64_t nodeLimit, int maxDepth = kMaxDepth);
+
+private:
+    /**
+     * 置换表项
+     */
+    struct TableEntry {
+        uint64_t key;       // 局面Zobrist键（0表示空项）
+        int16_t value;      // 局面估值
+        int16_t bestSlot;   // 该局面的最佳走法槽位，-1表示没有
+        uint8_t depth;      // 估值对应的剩余搜索深度
+    };
+
+    struct SearchContext;
+    struct SearchVisitor;
+
+    // 工作线程主循环
+    void run();
+
+    /**
+     * 迭代加深搜索
+     * @param snapshot 棋盘快照
+     * @param deadlineNs 截止时间（PerfMonitor::nowNs），0表示不限时
+     * @param nodeLimit 节点数上限，0表示不限
+     * @param maxDepth 最大搜索深度
+     * @param generation 本次搜索的代号，0表示不检查代号（同步搜索）
+     * @return 搜索结果
+     */
+    SolveResult search(const BoardSnapshot& snapshot, uint64_t deadlineNs, uint64_t nodeLimit, int maxDepth,
+        uint32_t generation);
+
+    // 按规则策略特化的迭代加深搜索
+    template <class Rule>
+    SolveResult searchWith(SearchContext& context, int maxDepth, uint32_t generation);
+
+    // 按规则策略特化的深度优先搜索
+    template <class Rule>
+    int searchNode(SearchContext& context, int depth, int* outBestSlot);
+
+    // 换关时重建Zobrist键并清空置换表
+    void prepareTable(const BoardSnapshot& snapshot);
+
+    // 发布最佳走法（打包为 代号<<32 | 深度<<24 | 来自牌堆<<23 | 卡牌ID+1）
+    void publish(uint32_t generation, const HintMove& move);
+
+    // 查询残局库，局面已收录时填写结果并返回true
+    bool probeTablebase(const BoardSnapshot& snapshot, int maxDepth, SolveResult& outResult) const;
+
+    const int _budgetMs;                        // 每次提交的搜索时间预算
+    const EndgameTablebase* _tablebase;         // 残局库（不持有，可为nullptr）
+    std::vector<TableEntry> _table;             // 置换表（仅搜索线程访问）
+    std::vector<uint64_t> _zobristRemoved;      // 卡牌离开牌面（进入手牌区）的键
+    std::vector<uint64_t> _zobristTop;          // 卡牌位于手牌栈顶的键
+    uint64_t _tableLevelKey;                    // 置换表当前对应的关卡
+
+    std::atomic<uint32_t> _generation;          // 当前代号
+    std::atomic<uint64_t> _bestMove;            // 已发布的最佳走法（打包）
+
+    std::mutex _mutex;                          // 保护待搜索快照
+    std::condition_variable _wake;              // 唤醒工作线程
+    std::shared_ptr<const BoardSnapshot> _pending; // 待搜索快照
+    uint32_t _pendingGeneration;                // 待搜索快照的代号
+    bool _running;                              // 工作线程运行标记（受_mutex保护）
+    std::thread _worker;                        // 工作线程
+};
+
+#endif // BOARD_SOLVER_H_
@@ -5,22 +5,16 @@
 #include <unordered_map>
 
 /*
-卡牌管理器全局映射类，通过单例模式提供卡牌ID与管理器的快速关联
+卡牌管理器映射类，提供卡牌ID与管理器的快速关联
 核心功能：
 1. 维护卡牌ID到CardManager实例的映射关系
 2. 支持添加、查询、移除映射关系，提供O(1)平均时间复杂度的操作
-3. 作为全局访问点，便于控制器快速定位指定卡牌的管理器
+3. 每局对局一份，由对局上下文（GameContext）持有；多个棋盘的卡牌ID互不冲突，各自在所属线程访问无需加锁
  */
 class CardIdManagerMap {
 public:
-    /**
-     * 获取单例实例
-     * @return 全局唯一的CardIdManagerMap实例引用
-     */
-    static CardIdManagerMap& getInstance() {
-        static CardIdManagerMap instance;
-        return instance;
-    }
+    CardIdManagerMap() {}
+    ~CardIdManagerMap() {}
 
     /**
      * 添加卡牌ID与管理器的映射
@@ -53,11 +47,7 @@ public:
     }
 
 private:
-    // 私有构造与析构，确保单例模式
-    CardIdManagerMap() {}
-    ~CardIdManagerMap() {}
-
-    // 禁用拷贝构造与赋值，防止单例被复制
+    // 卡牌管理器持有指向映射的指针，禁用拷贝构造与赋值
     CardIdManagerMap(const CardIdManagerMap&) = delete;
     CardIdManagerMap& operator=(const CardIdManagerMap&) = delete;
 
@@ -0,0 +1,56 @@
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+CRC-32校验（IEEE 802.3多项式，与zlib一致）
+核心功能：
+1. 查表法逐字节计算，表在首次使用时生成（线程安全的局部静态初始化）
+2. 支持分段累加：compute(second, n, compute(first, m)) 等于对两段拼接后整体计算
+采用静态类设计，无需实例化
+ */
+class Crc32 {
+public:
+    /**
+     * 计算CRC-32
+     * @param data 数据
+     * @param size 字节数
+     * @param previous 前一段数据的CRC（分段计算时传入），首段为0
+     * @return CRC-32值
+     */
+    static uint32_t compute(const void* data, size_t size, uint32_t previous = 0) {
+        const uint32_t* table = getTable();
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint32_t crc = ~previous;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+private:
+    Crc32() = default;
+
+    struct Table {
+        uint32_t entries[256];
+
+        Table() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+                }
+                entries[i] = value;
+            }
+        }
+    };
+
+    static const uint32_t* getTable() {
+        static const Table table;
+        return table.entries;
+    }
+};
+
+#endif // CRC32_H_
@@ -0,0 +1,146 @@
+#include "services/DealEngine.h"
+#include "services/DealRandom.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include <cctype>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+    const char kLevelPrefix[] = "deal:";        // 种子发牌关卡名前缀
+    const size_t kLevelPrefixLength = sizeof(kLevelPrefix) - 1;
+    const int kDeckSize = 52;                   // 一副牌的张数
+    const int kFaceCount = 13;                  // 每种花色的牌面数
+
+    // 三峰模板：每行的起始x、行距与y（关卡文件坐标系，加载时再叠加游戏区偏移）
+    const float kColumnStep = 90.0f;
+    const float kRowY[4] = { 950.0f, 850.0f, 750.0f, 650.0f };
+    const float kPeakX[3] = { 270.0f, 540.0f, 810.0f };
+
+    DealTemplate buildTriPeaks() {
+        DealTemplate result;
+        // 从峰顶到底行，底行最后加入、层级最高，压住上方各行
+        for (float x : kPeakX) {
+            result.playfieldPositions.emplace_back(x, kRowY[0]);
+        }
+        for (float x : kPeakX) {
+            result.playfieldPositions.emplace_back(x - kColumnStep / 2, kRowY[1]);
+            result.playfieldPositions.emplace_back(x + kColumnStep / 2, kRowY[1]);
+        }
+        for (int i = 0; i < 9; ++i) {
+            result.playfieldPositions.emplace_back(kPeakX[0] - kColumnStep + kColumnStep * i, kRowY[2]);
+        }
+        for (int i = 0; i < 10; ++i) {
+            result.playfieldPositions.emplace_back(kPeakX[0] - kColumnStep * 1.5f + kColumnStep * i, kRowY[3]);
+        }
+        result.stackCount = kDeckSize - static_cast<int>(result.playfieldPositions.size());
+        return result;
+    }
+}
+
+const DealTemplate& DealEngine::triPeaksTemplate() {
+    static const DealTemplate triPeaks = buildTriPeaks();
+    return triPeaks;
+}
+
+bool DealEngine::templateFromLevel(const std::string& levelFile, DealTemplate& outTemplate) {
+    // 零偏移布局加载，得到关卡文件中的原始坐标
+    BoardLayout rawLayout;
+    rawLayout.playfieldOffset = cocos2d::Vec2::ZERO;
+    rawLayout.stackOffset = cocos2d::Vec2::ZERO;
+    LevelConfig* config = LevelConfigLoader::loadLevelConfig(levelFile, rawLayout);
+    if (!config) {
+        return false;
+    }
+
+    outTemplate.playfieldPositions.clear();
+    for (const auto& card : config->getPlayfield()) {
+        outTemplate.playfieldPositions.push_back(card.getPosition());
+    }
+    outTemplate.stackCount = static_cast<int>(config->getStack().size());
+    outTemplate.ruleParams = config->getRuleParams();
+    LevelConfigLoader::releaseLevelConfig(config);
+    return outTemplate.cardCount() > 0;
+}
+
+void DealEngine::shuffle(const DealTemplate& dealTemplate, uint64_t seed, std::vector<uint8_t>& outCards) {
+    // 按需要的张数准备整副牌，最后一副不足时也完整放入再洗，保证每张牌概率相同
+    const int cardCount = dealTemplate.cardCount();
+    const int deckCount = (cardCount + kDeckSize - 1) / kDeckSize;
+    outCards.resize(static_cast<size_t>(deckCount) * kDeckSize);
+    for (size_t i = 0; i < outCards.size(); ++i) {
+        outCards[i] = static_cast<uint8_t>(i % kDeckSize);
+    }
+
+    // Fisher–Yates：从后往前，每个位置与[0, i]内随机位置交换
+    DealRandom random(seed);
+    for (uint32_t i = static_cast<uint32_t>(outCards.size()); i > 1; --i) {
+        uint32_t j = random.nextBelow(i);
+        std::swap(outCards[i - 1], outCards[j]);
+    }
+    outCards.resize(cardCount);
+}
+
+GameModel DealEngine::deal(const DealTemplate& dealTemplate, uint64_t seed, const BoardLayout& layout) {
+    std::vector<uint8_t> cards;
+    shuffle(dealTemplate, seed, cards);
+
+    GameModel gameModel(nullptr);
+    gameModel.setRuleParams(dealTemplate.ruleParams);
+    const int playfieldCount = static_cast<int>(dealTemplate.playfieldPositions.size());
+    gameModel.reserveZones(playfieldCount, static_cast<int>(cards.size()) - playfieldCount);
+    for (int id = 0; id < static_cast<int>(cards.size()); ++id) {
+        CardFaceType face = static_cast<CardFaceType>(cards[id] % kFaceCount);
+        CardSuitType suit = static_cast<CardSuitType>(cards[id] / kFaceCount);
+        if (id < playfieldCount) {
+            cocos2d::Vec2 position = dealTemplate.playfieldPositions[id] + layout.offsetFor(CardZone::Playfield);
+            gameModel.addCard(CardModel(face, suit, position, id, CardZone::Playfield));
+        } else {
+            gameModel.addCard(CardModel(face, suit, layout.offsetFor(CardZone::Stack), id, CardZone::Stack));
+        }
+    }
+    return gameModel;
+}
+
+uint64_t DealEngine::dailySeed(int year, int month, int day) {
+    return static_cast<uint64_t>(year) * 10000 + month * 100 + day;
+}
+
+std::string DealEngine::levelName(uint64_t seed, const std::string& templateLevel) {
+    std::string name = kLevelPrefix + std::to_string(seed);
+    if (!templateLevel.empty()) {
+        name += ':';
+        name += templateLevel;
+    }
+    return name;
+}
+
+bool DealEngine::isDealLevel(const std::string& levelName) {
+    return levelName.compare(0, kLevelPrefixLength, kLevelPrefix) == 0;
+}
+
+bool DealEngine::dealLevel(const std::string& levelName, const BoardLayout& layout, GameModel& outModel) {
+    if (!isDealLevel(levelName)) {
+        return false;
+    }
+
+    // 解析种子（十进制），其后可跟":<模板关卡文件>"
+    const char* digits = levelName.c_str() + kLevelPrefixLength;
+    char* end = nullptr;
+    uint64_t seed = std::isdigit(static_cast<unsigned char>(*digits)) ? std::strtoull(digits, &end, 10) : 0;
+    if (end == nullptr || (*end != '\0' && *end != ':')) {
+        CCLOG("DealEngine: 无效的发牌关卡名%s", levelName.c_str());
+        return false;
+    }
+
+    if (*end == ':') {
+        DealTemplate levelTemplate;
+        if (!templateFromLevel(end + 1, levelTemplate)) {
+            CCLOG("DealEngine: 模板关卡%s加载失败", end + 1);
+            return false;
+        }
+        outModel = deal(levelTemplate, seed, layout);
+    } else {
+        outModel = deal(triPeaksTemplate(), seed, layout);
+    }
+    return true;
+}
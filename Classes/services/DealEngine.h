@@ -0,0 +1,110 @@
+#ifndef DEAL_ENGINE_H_
+#define DEAL_ENGINE_H_
+
+#include "cocos2d.h"
+#include "configs/models/BoardLayout.h"
+#include "models/GameModel.h"
+#include "models/MatchRules.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 发牌模板：只描述棋盘形状，不含牌面
+ */
+struct DealTemplate {
+    std::vector<cocos2d::Vec2> playfieldPositions;  // 游戏区卡牌的相对坐标（关卡文件坐标系，按层级从低到高）
+    int stackCount = 0;                             // 牌堆区卡牌数
+    RuleParams ruleParams;                          // 匹配规则
+
+    /**
+     * 模板需要的卡牌总数
+     * @return 游戏区与牌堆区卡牌数之和
+     */
+    int cardCount() const {
+        return static_cast<int>(playfieldPositions.size()) + stackCount;
+    }
+};
+
+/*
+种子发牌引擎：由发牌模板与64位种子生成对局，每日挑战与难度实验不再需要关卡文件
+核心功能：
+1. 按模板所需张数准备整副牌（超过52张时追加整副），用DealRandom做Fisher–Yates洗牌，
+   前若干张依次发到游戏区各位置，其余进入牌堆区
+2. 只使用整数运算，同一模板与种子在任何平台、编译器上得到完全相同的发牌
+3. 生成的GameModel与LevelConfigLoader加载关卡文件的结果同构：ID按 游戏区、牌堆区 顺序从0编号，坐标按棋盘布局偏移
+4. 关卡名"deal:<种子>"或"deal:<种子>:<模板关卡文件>"可代替关卡文件名使用（会话日志、统计库按此名记录），
+   每日挑战的种子由日期得出
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class DealEngine {
+public:
+    /**
+     * 内置的三峰模板：28张游戏区卡牌排成三座峰（3+6+9+10），24张牌堆，恰好一副牌
+     * @return 发牌模板
+     */
+    static const DealTemplate& triPeaksTemplate();
+
+    /**
+     * 以关卡文件的形状作为模板（忽略其中的牌面）
+     * @param levelFile 关卡配置文件路径
+     * @param outTemplate 输出参数，接收发牌模板
+     * @return 关卡文件加载成功返回true
+     */
+    static bool templateFromLevel(const std::string& levelFile, DealTemplate& outTemplate);
+
+    /**
+     * 按模板与种子洗牌，得到每个位置的牌（游戏区在前，牌堆区在后）
+     * @param dealTemplate 发牌模板
+     * @param seed 种子
+     * @param outCards 输出参数，接收cardCount个牌编码（牌面 = 编码 % 13，花色 = 编码 / 13）
+     */
+    static void shuffle(const DealTemplate& dealTemplate, uint64_t seed, std::vector<uint8_t>& outCards);
+
+    /**
+     * 按模板与种子发牌，生成游戏模型
+     * @param dealTemplate 发牌模板
+     * @param seed 种子
+     * @param layout 棋盘布局，应与随后创建视图时使用的对局上下文一致
+     * @return 生成的游戏模型
+     */
+    static GameModel deal(const DealTemplate& dealTemplate, uint64_t seed, const BoardLayout& layout = BoardLayout());
+
+    /**
+     * 由日期得出每日挑战的种子（YYYYMMDD）
+     * @param year 年
+     * @param month 月（1~12）
+     * @param day 日（1~31）
+     * @return 种子
+     */
+    static uint64_t dailySeed(int year, int month, int day);
+
+    /**
+     * 构造种子发牌的关卡名
+     * @param seed 种子
+     * @param templateLevel 模板关卡文件，为空时使用内置三峰模板
+     * @return 关卡名，如"deal:20240101"
+     */
+    static std::string levelName(uint64_t seed, const std::string& templateLevel = "");
+
+    /**
+     * 关卡名是否表示种子发牌
+     * @param levelName 关卡名或关卡文件名
+     * @return 以"deal:"开头返回true
+     */
+    static bool isDealLevel(const std::string& levelName);
+
+    /**
+     * 按种子发牌的关卡名生成游戏模型
+     * @param levelName 关卡名，格式见levelName
+     * @param layout 棋盘布局
+     * @param outModel 输出参数，接收生成的游戏模型
+     * @return 关卡名有效（且模板关卡加载成功）返回true
+     */
+    static bool dealLevel(const std::string& levelName, const BoardLayout& layout, GameModel& outModel);
+
+private:
+    DealEngine() = default;
+};
+
+#endif // DEAL_ENGINE_H_
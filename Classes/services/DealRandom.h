@@ -0,0 +1,73 @@
+#ifndef DEAL_RANDOM_H_
+#define DEAL_RANDOM_H_
+
+#include <cstdint>
+
+/*
+发牌用的可移植伪随机数发生器（xoshiro256**，状态由splitmix64从64位种子展开）
+核心功能：
+1. 只使用64位无符号整数的移位、乘法与异或，结果不依赖平台、编译器与标准库实现
+   （std::mt19937虽然序列固定，但uniform_int_distribution等分布的实现各家不同，不能用于跨平台复现）
+2. nextBelow用32位Lemire乘法加拒绝采样得到无偏的区间随机数，不使用取模与浮点
+3. 状态只有32字节，可按值拷贝，构造与每次取数都是常数时间
+ */
+class DealRandom {
+public:
+    /**
+     * 构造函数
+     * @param seed 64位种子，相同种子在任何平台上产生相同序列
+     */
+    explicit DealRandom(uint64_t seed) {
+        for (int i = 0; i < 4; ++i) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            _state[i] = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * 取下一个64位随机数
+     * @return 随机数
+     */
+    uint64_t next() {
+        const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+        return result;
+    }
+
+    /**
+     * 取[0, bound)内均匀分布的随机整数
+     * @param bound 上界（不含），须大于0
+     * @return 随机整数
+     */
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            // 拒绝落在不足一整轮的区间内的值，保证无偏
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t _state[4]; // 发生器状态
+};
+
+#endif // DEAL_RANDOM_H_
@@ -0,0 +1,154 @@
+#include "services/DifficultyEstimator.h"
+#include "models/BoardSnapshot.h"
+#include "services/DealRandom.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 分档上限（不含）：Easy < 25 <= Medium < 60 <= Hard < 90 <= Expert < 100 = Unsolved
+    const int kMediumScore = 25;
+    const int kHardScore = 60;
+    const int kExpertScore = 90;
+    const int kUnsolvedScore = 100;
+}
+
+/*
+供dispatchRuleVariant调用：按规则策略类型转调playRandom<Rule>
+ */
+struct DifficultyEstimator::RandomPlayVisitor {
+    const DifficultyEstimator& estimator;
+    const GameModel& model;
+    uint64_t seed;
+    DifficultyReport& report;
+
+    template <class Rule>
+    void operator()(Rule) const {
+        estimator.playRandom<Rule>(model, seed, report);
+    }
+};
+
+DifficultyEstimator::DifficultyEstimator(uint64_t nodeLimit, int playouts)
+    : _playouts(playouts) {
+    _autoPlayer.setNodeLimit(nodeLimit);
+}
+
+DifficultyReport DifficultyEstimator::estimate(const GameModel& model, uint64_t seed) {
+    DifficultyReport report;
+    playGuided(model, report);
+
+    std::shared_ptr<const BoardSnapshot> snapshot = BoardSnapshot::capture(model);
+    uint64_t playoutSeed = snapshot->getLevelKey() ^ seed;
+    dispatchRuleVariant(model.getRuleParams().variant, RandomPlayVisitor{*this, model, playoutSeed, report});
+
+    if (!report.solvable) {
+        report.score = kUnsolvedScore;
+    }
+    else {
+        int failurePercent = static_cast<int>(std::lround((1.0f - report.randomWinRate) * 100.0f));
+        report.score = std::min(kUnsolvedScore - 1, failurePercent);
+    }
+    return report;
+}
+
+const char* DifficultyEstimator::tierName(int score) {
+    if (score >= kUnsolvedScore) {
+        return "Unsolved";
+    }
+    if (score >= kExpertScore) {
+        return "Expert";
+    }
+    if (score >= kHardScore) {
+        return "Hard";
+    }
+    return score >= kMediumScore ? "Medium" : "Easy";
+}
+
+void DifficultyEstimator::playGuided(const GameModel& model, DifficultyReport& report) {
+    GameModel board = model;
+    const CardStore& cards = board.getCards();
+    GameCommand command;
+    // 每步都有一张卡牌进入手牌区，步数不会超过卡牌总数
+    for (int step = 0; step < cards.size() && _autoPlayer.chooseMove(board, command); ++step) {
+        const SolveResult& result = _autoPlayer.getLastResult();
+        report.nodes += result.nodes;
+
+        HintMove move;
+        move.cardId = command.cardId;
+        move.fromStack = command.type == GameCommandType::DrawStack;
+        move.depth = result.best.depth;
+        report.solution.push_back(move);
+
+        board.moveCard(command.cardId, CardZone::Hand);
+        board.getHand().push(command.cardId);
+    }
+    report.solvable = cards.getZoneMembers(CardZone::Playfield).empty();
+}
+
+template <class Rule>
+void DifficultyEstimator::playRandom(const GameModel& model, uint64_t seed, DifficultyReport& report) const {
+    const CardStore& cards = model.getCards();
+    const RuleParams& params = model.getRuleParams();
+    const int topSlot = cards.slotOf(model.getHand().top());
+    const std::vector<int>& initialPlayfield = cards.getZoneMembers(CardZone::Playfield);
+    const std::vector<int>& initialStack = cards.getZoneMembers(CardZone::Stack);
+
+    DealRandom random(seed);
+    std::vector<int> playfield;
+    std::vector<int> stack;
+    std::vector<int> playable;
+    std::vector<int> stackChoices;
+    int wins = 0;
+    uint64_t steps = 0;
+    uint64_t choices = 0;
+    for (int playout = 0; playout < _playouts; ++playout) {
+        playfield = initialPlayfield;
+        stack = initialStack;
+        int handSlot = topSlot;
+        while (!playfield.empty()) {
+            playable.clear();
+            if (handSlot >= 0) {
+                const int handFace = static_cast<int>(cards.getFace(handSlot));
+                const int handSuit = static_cast<int>(cards.getSuit(handSlot));
+                for (size_t i = 0; i < playfield.size(); ++i) {
+                    if (Rule::matches(params, static_cast<int>(cards.getFace(playfield[i])),
+                        static_cast<int>(cards.getSuit(playfield[i])), handFace, handSuit)) {
+                        playable.push_back(static_cast<int>(i));
+                    }
+                }
+            }
+            // 牌堆区卡牌可按任意顺序翻开（与游戏、求解器一致）：牌面与花色都相同的只算一种走法
+            stackChoices.clear();
+            uint64_t seenStackCards = 0;
+            for (size_t i = 0; i < stack.size(); ++i) {
+                const uint64_t bit = 1ULL << ((static_cast<int>(cards.getFace(stack[i])) * 4 +
+                    static_cast<int>(cards.getSuit(stack[i]))) & 63);
+                if (!(seenStackCards & bit)) {
+                    seenStackCards |= bit;
+                    stackChoices.push_back(static_cast<int>(i));
+                }
+            }
+
+            // 可选走法：每张可匹配的游戏区卡牌，外加每种不同的牌堆区卡牌（计入平均分支数）
+            if (playable.empty() && stackChoices.empty()) {
+                break;
+            }
+            ++steps;
+            choices += playable.size() + stackChoices.size();
+
+            // 随机玩家先在"打出某张可匹配卡牌"与"翻牌"之间均匀选择，翻牌时再均匀选一种牌堆区卡牌；
+            // 若把每种牌堆区卡牌都当作独立的一步，随机对局几乎总是在游戏区可走时去翻牌，清空率趋于0，难度分失去区分度
+            const uint32_t pick = random.nextBelow(static_cast<uint32_t>(playable.size()) + (stackChoices.empty() ? 0 : 1));
+            const bool draw = pick >= playable.size();
+            // 交换删除：游戏区与牌堆区的顺序都不影响后续走法
+            std::vector<int>& from = draw ? stack : playfield;
+            const int index = draw ? stackChoices[random.nextBelow(static_cast<uint32_t>(stackChoices.size()))] : playable[pick];
+            handSlot = from[index];
+            from[index] = from.back();
+            from.pop_back();
+        }
+        wins += playfield.empty() ? 1 : 0;
+    }
+
+    report.randomWinRate = _playouts > 0 ? static_cast<float>(wins) / _playouts : 0.0f;
+    report.averageChoices = steps > 0 ? static_cast<float>(choices) / steps : 0.0f;
+}
@@ -0,0 +1,84 @@
+#ifndef DIFFICULTY_ESTIMATOR_H_
+#define DIFFICULTY_ESTIMATOR_H_
+
+#include "models/GameModel.h"
+#include "services/AutoPlayer.h"
+#include "services/BoardSolver.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * 一个关卡的难度评估结果
+ */
+struct DifficultyReport {
+    bool solvable = false;          // 机器人引导的对局清空了游戏区（走法序列即一组解）
+    std::vector<HintMove> solution; // 引导对局的走法序列（solvable为false时为走到死局的序列）
+    uint64_t nodes = 0;             // 引导对局累计搜索的节点数
+    float randomWinRate = 0.0f;     // 随机走子清空游戏区的比例
+    float averageChoices = 0.0f;    // 随机对局中每步平均可选的走法数（牌面、花色相同的牌堆区卡牌算一种）
+    int score = 0;                  // 难度分（0~100，越高越难；未解出为100）
+};
+
+/*
+关卡难度估计：用机器人打一局证明可解，再用随机走子估计普通玩家的通关难度
+核心功能：
+1. 引导对局：复用AutoPlayer逐步选择走法（迭代加深搜索，可接入残局库），直接在GameModel副本上执行，
+   清空游戏区即证明关卡可解，走法序列作为参考解输出；每步按节点数上限而非时间预算搜索，
+   是否可解、参考解与难度分只取决于关卡，与机器速度、并行线程数无关
+2. 随机对局：走法与游戏一致（可匹配的游戏区卡牌，以及按任意顺序翻开的牌堆区卡牌）；每步先在各张可匹配卡牌与"翻牌"
+   之间均匀选择，翻牌时再均匀选一种牌堆区卡牌，统计清空率与平均分支数（全部不同走法数）；
+   随机数由DealRandom按关卡标识与种子生成，同一关卡在任何平台上结果相同
+3. 难度分：引导对局未清空游戏区为100，否则由随机对局的失败率换算（0~99），并给出分档名称
+每个实例持有独立的机器人与求解器，不共享状态；多线程批量评估时每个线程使用各自的实例
+ */
+class DifficultyEstimator {
+public:
+    static const uint64_t kDefaultNodeLimit = 50000; // 引导对局每步的搜索节点数上限（桌面机约1~2毫秒）
+    static const int kDefaultPlayouts = 64; // 默认的随机对局局数
+
+    /**
+     * 构造函数
+     * @param nodeLimit 引导对局每步的搜索节点数上限
+     * @param playouts 随机对局局数
+     */
+    explicit DifficultyEstimator(uint64_t nodeLimit = kDefaultNodeLimit, int playouts = kDefaultPlayouts);
+
+    DifficultyEstimator(const DifficultyEstimator&) = delete;
+    DifficultyEstimator& operator=(const DifficultyEstimator&) = delete;
+
+    /**
+     * 接入残局库（不持有，须比评估器后析构）
+     * @param tablebase 已打开的残局库，为nullptr时断开
+     */
+    void setTablebase(const EndgameTablebase* tablebase) { _autoPlayer.setTablebase(tablebase); }
+
+    /**
+     * 评估关卡初始棋盘的难度
+     * @param model 关卡初始棋盘（不修改）
+     * @param seed 随机对局的种子（与关卡标识混合）
+     * @return 评估结果
+     */
+    DifficultyReport estimate(const GameModel& model, uint64_t seed = 0);
+
+    /**
+     * 获取难度分对应的分档名称
+     * @param score 难度分
+     * @return "Easy"、"Medium"、"Hard"、"Expert"或"Unsolved"（引导对局未能清空游戏区）
+     */
+    static const char* tierName(int score);
+
+private:
+    // 机器人引导的对局，填写solvable、solution与nodes
+    void playGuided(const GameModel& model, DifficultyReport& report);
+
+    // 随机对局，填写randomWinRate与averageChoices
+    template <class Rule>
+    void playRandom(const GameModel& model, uint64_t seed, DifficultyReport& report) const;
+
+    struct RandomPlayVisitor;
+
+    AutoPlayer _autoPlayer;     // 引导对局的机器人
+    const int _playouts;        // 随机对局局数
+};
+
+#endif // DIFFICULTY_ESTIMATOR_H_
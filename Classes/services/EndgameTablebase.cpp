@@ -0,0 +1,448 @@
+#include "services/EndgameTablebase.h"
+#include "services/GameLog.h"
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const int kFaceKinds = static_cast<int>(CardFaceType::CFT_NUM_CARD_FACE_TYPES); // 牌面种数
+    const int kHandKinds = kFaceKinds + 1;  // 手牌栈顶：各牌面，末位表示手牌区为空
+    const size_t kHeaderSize = 16;          // 表头字节数
+    const size_t kSectionSize = 16;         // 节表每项字节数
+    const size_t kEntrySize = 2;            // 表项字节数
+
+    // 表项：bit15 能否获胜 | bit8~11 最快步数 | bit7 有最佳走法 | bit6 走法为翻开牌堆 | bit0~3 走法牌面
+    const uint16_t kWinBit = 0x8000;
+    const int kPliesShift = 8;
+    const uint16_t kHasMoveBit = 0x0080;
+    const uint16_t kFromStackBit = 0x0040;
+    const uint16_t kFaceMask = 0x000F;
+    const uint16_t kUnsolved = 0xFFFF;      // 生成过程中尚未求解
+
+    const uint8_t kPlayfieldZone = static_cast<uint8_t>(CardZone::Playfield);
+    const uint8_t kStackZone = static_cast<uint8_t>(CardZone::Stack);
+
+    /**
+     * 组合数表与多重集合排名：大小为k的有序多重集合a[0..k-1]对应组合b[i] = a[i] + i，
+     * 按组合数体系排名为 Σ C(b[i], i + 1)，再加上更小集合的总数，得到所有不超过上限大小的集合中的唯一序号
+     */
+    struct MultisetRanker {
+        uint32_t binomial[kFaceKinds + EndgameTablebase::kMaxPlayfield + 1][EndgameTablebase::kMaxPlayfield + 2];
+        uint32_t playfieldOffset[EndgameTablebase::kMaxPlayfield + 2]; // 小于k张的游戏区集合总数
+        uint32_t stackOffset[EndgameTablebase::kMaxStack + 2];         // 小于k张的牌堆集合总数
+
+        MultisetRanker() {
+            const int rows = kFaceKinds + EndgameTablebase::kMaxPlayfield + 1;
+            const int columns = EndgameTablebase::kMaxPlayfield + 2;
+            for (int n = 0; n < rows; ++n) {
+                for (int k = 0; k < columns; ++k) {
+                    binomial[n][k] = k == 0 ? 1 : (n == 0 ? 0 : binomial[n - 1][k - 1] + binomial[n - 1][k]);
+                }
+            }
+            playfieldOffset[0] = 0;
+            for (int k = 0; k <= EndgameTablebase::kMaxPlayfield; ++k) {
+                playfieldOffset[k + 1] = playfieldOffset[k] + binomial[kFaceKinds + k - 1][k];
+            }
+            stackOffset[0] = 0;
+            for (int k = 0; k <= EndgameTablebase::kMaxStack; ++k) {
+                stackOffset[k + 1] = stackOffset[k] + binomial[kFaceKinds + k - 1][k];
+            }
+        }
+
+        uint32_t rank(const uint8_t* sorted, int count) const {
+            uint32_t result = 0;
+            for (int i = 0; i < count; ++i) {
+                result += binomial[sorted[i] + i][i + 1];
+            }
+            return result;
+        }
+
+        uint32_t playfieldTotal() const { return playfieldOffset[EndgameTablebase::kMaxPlayfield + 1]; }
+        uint32_t stackTotal() const { return stackOffset[EndgameTablebase::kMaxStack + 1]; }
+        uint32_t entryCount() const { return playfieldTotal() * stackTotal() * kHandKinds; }
+    };
+
+    const MultisetRanker& getRanker() {
+        static const MultisetRanker ranker;
+        return ranker;
+    }
+
+    /**
+     * 抽象残局：两区牌面各自升序排列
+     */
+    struct Board {
+        uint8_t playfield[EndgameTablebase::kMaxPlayfield];
+        int playfieldCount = 0;
+        uint8_t stack[EndgameTablebase::kMaxStack];
+        int stackCount = 0;
+        int hand = kFaceKinds;  // 手牌栈顶牌面，kFaceKinds表示手牌区为空
+    };
+
+    // 局面在节内的下标
+    uint32_t indexOf(const Board& board) {
+        const MultisetRanker& ranker = getRanker();
+        const uint32_t playfieldRank = ranker.playfieldOffset[board.playfieldCount] + ranker.rank(board.playfield, board.playfieldCount);
+        const uint32_t stackRank = ranker.stackOffset[board.stackCount] + ranker.rank(board.stack, board.stackCount);
+        return (playfieldRank * ranker.stackTotal() + stackRank) * kHandKinds + static_cast<uint32_t>(board.hand);
+    }
+
+    // 规则参数归一化：同花色加分只影响得分不影响能否匹配，与默认变体共用一节；万能牌面只对万能牌变体有意义
+    RuleParams normalize(const RuleParams& params) {
+        RuleParams result = params;
+        if (result.variant == RuleVariant::SameSuitBonus) {
+            result.variant = RuleVariant::Adjacent;
+        }
+        if (result.variant != RuleVariant::Wildcard) {
+            result.wildFace = -1;
+        }
+        return result;
+    }
+
+    bool sameRules(const RuleParams& a, const RuleParams& b) {
+        return a.variant == b.variant && a.wildFace == b.wildFace;
+    }
+
+    // 供dispatchRuleVariant调用：按规则策略类型判断牌面能否匹配
+    struct FaceMatcher {
+        const RuleParams& params;
+        int face;
+        int handFace;
+        int suit;
+
+        template <class Rule>
+        bool operator()(Rule) const {
+            return Rule::matches(params, face, suit, handFace, suit);
+        }
+    };
+
+    // 牌面能否与手牌栈顶匹配（花色不影响受支持的变体，以梅花代入）
+    bool faceMatches(const RuleParams& params, int face, int handFace) {
+        const int suit = static_cast<int>(CardSuitType::CST_CLUBS);
+        return dispatchRuleVariant(params.variant, FaceMatcher{params, face, handFace, suit});
+    }
+
+    /**
+     * 生成时的穷举求解器：按下标记忆化，每个局面只求解一次
+     */
+    struct Solver {
+        RuleParams params;
+        std::vector<uint16_t>& table;
+
+        Solver(const RuleParams& rules, std::vector<uint16_t>& entries) : params(rules), table(entries) {}
+
+        uint16_t solve(const Board& board) {
+            uint16_t& entry = table[indexOf(board)];
+            if (entry != kUnsolved) {
+                return entry;
+            }
+            if (board.playfieldCount == 0) {
+                entry = kWinBit;
+                return entry;
+            }
+
+            int bestPlies = -1;
+            uint16_t bestMove = 0;
+            for (int i = 0; board.hand < kFaceKinds && i < board.playfieldCount; ++i) {
+                if ((i > 0 && board.playfield[i] == board.playfield[i - 1]) ||
+                    !faceMatches(params, board.playfield[i], board.hand)) {
+                    continue;
+                }
+                Board child = board;
+                child.hand = board.playfield[i];
+                std::copy(board.playfield + i + 1, board.playfield + board.playfieldCount, child.playfield + i);
+                --child.playfieldCount;
+                consider(solve(child), kHasMoveBit | board.playfield[i], bestPlies, bestMove);
+            }
+            for (int i = 0; i < board.stackCount; ++i) {
+                if (i > 0 && board.stack[i] == board.stack[i - 1]) {
+                    continue;
+                }
+                Board child = board;
+                child.hand = board.stack[i];
+                std::copy(board.stack + i + 1, board.stack + board.stackCount, child.stack + i);
+                --child.stackCount;
+                consider(solve(child), kHasMoveBit | kFromStackBit | board.stack[i], bestPlies, bestMove);
+            }
+            entry = bestPlies >= 0 ? static_cast<uint16_t>(kWinBit | (bestPlies << kPliesShift) | bestMove) : 0;
+            return entry;
+        }
+
+        static void consider(uint16_t child, uint16_t move, int& bestPlies, uint16_t& bestMove) {
+            if (!(child & kWinBit)) {
+                return;
+            }
+            const int plies = ((child >> kPliesShift) & 0xF) + 1;
+            if (bestPlies < 0 || plies < bestPlies) {
+                bestPlies = plies;
+                bestMove = move;
+            }
+        }
+
+        // 枚举全部不超过上限大小的有序多重集合
+        static void enumerate(int maxCount, std::vector<std::vector<uint8_t>>& out) {
+            std::vector<uint8_t> current;
+            out.push_back(current);
+            extend(current, 0, maxCount, out);
+        }
+
+        static void extend(std::vector<uint8_t>& current, int minFace, int maxCount, std::vector<std::vector<uint8_t>>& out) {
+            if (static_cast<int>(current.size()) == maxCount) {
+                return;
+            }
+            for (int face = minFace; face < kFaceKinds; ++face) {
+                current.push_back(static_cast<uint8_t>(face));
+                out.push_back(current);
+                extend(current, face, maxCount, out);
+                current.pop_back();
+            }
+        }
+    };
+
+    void writeU32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    uint32_t readU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+            (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+}
+
+EndgameTablebase::EndgameTablebase()
+    : _sectionCount(0), _mapping(nullptr), _mappingSize(0) {
+}
+
+EndgameTablebase::~EndgameTablebase() {
+    close();
+}
+
+bool EndgameTablebase::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    std::wstring widePath(MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], static_cast<int>(widePath.size()));
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ?
+            CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping) {
+            _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            _mappingSize = static_cast<size_t>(fileSize.QuadPart);
+            CloseHandle(mapping); // 视图保持映射有效
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                _mapping = mapped;
+                _mappingSize = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    if (!_mapping) {
+        GLOG_WARN(u8"残局库打开失败 - 路径：%s", path.c_str());
+        return false;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(_mapping);
+    const size_t size = _mappingSize;
+
+    // 表头：魔数、版本、节数、收录上限（游戏区 | 牌堆<<8）
+    const uint32_t sectionCount = size >= kHeaderSize ? readU32(data + 8) : 0;
+    const uint32_t limits = static_cast<uint32_t>(kMaxPlayfield) | (static_cast<uint32_t>(kMaxStack) << 8);
+    if (size < kHeaderSize || readU32(data) != kMagic || readU32(data + 4) != kVersion || readU32(data + 12) != limits ||
+        sectionCount == 0 || sectionCount > static_cast<uint32_t>(kMaxSections) || size < kHeaderSize + sectionCount * kSectionSize) {
+        GLOG_WARN(u8"残局库表头无效 - 路径：%s，大小：%d", path.c_str(), static_cast<int>(size));
+        close();
+        return false;
+    }
+
+    // 节表：变体、万能牌面、表项数、数据偏移
+    const uint32_t expectedEntries = getRanker().entryCount();
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        const uint8_t* record = data + kHeaderSize + i * kSectionSize;
+        const uint32_t entryCount = readU32(record + 4);
+        const uint64_t offset = readU32(record + 8) | (static_cast<uint64_t>(readU32(record + 12)) << 32);
+        Section& section = _sections[i];
+        section.params.variant = static_cast<RuleVariant>(record[0]);
+        section.params.wildFace = static_cast<int8_t>(record[1]);
+        if (record[0] >= static_cast<uint8_t>(RuleVariant::Count) || !supportsRules(section.params) ||
+            entryCount != expectedEntries || offset > size || size - offset < static_cast<uint64_t>(entryCount) * kEntrySize) {
+            GLOG_WARN(u8"残局库节表无效 - 路径：%s，节：%u", path.c_str(), i);
+            close();
+            return false;
+        }
+        section.entries = data + offset;
+        section.entryCount = entryCount;
+    }
+    _sectionCount = static_cast<int>(sectionCount);
+    GLOG_INFO(u8"残局库已打开 - 规则数：%d，字节数：%d", _sectionCount, static_cast<int>(size));
+    return true;
+}
+
+void EndgameTablebase::close() {
+    if (_mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(_mapping);
+#else
+        munmap(_mapping, _mappingSize);
+#endif
+    }
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _sectionCount = 0;
+}
+
+bool EndgameTablebase::supportsRules(const RuleParams& params) {
+    return params.variant != RuleVariant::SameColor && params.variant < RuleVariant::Count;
+}
+
+const EndgameTablebase::Section* EndgameTablebase::findSection(const RuleParams& params) const {
+    const RuleParams normalized = normalize(params);
+    for (int i = 0; i < _sectionCount; ++i) {
+        if (sameRules(_sections[i].params, normalized)) {
+            return &_sections[i];
+        }
+    }
+    return nullptr;
+}
+
+bool EndgameTablebase::probe(const BoardSnapshot& snapshot, TablebaseProbe& outProbe) const {
+    const Section* section = _sectionCount > 0 ? findSection(snapshot.getRuleParams()) : nullptr;
+    if (!section) {
+        return false;
+    }
+
+    const int8_t* faces = snapshot.getFaces().data();
+    const uint8_t* zones = snapshot.getZones().data();
+    Board board;
+    for (int slot = 0; slot < snapshot.size(); ++slot) {
+        if (zones[slot] == kPlayfieldZone) {
+            if (board.playfieldCount == kMaxPlayfield) {
+                return false;
+            }
+            board.playfield[board.playfieldCount++] = static_cast<uint8_t>(faces[slot]);
+        }
+        else if (zones[slot] == kStackZone) {
+            if (board.stackCount == kMaxStack) {
+                return false;
+            }
+            board.stack[board.stackCount++] = static_cast<uint8_t>(faces[slot]);
+        }
+    }
+    const int handSlot = snapshot.getHandTopSlot();
+    board.hand = handSlot >= 0 ? faces[handSlot] : kFaceKinds;
+    std::sort(board.playfield, board.playfield + board.playfieldCount);
+    std::sort(board.stack, board.stack + board.stackCount);
+
+    const uint8_t* bytes = section->entries + static_cast<size_t>(indexOf(board)) * kEntrySize;
+    const uint16_t entry = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    outProbe.win = (entry & kWinBit) != 0;
+    outProbe.pliesToWin = outProbe.win ? (entry >> kPliesShift) & 0xF : 0;
+    outProbe.move = HintMove();
+    if (!(entry & kHasMoveBit)) {
+        return true;
+    }
+
+    // 把走法牌面映射回快照中所在区域相同、牌面相同的任意一张卡牌
+    const uint8_t zone = (entry & kFromStackBit) ? kStackZone : kPlayfieldZone;
+    const int face = entry & kFaceMask;
+    for (int slot = 0; slot < snapshot.size(); ++slot) {
+        if (zones[slot] == zone && faces[slot] == face) {
+            outProbe.move.cardId = snapshot.getId(slot);
+            outProbe.move.fromStack = zone == kStackZone;
+            outProbe.move.depth = outProbe.pliesToWin;
+            break;
+        }
+    }
+    return true;
+}
+
+bool EndgameTablebase::generate(const std::vector<RuleParams>& rules, const std::string& outPath) {
+    std::vector<RuleParams> sections;
+    for (const RuleParams& params : rules) {
+        const RuleParams normalized = normalize(params);
+        const bool duplicate = std::any_of(sections.begin(), sections.end(),
+            [&](const RuleParams& existing) { return sameRules(existing, normalized); });
+        if (supportsRules(normalized) && !duplicate && static_cast<int>(sections.size()) < kMaxSections) {
+            sections.push_back(normalized);
+        }
+    }
+    if (sections.empty()) {
+        GLOG_ERROR(u8"残局库生成失败 - 没有可收录的规则");
+        return false;
+    }
+
+    std::vector<std::vector<uint8_t>> playfieldSets;
+    std::vector<std::vector<uint8_t>> stackSets;
+    Solver::enumerate(kMaxPlayfield, playfieldSets);
+    Solver::enumerate(kMaxStack, stackSets);
+
+    const uint32_t entryCount = getRanker().entryCount();
+    const size_t dataOffset = kHeaderSize + sections.size() * kSectionSize;
+    std::vector<uint8_t> data(dataOffset + sections.size() * entryCount * kEntrySize, 0);
+    writeU32(&data[0], kMagic);
+    writeU32(&data[4], kVersion);
+    writeU32(&data[8], static_cast<uint32_t>(sections.size()));
+    writeU32(&data[12], static_cast<uint32_t>(kMaxPlayfield) | (static_cast<uint32_t>(kMaxStack) << 8));
+
+    std::vector<uint16_t> table;
+    for (size_t s = 0; s < sections.size(); ++s) {
+        table.assign(entryCount, kUnsolved);
+        Solver solver(sections[s], table);
+        for (const auto& playfield : playfieldSets) {
+            for (const auto& stack : stackSets) {
+                Board board;
+                board.playfieldCount = static_cast<int>(playfield.size());
+                board.stackCount = static_cast<int>(stack.size());
+                std::copy(playfield.begin(), playfield.end(), board.playfield);
+                std::copy(stack.begin(), stack.end(), board.stack);
+                for (board.hand = 0; board.hand < kHandKinds; ++board.hand) {
+                    solver.solve(board);
+                }
+            }
+        }
+
+        const size_t offset = dataOffset + s * entryCount * kEntrySize;
+        uint8_t* record = &data[kHeaderSize + s * kSectionSize];
+        record[0] = static_cast<uint8_t>(sections[s].variant);
+        record[1] = static_cast<uint8_t>(sections[s].wildFace);
+        writeU32(record + 4, entryCount);
+        writeU32(record + 8, static_cast<uint32_t>(offset));
+        writeU32(record + 12, static_cast<uint32_t>(static_cast<uint64_t>(offset) >> 32));
+        for (uint32_t i = 0; i < entryCount; ++i) {
+            data[offset + i * kEntrySize] = static_cast<uint8_t>(table[i]);
+            data[offset + i * kEntrySize + 1] = static_cast<uint8_t>(table[i] >> 8);
+        }
+    }
+
+    std::FILE* file = std::fopen(outPath.c_str(), "wb");
+    if (!file) {
+        GLOG_ERROR(u8"残局库写入失败 - 路径：%s", outPath.c_str());
+        return false;
+    }
+    const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    const bool closed = std::fclose(file) == 0;
+    GLOG_INFO(u8"残局库已生成 - 规则数：%d，每种规则局面数：%u，文件大小：%u字节",
+        static_cast<int>(sections.size()), entryCount, static_cast<uint32_t>(data.size()));
+    return written && closed;
+}
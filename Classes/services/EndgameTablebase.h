@@ -0,0 +1,113 @@
+#ifndef ENDGAME_TABLEBASE_H_
+#define ENDGAME_TABLEBASE_H_
+
+#include "models/BoardSnapshot.h"
+#include "models/MatchRules.h"
+#include "services/BoardSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 残局库的查询结果
+ */
+struct TablebaseProbe {
+    bool win = false;       // 能否清空游戏区
+    int pliesToWin = 0;     // 最快清空游戏区需要的步数（win为false时无意义）
+    HintMove move;          // 最佳走法（已映射到快照中的具体卡牌；必输局面为无效走法）
+};
+
+/*
+残局库：离线生成、内存映射的小局面胜负表，一次查表回答"能否获胜、最快几步、下一步走哪张"
+只供离线工具（level_pipeline的难度估计与提示表生成）使用，不随游戏发布；游戏内的提示与自动对局对这些小残局直接搜索
+核心功能：
+1. 规范编码：局面抽象为（规则参数、手牌栈顶牌面、游戏区剩余牌面的多重集合、牌堆剩余牌面的多重集合），
+   与卡牌ID、坐标、花色、所属关卡无关；多重集合按组合数体系排名，整个局面对应表中唯一的下标，
+   不同关卡走到相同残局共用一项。本作牌堆区的卡牌可按任意顺序翻开，因此牌堆以多重集合而非前缀参与编码
+2. 穷举收录游戏区不超过kMaxPlayfield张、牌堆不超过kMaxStack张的全部局面（命中率100%），
+   每项2字节（胜负、最快步数、最佳走法的牌面与来源），每种规则参数一节，约7MB
+3. 只收录匹配只看牌面的规则变体（同色变体的牌类多一倍，穷举规模过大，由求解器照常搜索）；
+   同花色加分变体只影响得分，与默认变体共用一节
+4. 以只读内存映射打开，不解析、不拷贝，只有被查询的页才读入内存
+打开后只读，可被流水线的多个工作线程同时查询
+ */
+class EndgameTablebase {
+public:
+    static const int kMaxPlayfield = 4;         // 收录局面的游戏区卡牌数上限
+    static const int kMaxStack = 2;             // 收录局面的牌堆区卡牌数上限
+    static const uint32_t kMagic = 0x42544743;  // 文件魔数（小端"CGTB"）
+    static const uint32_t kVersion = 1;         // 格式版本
+    static const int kMaxSections = 16;         // 最多收录的规则参数种数
+
+    EndgameTablebase();
+
+    /**
+     * 析构函数：解除映射
+     */
+    ~EndgameTablebase();
+
+    EndgameTablebase(const EndgameTablebase&) = delete;
+    EndgameTablebase& operator=(const EndgameTablebase&) = delete;
+
+    /**
+     * 打开残局库文件
+     * @param path 文件完整路径
+     * @return 表头、节表与长度有效返回true
+     */
+    bool open(const std::string& path);
+
+    /**
+     * 关闭残局库（解除映射）
+     */
+    void close();
+
+    /**
+     * 是否已打开
+     * @return 已打开返回true
+     */
+    bool isOpen() const { return _sectionCount > 0; }
+
+    /**
+     * 规则参数是否可被残局库收录（匹配只看牌面的变体）
+     * @param params 规则参数
+     * @return 可收录返回true
+     */
+    static bool supportsRules(const RuleParams& params);
+
+    /**
+     * 查询快照对应的局面（线程安全，O(卡牌数)的一次扫描加一次查表）
+     * @param snapshot 棋盘快照
+     * @param outProbe 输出参数，接收查询结果
+     * @return 局面在收录范围内且本库含对应规则返回true
+     */
+    bool probe(const BoardSnapshot& snapshot, TablebaseProbe& outProbe) const;
+
+    /**
+     * 离线生成残局库文件：对每种规则参数穷举求解全部收录范围内的局面
+     * @param rules 要收录的规则参数（不支持的变体与重复项被跳过）
+     * @param outPath 输出文件完整路径
+     * @return 写入成功返回true
+     */
+    static bool generate(const std::vector<RuleParams>& rules, const std::string& outPath);
+
+private:
+    /**
+     * 一种规则参数的表
+     */
+    struct Section {
+        RuleParams params;          // 规则参数
+        const uint8_t* entries;     // 表项数组（每项2字节，小端）
+        uint32_t entryCount;        // 表项数
+    };
+
+    // 查找规则参数对应的节，没有时返回nullptr
+    const Section* findSection(const RuleParams& params) const;
+
+    Section _sections[kMaxSections];    // 节表
+    int _sectionCount;                  // 节数
+    void* _mapping;                     // 映射区域起始地址，未映射时为nullptr
+    size_t _mappingSize;                // 映射区域字节数
+};
+
+#endif // ENDGAME_TABLEBASE_H_
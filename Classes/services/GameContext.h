@@ -0,0 +1,44 @@
+#ifndef GAME_CONTEXT_H_
+#define GAME_CONTEXT_H_
+
+#include "configs/models/BoardLayout.h"
+#include "services/CardIdManagerMap.h"
+#include "services/GameEventBus.h"
+
+/*
+对局上下文：一局游戏的全部可变共享状态，取代原先的全局单例与写死的屏幕坐标
+核心功能：
+1. 持有本局的卡牌管理器映射（CardIdManagerMap）与事件总线（GameEventBus）
+2. 持有棋盘布局（BoardLayout），关卡加载与控制器移动卡牌都从这里取坐标
+3. 每个棋盘一份上下文，同一进程可以在N个线程上各跑一局（自动对局、批量校验、分屏），互不加锁；
+   上下文只能在所属线程访问
+由宿主（场景或模拟器）以shared_ptr创建，GameView共享持有，保证比视图内的控制器与卡牌管理器后析构
+ */
+class GameContext {
+public:
+    /**
+     * 构造函数
+     * @param layout 棋盘布局，缺省为单棋盘的默认坐标
+     */
+    explicit GameContext(const BoardLayout& layout = BoardLayout()) : _layout(layout) {}
+
+    // 卡牌管理器与订阅者持有指向上下文成员的指针，禁止拷贝
+    GameContext(const GameContext&) = delete;
+    GameContext& operator=(const GameContext&) = delete;
+
+    // 获取本局的卡牌管理器映射
+    CardIdManagerMap& getCardManagers() { return _cardManagers; }
+
+    // 获取本局的事件总线
+    GameEventBus& getEventBus() { return _eventBus; }
+
+    // 获取棋盘布局
+    const BoardLayout& getLayout() const { return _layout; }
+
+private:
+    BoardLayout _layout;              // 棋盘布局
+    GameEventBus _eventBus;           // 事件总线
+    CardIdManagerMap _cardManagers;   // 卡牌管理器映射
+};
+
+#endif // GAME_CONTEXT_H_
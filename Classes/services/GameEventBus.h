@@ -0,0 +1,235 @@
+#ifndef GAME_EVENT_BUS_H_
+#define GAME_EVENT_BUS_H_
+
+#include "models/CardModel.h"
+#include "models/GameCommand.h"
+#include "services/GameLog.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// 每种事件类型的最大订阅者数
+const int kGameEventMaxSubscribers = 8;
+
+/**
+ * 卡牌被点击（由CardManager在触摸结束且落点仍在卡牌内时发布）
+ */
+struct CardClickedEvent {
+    int cardId;             // 被点击卡牌ID
+};
+
+/**
+ * 卡牌被移动到手牌区（由控制器在匹配成功或翻开牌堆牌后发布）
+ */
+struct CardMovedEvent {
+    int cardId;             // 卡牌ID
+    CardZone fromZone;      // 移动前所在区域
+    CardZone toZone;        // 移动后所在区域
+    cocos2d::Vec2 position; // 目标位置
+    int zOrder;             // 目标层级
+};
+
+/**
+ * 卡牌被撤销回原区域（由控制器在撤销成功后发布）
+ */
+struct CardUndoneEvent {
+    int cardId;             // 卡牌ID
+    CardZone toZone;        // 恢复后的区域
+    cocos2d::Vec2 position; // 恢复后的位置
+};
+
+/**
+ * 关卡完成：游戏区卡牌已全部移走
+ */
+struct LevelClearedEvent {
+    int moveCount;          // 本局累计移动次数
+};
+
+/**
+ * 死局：游戏区没有可匹配的卡牌且牌堆已空
+ */
+struct NoMovesLeftEvent {
+    int remainingCards;     // 游戏区剩余卡牌数
+};
+
+/**
+ * 单张卡牌的目标状态（状态差异中的一项）
+ */
+struct CardStateChange {
+    int cardId;             // 卡牌ID
+    CardZone zone;          // 目标区域
+    cocos2d::Vec2 position; // 目标位置
+    int zOrder;             // 目标层级
+};
+
+/**
+ * 一帧指令批处理后的合并状态差异：同一张卡牌在一批内多次变化只保留最终状态
+ * changes指向控制器内部缓冲区，仅在派发期间有效
+ */
+struct BoardDiffEvent {
+    const CardStateChange* changes; // 变化的卡牌
+    int count;                      // 变化数量
+};
+
+/**
+ * 指令执行结果（所有玩家操作的统一出口，供回放、统计订阅）
+ */
+struct CommandAppliedEvent {
+    GameCommand command;    // 被执行的指令
+    bool accepted;          // 通过校验并生效返回true，被规则拒绝为false
+};
+
+/**
+ * 小缓冲区委托：把可调用对象原地存放在固定大小的缓冲区中，构造、拷贝、调用都不分配堆内存
+ * 可调用对象必须可平凡拷贝且不超过kStorageSize（捕获this和少量指针/整数的lambda均满足）
+ */
+template <typename Event>
+class GameEventDelegate {
+public:
+    static const size_t kStorageSize = 3 * sizeof(void*); // 原地存储区大小
+
+    GameEventDelegate() : _invoke(nullptr) {}
+
+    template <typename F>
+    GameEventDelegate(const F& func) {
+        static_assert(sizeof(F) <= kStorageSize, "GameEventDelegate: callable too large, capture less");
+        static_assert(alignof(F) <= alignof(Storage), "GameEventDelegate: callable over-aligned");
+        static_assert(std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value,
+            "GameEventDelegate: callable must be trivially copyable (capture pointers, not std::function/std::string)");
+        new (&_storage) F(func);
+        _invoke = &invokeImpl<F>;
+    }
+
+    // 是否绑定了可调用对象
+    explicit operator bool() const { return _invoke != nullptr; }
+
+    // 调用委托
+    void operator()(const Event& event) const { _invoke(&_storage, event); }
+
+private:
+    typedef typename std::aligned_storage<kStorageSize, alignof(void*)>::type Storage;
+
+    template <typename F>
+    static void invokeImpl(const void* storage, const Event& event) {
+        (*static_cast<const F*>(storage))(event);
+    }
+
+    Storage _storage;                                  // 可调用对象的原地存储
+    void (*_invoke)(const void* storage, const Event&); // 类型擦除后的调用入口
+};
+
+/**
+ * 单一事件类型的订阅表：固定容量数组，订阅、退订、发布都不分配堆内存
+ * 发布过程中允许退订（仅标记槽位失效），新订阅者可能在本次发布中即被调用
+ */
+template <typename Event, int Capacity>
+class GameEventChannel {
+public:
+    GameEventChannel() : _highWater(0) {
+        for (int i = 0; i < Capacity; ++i) {
+            _active[i] = false;
+        }
+    }
+
+    /**
+     * 添加订阅者
+     * @param delegate 事件处理委托
+     * @return 订阅句柄（用于退订），订阅表已满时返回-1
+     */
+    int subscribe(const GameEventDelegate<Event>& delegate) {
+        for (int i = 0; i < Capacity; ++i) {
+            if (!_active[i]) {
+                _delegates[i] = delegate;
+                _active[i] = true;
+                if (i >= _highWater) {
+                    _highWater = i + 1;
+                }
+                return i;
+            }
+        }
+        GLOG_WARN(u8"GameEventBus: 订阅表已满（容量%d），订阅失败", Capacity);
+        return -1;
+    }
+
+    /**
+     * 移除订阅者
+     * @param handle subscribe返回的订阅句柄
+     */
+    void unsubscribe(int handle) {
+        if (handle >= 0 && handle < Capacity) {
+            _active[handle] = false;
+        }
+    }
+
+    /**
+     * 按订阅顺序同步派发事件
+     * @param event 事件数据
+     */
+    void publish(const Event& event) const {
+        for (int i = 0; i < _highWater; ++i) {
+            if (_active[i]) {
+                _delegates[i](event);
+            }
+        }
+    }
+
+private:
+    GameEventDelegate<Event> _delegates[Capacity]; // 订阅者委托
+    bool _active[Capacity];                        // 槽位是否有效
+    int _highWater;                                // 曾经使用过的最大槽位数，发布时只遍历到此处
+};
+
+/*
+类型化游戏事件总线，替代层层嵌套的std::function回调
+核心功能：
+1. 每种事件类型对应一个固定容量的订阅表，按事件类型在编译期选择，派发为直接的数组遍历
+2. 订阅者以小缓冲区委托保存，整个订阅、发布过程零堆分配
+3. 视图、音效、统计等模块各自订阅规则事件，彼此之间无需相互引用
+由GameView持有，生命周期覆盖控制器与所有卡牌管理器；仅在主线程使用
+ */
+class GameEventBus
+    : private GameEventChannel<CardClickedEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<CardMovedEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<CardUndoneEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<LevelClearedEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<NoMovesLeftEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<BoardDiffEvent, kGameEventMaxSubscribers>
+    , private GameEventChannel<CommandAppliedEvent, kGameEventMaxSubscribers> {
+public:
+    /**
+     * 订阅指定类型的事件
+     * @param handler 处理函数，签名为void(const Event&)
+     * @return 订阅句柄，订阅表已满时返回-1
+     */
+    template <typename Event, typename F>
+    int subscribe(const F& handler) {
+        return channel<Event>().subscribe(GameEventDelegate<Event>(handler));
+    }
+
+    /**
+     * 退订指定类型的事件
+     * @param handle subscribe返回的订阅句柄
+     */
+    template <typename Event>
+    void unsubscribe(int handle) {
+        channel<Event>().unsubscribe(handle);
+    }
+
+    /**
+     * 发布事件，同步调用全部订阅者
+     * @param event 事件数据
+     */
+    template <typename Event>
+    void publish(const Event& event) const {
+        channel<Event>().publish(event);
+    }
+
+private:
+    template <typename Event>
+    GameEventChannel<Event, kGameEventMaxSubscribers>& channel() { return *this; }
+
+    template <typename Event>
+    const GameEventChannel<Event, kGameEventMaxSubscribers>& channel() const { return *this; }
+};
+
+#endif // GAME_EVENT_BUS_H_
@@ -0,0 +1,275 @@
+#include "services/GameLog.h"
+#include "cocos2d.h"
+#include <chrono>
+#include <cstdio>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include <android/log.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+
+namespace {
+    const int kLineSize = 512; // 单条日志格式化后的最大长度
+
+    // 日志级别前缀
+    const char* levelTag(int level) {
+        switch (level) {
+        case GAME_LOG_LEVEL_VERBOSE: return "V";
+        case GAME_LOG_LEVEL_DEBUG:   return "D";
+        case GAME_LOG_LEVEL_INFO:    return "I";
+        case GAME_LOG_LEVEL_WARN:    return "W";
+        case GAME_LOG_LEVEL_ERROR:   return "E";
+        default:                     return "?";
+        }
+    }
+
+    uint64_t steadyNowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // 输出一行：直接使用平台日志接口，不经过cocos2d::log（它会访问Director）
+    void emitLine(const char* line) {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+        __android_log_write(ANDROID_LOG_DEBUG, "card_game", line);
+#else
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        // 调试器输出窗口按UTF-16显示，中文日志需先转换
+        WCHAR wide[kLineSize + 2];
+        int length = MultiByteToWideChar(CP_UTF8, 0, line, -1, wide, kLineSize);
+        if (length > 0) {
+            wide[length - 1] = L'\n';
+            wide[length] = L'\0';
+            OutputDebugStringW(wide);
+        }
+#endif
+        fputs(line, stdout);
+        fputc('\n', stdout);
+        fflush(stdout);
+#endif
+    }
+}
+
+GameLog::GameLog()
+    : _slots(new Slot[kCapacity]), _enqueuePos(0), _dequeuePos(0), _dropped(0), _consumedPos(0), _running(true),
+      _startNs(steadyNowNs()) {
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _worker = std::thread(&GameLog::run, this);
+}
+
+GameLog::~GameLog() {
+    shutdown(); // 正常退出时AppDelegate已调用过，这里只输出之后写入的日志
+    delete[] _slots;
+}
+
+void GameLog::shutdown() {
+    _running.store(false, std::memory_order_release);
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+    drain(); // 后台线程已停止，由调用线程输出残留日志
+}
+
+void GameLog::encodeArg(GameLogRecord& record, const char* text) {
+    record.argTypes[record.argCount] = GameLogRecord::ARG_TEXT;
+    auto& arg = record.args[record.argCount++];
+    if (!text) {
+        arg.textOffset = kNullText;
+        return;
+    }
+
+    size_t room = GameLogRecord::kTextSize - record.textUsed;
+    if (room < 2) {
+        arg.textOffset = kTruncatedText;
+        return;
+    }
+
+    // 拷贝字符串内容，调用方的缓冲区在后台线程格式化时可能已失效
+    size_t length = strlen(text);
+    if (length > room - 1) {
+        length = room - 1;
+    }
+    memcpy(record.text + record.textUsed, text, length);
+    record.text[record.textUsed + length] = '\0';
+    arg.textOffset = record.textUsed;
+    record.textUsed = static_cast<uint16_t>(record.textUsed + length + 1);
+}
+
+void GameLog::encodeArg(GameLogRecord& record, const void* pointer) {
+    record.argTypes[record.argCount] = GameLogRecord::ARG_POINTER;
+    record.args[record.argCount++].p = pointer;
+}
+
+void GameLog::push(GameLogRecord& record) {
+    record.timestampNs = steadyNowNs();
+
+    uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &_slots[pos & (kCapacity - 1)];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // 缓冲区已满：丢弃而不是等待，保证调用线程不被阻塞
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = record;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void GameLog::flush() {
+    uint32_t target = _enqueuePos.load(std::memory_order_acquire);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (static_cast<int32_t>(_consumedPos.load(std::memory_order_acquire) - target) < 0 &&
+        std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void GameLog::run() {
+    while (_running.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+int GameLog::drain() {
+    char text[kLineSize];
+    char line[kLineSize];
+    int count = 0;
+    for (;;) {
+        Slot& slot = _slots[_dequeuePos & (kCapacity - 1)];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - (_dequeuePos + 1)) < 0) {
+            break; // 缓冲区为空
+        }
+
+        GameLogRecord record = slot.record;
+        slot.sequence.store(_dequeuePos + kCapacity, std::memory_order_release);
+        ++_dequeuePos;
+
+        format(record, text, sizeof(text));
+        snprintf(line, sizeof(line), "[%s %.3f] %s", levelTag(record.level),
+            static_cast<double>(record.timestampNs - _startNs) / 1e9, text);
+        emitLine(line);
+        _consumedPos.store(_dequeuePos, std::memory_order_release);
+        ++count;
+    }
+
+    uint64_t dropped = _dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        snprintf(line, sizeof(line), "[W] GameLog: 缓冲区已满，丢弃%llu条日志", static_cast<unsigned long long>(dropped));
+        emitLine(line);
+    }
+    return count;
+}
+
+void GameLog::format(const GameLogRecord& record, char* out, size_t outSize) {
+    size_t used = 0;
+    int argIndex = 0;
+    const char* p = record.format ? record.format : "";
+
+    while (*p && used + 1 < outSize) {
+        if (*p != '%') {
+            out[used++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[used++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // 解析转换说明：保留标志/宽度/精度，丢弃长度修饰符，再按参数实际类型补上
+        char spec[32];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < 24) {
+            spec[specLength++] = *p++;
+        }
+        while (*p && strchr("hljztL", *p)) {
+            ++p;
+        }
+        char conversion = *p;
+        if (!conversion) {
+            break;
+        }
+        ++p;
+
+        char* dst = out + used;
+        size_t room = outSize - used;
+        int written = 0;
+        if (argIndex >= record.argCount) {
+            written = snprintf(dst, room, "<?>");
+        }
+        else {
+            uint8_t type = record.argTypes[argIndex];
+            const auto& arg = record.args[argIndex++];
+            long long asSigned = type == GameLogRecord::ARG_DOUBLE ? static_cast<long long>(arg.d) : arg.i;
+            unsigned long long asUnsigned = type == GameLogRecord::ARG_DOUBLE ? static_cast<unsigned long long>(arg.d) : arg.u;
+            double asDouble = type == GameLogRecord::ARG_DOUBLE ? arg.d :
+                (type == GameLogRecord::ARG_UINT ? static_cast<double>(arg.u) : static_cast<double>(arg.i));
+
+            switch (conversion) {
+            case 'd': case 'i':
+                memcpy(spec + specLength, "lld", 4);
+                written = snprintf(dst, room, spec, asSigned);
+                break;
+            case 'u': case 'x': case 'X': case 'o':
+                spec[specLength] = 'l';
+                spec[specLength + 1] = 'l';
+                spec[specLength + 2] = conversion;
+                spec[specLength + 3] = '\0';
+                written = snprintf(dst, room, spec, asUnsigned);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+                spec[specLength] = conversion;
+                spec[specLength + 1] = '\0';
+                written = snprintf(dst, room, spec, asDouble);
+                break;
+            case 'c':
+                memcpy(spec + specLength, "c", 2);
+                written = snprintf(dst, room, spec, static_cast<int>(asSigned));
+                break;
+            case 's': {
+                const char* text = "(null)";
+                if (type == GameLogRecord::ARG_TEXT && arg.textOffset == kTruncatedText) {
+                    text = "...";
+                }
+                else if (type == GameLogRecord::ARG_TEXT && arg.textOffset != kNullText) {
+                    text = record.text + arg.textOffset;
+                }
+                memcpy(spec + specLength, "s", 2);
+                written = snprintf(dst, room, spec, text);
+                break;
+            }
+            case 'p':
+                written = snprintf(dst, room, "%p", arg.p);
+                break;
+            default:
+                written = snprintf(dst, room, "<%%%c?>", conversion);
+                break;
+            }
+        }
+
+        if (written > 0) {
+            used += static_cast<size_t>(written) < room ? static_cast<size_t>(written) : room - 1;
+        }
+    }
+    out[used] = '\0';
+}
@@ -0,0 +1,223 @@
+#ifndef GAME_LOG_H_
+#define GAME_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// 日志级别
+#define GAME_LOG_LEVEL_VERBOSE 0 // 逐帧/逐事件的细节（如拖拽移动）
+#define GAME_LOG_LEVEL_DEBUG   1 // 调试信息（如点击、匹配、撤销流程）
+#define GAME_LOG_LEVEL_INFO    2 // 关键流程信息
+#define GAME_LOG_LEVEL_WARN    3 // 警告
+#define GAME_LOG_LEVEL_ERROR   4 // 错误
+#define GAME_LOG_LEVEL_OFF     5 // 关闭全部日志
+
+// 编译期最低日志级别：调试构建默认DEBUG，发布构建默认WARN，可在编译时覆盖
+#ifndef GAME_LOG_MIN_LEVEL
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+#define GAME_LOG_MIN_LEVEL GAME_LOG_LEVEL_DEBUG
+#else
+#define GAME_LOG_MIN_LEVEL GAME_LOG_LEVEL_WARN
+#endif
+#endif
+
+// 低于最低级别的日志宏展开为不会执行的分支：参数不会被求值、没有任何运行时开销，
+// 但仍被编译器看到，只为记日志而存在的局部变量在发布构建中不会产生未使用警告，参数个数也照常检查
+#define GAME_LOG_DISCARD(level, fmt, ...) (true ? (void)0 : GameLog::getInstance().write(level, fmt, ##__VA_ARGS__))
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_VERBOSE
+#define GLOG_VERBOSE(fmt, ...) GameLog::getInstance().write(GAME_LOG_LEVEL_VERBOSE, fmt, ##__VA_ARGS__)
+#else
+#define GLOG_VERBOSE(fmt, ...) GAME_LOG_DISCARD(GAME_LOG_LEVEL_VERBOSE, fmt, ##__VA_ARGS__)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_DEBUG
+#define GLOG_DEBUG(fmt, ...) GameLog::getInstance().write(GAME_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define GLOG_DEBUG(fmt, ...) GAME_LOG_DISCARD(GAME_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_INFO
+#define GLOG_INFO(fmt, ...) GameLog::getInstance().write(GAME_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define GLOG_INFO(fmt, ...) GAME_LOG_DISCARD(GAME_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_WARN
+#define GLOG_WARN(fmt, ...) GameLog::getInstance().write(GAME_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define GLOG_WARN(fmt, ...) GAME_LOG_DISCARD(GAME_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= GAME_LOG_LEVEL_ERROR
+#define GLOG_ERROR(fmt, ...) GameLog::getInstance().write(GAME_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define GLOG_ERROR(fmt, ...) GAME_LOG_DISCARD(GAME_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#endif
+
+/**
+ * 单条日志记录（二进制形式，格式化推迟到后台线程）
+ * 格式串必须是字符串字面量（只保存指针）；%s参数的内容会被拷贝进记录
+ */
+struct GameLogRecord {
+    static const int kMaxArgs = 8;    // 单条日志最多参数个数
+    static const int kTextSize = 96;  // %s参数拷贝区大小（超出部分截断）
+
+    enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_TEXT, ARG_POINTER };
+
+    const char* format;                  // 格式串（字面量）
+    uint64_t timestampNs;                // 写入时刻（steady_clock，入队时填写）
+    uint8_t level;                       // 日志级别
+    uint8_t argCount;                    // 参数个数
+    uint16_t textUsed;                   // 拷贝区已用字节数
+    uint8_t argTypes[kMaxArgs];          // 参数类型
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+        uint16_t textOffset;
+    } args[kMaxArgs];                    // 参数值
+    char text[kTextSize];                // %s参数拷贝区
+};
+
+/*
+异步日志器，替代热路径上的CCLOG
+核心功能：
+1. 编译期过滤：低于GAME_LOG_MIN_LEVEL的日志宏展开为不会执行的分支，参数不求值，不产生任何代码
+2. 生产端只把格式串指针和参数以二进制形式写入无锁环形缓冲区，不做格式化、不做I/O、不分配内存
+3. 后台线程批量取出记录，完成格式化后直接写stdout（Android为logcat，Windows另写调试器输出），
+   不经过cocos2d::log，因而不依赖Director，可在任何线程、引擎销毁后输出；每行带相对日志器启动的秒数
+4. 缓冲区满时丢弃新日志并计数，保证主线程永不阻塞
+5. 退出前由AppDelegate调用shutdown停止后台线程并输出残留日志，不依赖静态析构的时机
+ */
+class GameLog {
+public:
+    /**
+     * 获取单例实例（首次调用时启动后台线程）
+     * @return 全局唯一的GameLog实例引用
+     */
+    static GameLog& getInstance() {
+        static GameLog instance;
+        return instance;
+    }
+
+    /**
+     * 写入一条日志（由GLOG_*宏调用）
+     * @param level 日志级别
+     * @param format printf风格的格式串，必须是字符串字面量
+     * @param args 格式参数（整数、浮点、字符串、指针）
+     */
+    template <typename... Args>
+    void write(int level, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= GameLogRecord::kMaxArgs, "GameLog: too many log arguments");
+        GameLogRecord record;
+        record.format = format;
+        record.level = static_cast<uint8_t>(level);
+        record.argCount = 0;
+        record.textUsed = 0;
+        encodeArgs(record, args...);
+        push(record);
+    }
+
+    /**
+     * 等待后台线程输出完当前缓冲区中的全部日志
+     */
+    void flush();
+
+    /**
+     * 停止后台线程并在调用线程上输出残留日志（可重复调用，只能在主线程调用）
+     * 之后写入的日志留在缓冲区，由析构函数输出
+     */
+    void shutdown();
+
+    /**
+     * 获取因缓冲区满而丢弃的日志条数
+     * @return 丢弃条数
+     */
+    uint64_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+    // %s参数的特殊偏移：空指针 / 拷贝区已满
+    static const uint16_t kNullText = 0xFFFF;
+    static const uint16_t kTruncatedText = 0xFFFE;
+
+private:
+    static const uint32_t kCapacity = 4096; // 环形缓冲区容量（必须为2的幂）
+
+    // 缓冲区槽位：序号用于协调多生产者与消费者（Vyukov有界队列）
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        GameLogRecord record;
+    };
+
+    GameLog();
+    ~GameLog();
+    GameLog(const GameLog&) = delete;
+    GameLog& operator=(const GameLog&) = delete;
+
+    // 把记录写入环形缓冲区，满时丢弃
+    void push(GameLogRecord& record);
+
+    // 后台线程主循环
+    void run();
+
+    // 取出并输出缓冲区中现有的全部记录，返回输出条数
+    int drain();
+
+    // 把一条记录格式化为文本
+    static void format(const GameLogRecord& record, char* out, size_t outSize);
+
+    // 参数编码：递归展开参数包
+    static void encodeArgs(GameLogRecord&) {}
+
+    template <typename T, typename... Rest>
+    static void encodeArgs(GameLogRecord& record, T value, Rest... rest) {
+        encodeArg(record, value);
+        encodeArgs(record, rest...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    encodeArg(GameLogRecord& record, T value) {
+        record.argTypes[record.argCount] = GameLogRecord::ARG_INT;
+        record.args[record.argCount++].i = static_cast<int64_t>(value);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    encodeArg(GameLogRecord& record, T value) {
+        record.argTypes[record.argCount] = GameLogRecord::ARG_UINT;
+        record.args[record.argCount++].u = static_cast<uint64_t>(value);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    encodeArg(GameLogRecord& record, T value) {
+        record.argTypes[record.argCount] = GameLogRecord::ARG_DOUBLE;
+        record.args[record.argCount++].d = static_cast<double>(value);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value>::type
+    encodeArg(GameLogRecord& record, T value) {
+        encodeArg(record, static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    static void encodeArg(GameLogRecord& record, const char* text);
+    static void encodeArg(GameLogRecord& record, char* text) { encodeArg(record, static_cast<const char*>(text)); }
+    static void encodeArg(GameLogRecord& record, const void* pointer);
+
+    Slot* _slots;                          // 环形缓冲区（构造时一次性分配）
+    std::atomic<uint32_t> _enqueuePos;     // 生产者写入位置
+    uint32_t _dequeuePos;                  // 消费者读取位置（仅后台线程访问）
+    std::atomic<uint64_t> _dropped;        // 丢弃计数
+    std::atomic<uint32_t> _consumedPos;    // 已输出位置（供flush等待）
+    std::atomic<bool> _running;            // 后台线程运行标记
+    const uint64_t _startNs;               // 日志器启动时刻，输出的时间为相对它的秒数
+    std::thread _worker;                   // 后台格式化/输出线程
+};
+
+#endif // GAME_LOG_H_
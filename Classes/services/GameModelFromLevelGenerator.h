@@ -5,27 +5,51 @@
 #include "views/GameView.h"
 #include "configs/models/LevelConfig.h" 
 #include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/BuiltinLevelLoader.h"
+#include "services/GameContext.h"
+#include "services/DealEngine.h"
+#include <memory>
 #include <vector>
 
+// 内置关卡：编译进程序的关卡优先于同名关卡文件，默认开启
+#ifndef CARD_BUILTIN_LEVELS
+#define CARD_BUILTIN_LEVELS 1
+#endif
+
 USING_NS_CC;
 
 /*
 关卡模型生成器类，负责将静态关卡配置转换为运行时游戏对象
 核心功能：
-1. 从JSON配置文件加载数据并生成GameModel实例
+1. 从JSON配置文件加载数据并生成GameModel实例；"deal:"开头的关卡名交给DealEngine按种子发牌，
+   编译进程序的内置关卡由BuiltinLevelLoader直接生成，二者都不读取文件
 2. 根据游戏模型创建并初始化对应的GameView视图
+3. 多棋盘时为每个棋盘传入各自的对局上下文（布局、卡牌管理器映射、事件总线），缺省为单棋盘的默认上下文
 采用静态类设计，所有方法均为静态，无需实例化即可使用
  */
 class GameModelFromLevelGenerator {
 public:
     /*
     从关卡配置文件生成游戏数据模型
-    @param levelFile 关卡配置文件路径（相对于资源目录）
+    @param levelFile 关卡配置文件路径（相对于资源目录），或种子发牌的关卡名（见DealEngine::levelName）
+    @param layout 棋盘布局，应与随后创建视图时使用的对局上下文一致
     @return 生成的GameModel实例，包含从配置加载的卡牌数据
     */
-    static GameModel generateGameModel(const std::string levelFile) {
-        auto config = LevelConfigLoader::loadLevelConfig(levelFile);
+    static GameModel generateGameModel(const std::string levelFile, const BoardLayout& layout = BoardLayout()) {
+        if (DealEngine::isDealLevel(levelFile)) {
+            GameModel dealtModel(nullptr);
+            DealEngine::dealLevel(levelFile, layout, dealtModel); // 关卡名无效时为空模型，与关卡文件加载失败一致
+            return dealtModel;
+        }
+#if CARD_BUILTIN_LEVELS
+        GameModel builtinModel(nullptr);
+        if (BuiltinLevelLoader::loadLevel(levelFile, layout, builtinModel)) {
+            return builtinModel; // 首批关卡不经FileUtils与rapidjson
+        }
+#endif
+        auto config = LevelConfigLoader::loadLevelConfig(levelFile, layout);
         GameModel gameModel(config);
+        LevelConfigLoader::releaseLevelConfig(config); // 卡牌数据已拷贝到模型中
         return gameModel;
     }
 
@@ -33,13 +57,16 @@ public:
     根据游戏模型生成并初始化游戏视图
     @param gameModel 游戏数据模型，包含需要显示的卡牌信息
     @param parent 视图的父节点，用于将游戏视图添加到场景层级
+    @param context 对局上下文，为nullptr时由视图新建默认上下文
+    @return 创建的游戏视图，失败返回nullptr
     */
-    static void generateGameView(GameModel& gameModel, Node* parent) {
+    static GameView* generateGameView(GameModel& gameModel, Node* parent, std::shared_ptr<GameContext> context = nullptr) {
         // 创建游戏视图实例并关联模型
-        auto gameView = GameView::create(gameModel);
+        auto gameView = GameView::create(gameModel, std::move(context));
         if (gameView) {
             parent->addChild(gameView, 1); // 添加到父节点，z轴层级1（确保显示在背景上层）
         }
+        return gameView;
     }
 
 private:
@@ -0,0 +1,26 @@
+#include "services/HeadlessGLView.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+
+HeadlessGLView* HeadlessGLView::create(const std::string& viewName, const cocos2d::Rect& rect) {
+    auto view = new (std::nothrow) HeadlessGLView();
+    if (view && view->init(viewName, rect)) {
+        view->autorelease();
+        return view;
+    }
+    CC_SAFE_DELETE(view);
+    return nullptr;
+}
+
+bool HeadlessGLView::init(const std::string& viewName, const cocos2d::Rect& rect) {
+    if (!initWithRect(viewName, rect, 1.0f, false)) {
+        CCLOG("HeadlessGLView: 创建GL上下文失败（CI容器中请确认已启动Xvfb等虚拟显示）");
+        return false;
+    }
+
+    // 只需要上下文，不需要可见窗口
+    glfwHideWindow(getWindow());
+    return true;
+}
+
+#endif
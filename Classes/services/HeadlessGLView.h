@@ -0,0 +1,40 @@
+#ifndef HEADLESS_GL_VIEW_H_
+#define HEADLESS_GL_VIEW_H_
+
+#include "cocos2d.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+
+/*
+无界面GL视图，用于CI容器中的集成测试与性能测试（仅桌面平台）
+纹理创建等引擎内部调用离不开GL上下文，因此仍创建一个窗口以获得上下文，但：
+1. 窗口创建后立即隐藏，不需要显示器上可见的窗口（无GPU时配合Xvfb + Mesa软件渲染使用）
+2. swapBuffers为空操作，从不向屏幕提交帧
+3. pollEvents为空操作，输入全部由TouchInjector以编程方式注入
+帧推进由HeadlessSession以虚拟时钟驱动，不受垂直同步和真实时间限制
+ */
+class HeadlessGLView : public cocos2d::GLViewImpl {
+public:
+    /**
+     * 静态创建方法
+     * @param viewName 窗口名称
+     * @param rect 视图尺寸（与设计分辨率一致即可）
+     * @return 成功返回实例，失败返回nullptr
+     */
+    static HeadlessGLView* create(const std::string& viewName, const cocos2d::Rect& rect);
+
+    // 不向屏幕提交帧
+    virtual void swapBuffers() override {}
+
+    // 不处理系统窗口事件
+    virtual void pollEvents() override {}
+
+protected:
+    HeadlessGLView() : GLViewImpl(true) {}
+
+    bool init(const std::string& viewName, const cocos2d::Rect& rect);
+};
+
+#endif
+
+#endif // HEADLESS_GL_VIEW_H_
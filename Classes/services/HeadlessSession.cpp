@@ -0,0 +1,154 @@
+#include "services/HeadlessSession.h"
+#include "services/PerfMonitor.h"
+#include "services/TouchInjector.h"
+#include "views/GameView.h"
+#include "views/CardView.h"
+#include <algorithm>
+
+namespace {
+    // 节点中心的世界坐标
+    cocos2d::Vec2 worldPositionOf(cocos2d::Node* node) {
+        return node->getParent() ? node->getParent()->convertToWorldSpace(node->getPosition()) : node->getPosition();
+    }
+
+    // 是否还有卡牌动画在运行
+    bool hasRunningActions(GameView* gameView) {
+        for (auto cardView : gameView->getPlayfieldCardViews()) {
+            if (cardView->getNumberOfRunningActions() > 0) return true;
+        }
+        for (auto cardView : gameView->getStackfieldCardViews()) {
+            if (cardView->getNumberOfRunningActions() > 0) return true;
+        }
+        return false;
+    }
+}
+
+bool HeadlessSession::run(cocos2d::Scene* scene, const HeadlessSessionOptions& options) {
+    auto director = cocos2d::Director::getInstance();
+    if (!scene) {
+        CCLOG("HeadlessSession: 场景为空");
+        return false;
+    }
+
+    PerfScope wallClock;
+    director->runWithScene(scene);
+    stepFrame(options.frameDelta, options.render); // 第一帧让场景进入运行状态
+    int frames = 1;
+
+    GameView* gameView = findGameView(scene);
+    if (!gameView) {
+        CCLOG("HeadlessSession: 场景中没有GameView");
+        return false;
+    }
+
+    // 每项检查失败都记一条日志并让本次运行失败，而不是只要跑完就算通过
+    bool passed = true;
+    GameController* controller = gameView->getGameController();
+    TouchInjector touch;
+    if (options.autoPlay) {
+        frames += runAutoPlay(gameView, options);
+        if (controller->getStatus() == GameStatus::Playing) {
+            cocos2d::log("[headless] FAILED: auto play did not finish within %d frames", options.autoPlayFrameLimit);
+            passed = false;
+        }
+    }
+
+    // 记录初始位置：牌堆卡牌叠放在同一位置，点击该位置总是命中最上面一张
+    std::vector<cocos2d::Vec2> playfieldPositions;
+    for (auto cardView : gameView->getPlayfieldCardViews()) {
+        playfieldPositions.push_back(worldPositionOf(cardView));
+    }
+    const auto& stackViews = gameView->getStackfieldCardViews();
+    cocos2d::Vec2 stackPosition = stackViews.empty() ? cocos2d::Vec2::ZERO : worldPositionOf(stackViews.front());
+
+    // 每翻开一张牌堆卡牌，就尝试点击所有游戏区卡牌（不匹配的点击由控制器拒绝）
+    const int movesBeforeTaps = controller->getMoveCount();
+    for (size_t i = 0; !options.autoPlay && i < stackViews.size(); ++i) {
+        touch.tap(stackPosition);
+        frames += settle(gameView, options);
+
+        for (const auto& pos : playfieldPositions) {
+            touch.tap(pos);
+            frames += settle(gameView, options);
+        }
+    }
+    if (!options.autoPlay && controller->getMoveCount() <= movesBeforeTaps) {
+        cocos2d::log("[headless] FAILED: scripted taps moved no cards (moves: %d)", controller->getMoveCount());
+        passed = false;
+    }
+
+    // 撤销若干步，覆盖撤销动画路径；每次点击应撤回一步历史，直到历史为空
+    cocos2d::Node* undoButton = gameView->getUndoButton();
+    const int historyBeforeUndo = controller->getGameModel().getUndoModel().getSize();
+    for (int i = 0; undoButton && i < options.undoTaps; ++i) {
+        touch.tap(worldPositionOf(undoButton));
+        frames += settle(gameView, options);
+    }
+    const int expectedHistory = std::max(0, historyBeforeUndo - options.undoTaps);
+    const int history = controller->getGameModel().getUndoModel().getSize();
+    if (options.undoTaps > 0 && (!undoButton || history != expectedHistory)) {
+        cocos2d::log("[headless] FAILED: undo taps left history at %d, expected %d", history, expectedHistory);
+        passed = false;
+    }
+
+    double wallSeconds = wallClock.elapsedNs() / 1e9;
+    double virtualSeconds = frames * options.frameDelta;
+    cocos2d::log("[headless] frames: %d, virtual: %.2fs, wall: %.3fs, %.0f fps (%s)",
+        frames, virtualSeconds, wallSeconds, wallSeconds > 0 ? frames / wallSeconds : 0.0,
+        options.render ? "render" : "null renderer");
+    cocos2d::log("[headless] %s", passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+void HeadlessSession::stepFrame(float dt, bool render) {
+    auto director = cocos2d::Director::getInstance();
+    if (render) {
+        // 使用调用方给定的帧间隔，而不是真实流逝的时间
+        director->mainLoop(dt);
+        return;
+    }
+
+    // 空渲染器：只做drawScene中与逻辑相关的部分
+    if (!director->getRunningScene()) {
+        director->setNextScene();
+    }
+    director->getScheduler()->update(dt);
+    cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+}
+
+int HeadlessSession::settle(GameView* gameView, const HeadlessSessionOptions& options) {
+    int frames = 0;
+    do {
+        stepFrame(options.frameDelta, options.render);
+        ++frames;
+    } while (frames < options.settleFrames && hasRunningActions(gameView));
+    return frames;
+}
+
+int HeadlessSession::runAutoPlay(GameView* gameView, const HeadlessSessionOptions& options) {
+    gameView->setAutoPlay(true);
+    int frames = 0;
+    while (gameView->isAutoPlaying() && frames < options.autoPlayFrameLimit) {
+        stepFrame(options.frameDelta, options.render);
+        ++frames;
+    }
+    frames += settle(gameView, options);
+
+    GameController* controller = gameView->getGameController();
+    const char* status = controller->getStatus() == GameStatus::Cleared ? "cleared" :
+        controller->getStatus() == GameStatus::NoMovesLeft ? "no moves left" : "unfinished";
+    cocos2d::log("[headless] auto play: %s, moves: %d, score: %d", status, controller->getMoveCount(), controller->getScore());
+    return frames;
+}
+
+GameView* HeadlessSession::findGameView(cocos2d::Node* node) {
+    if (auto gameView = dynamic_cast<GameView*>(node)) {
+        return gameView;
+    }
+    for (auto child : node->getChildren()) {
+        if (auto gameView = findGameView(child)) {
+            return gameView;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,62 @@
+#ifndef HEADLESS_SESSION_H_
+#define HEADLESS_SESSION_H_
+
+#include "cocos2d.h"
+
+class GameView;
+
+/**
+ * 无界面对局的运行参数
+ */
+struct HeadlessSessionOptions {
+    float frameDelta = 1.0f / 60;  // 虚拟时钟每帧推进的时间（秒），与真实耗时无关
+    bool render = false;           // 是否执行渲染；false时为空渲染器，只推进调度器与动作
+    int settleFrames = 40;         // 每次操作后最多等待动画结束的帧数
+    int undoTaps = 3;              // 对局结束后追加的撤销次数
+    bool autoPlay = false;         // true时由自动对局机器人走完整局（浸泡测试），代替逐张点击的脚本
+    int autoPlayFrameLimit = 20000; // 自动对局最多推进的帧数
+};
+
+/*
+无界面对局驱动器，在虚拟时钟上逐帧推进导演并以编程方式注入触摸
+核心功能：
+1. 虚拟时钟：每帧固定推进frameDelta，帧率只受CPU限制，可远超实时
+2. 空渲染器：render为false时跳过绘制与缓冲交换，只运行调度器、动作和自动释放池
+3. 脚本对局：通过TouchInjector点击真实的GameView / CardView / CardManager链路，
+   依次翻开牌堆、尝试匹配每张游戏区卡牌，最后执行撤销，覆盖完整的交互路径
+4. 浸泡测试：autoPlay为true时开启GameView的自动对局，由AutoPlayer经控制器指令队列走完整局
+5. 检查对局确实生效：脚本点击后移动次数增加，撤销点击使撤销历史逐步减少，自动对局在帧数上限内到达终局
+6. 结束后输出帧数、虚拟时长、真实耗时与达到的帧率
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class HeadlessSession {
+public:
+    /**
+     * 运行一局完整的无界面对局
+     * @param scene 对局场景（需包含GameView）
+     * @param options 运行参数
+     * @return 全部检查通过返回true；找不到GameView、点击或撤销没有生效、自动对局未到终局时返回false
+     */
+    static bool run(cocos2d::Scene* scene, const HeadlessSessionOptions& options);
+
+    /**
+     * 以虚拟时钟推进一帧
+     * @param dt 本帧推进的时间（秒）
+     * @param render 是否执行渲染
+     */
+    static void stepFrame(float dt, bool render);
+
+private:
+    HeadlessSession() = default;
+
+    // 推进帧直到所有卡牌动画结束或达到上限，返回实际推进的帧数
+    static int settle(GameView* gameView, const HeadlessSessionOptions& options);
+
+    // 开启自动对局并推进帧直到其停止或达到上限，返回实际推进的帧数
+    static int runAutoPlay(GameView* gameView, const HeadlessSessionOptions& options);
+
+    // 在节点树中查找GameView
+    static GameView* findGameView(cocos2d::Node* node);
+};
+
+#endif // HEADLESS_SESSION_H_
@@ -0,0 +1,134 @@
+#include "services/LzCodec.h"
+#include <cstring>
+
+namespace {
+    const size_t kTokenMax = 15;          // 令牌中长度字段的最大值（超出部分写入扩展字节）
+    const size_t kLastLiterals = 5;       // 末尾至少保留的字面量字节数（匹配不延伸到块尾，简化解压检查）
+
+    uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash32(uint32_t value) {
+        return (value * 2654435761u) >> (32 - LzCodec::kHashBits);
+    }
+}
+
+void LzCodec::writeLength(size_t length, std::vector<uint8_t>& out) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void LzCodec::writeSequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength,
+    std::vector<uint8_t>& out) {
+    const size_t matchCode = matchLength > 0 ? matchLength - kMinMatch : 0;
+    const uint8_t literalNibble = static_cast<uint8_t>(literalLength < kTokenMax ? literalLength : kTokenMax);
+    const uint8_t matchNibble = static_cast<uint8_t>(matchCode < kTokenMax ? matchCode : kTokenMax);
+    out.push_back(static_cast<uint8_t>((literalNibble << 4) | matchNibble));
+    if (literalLength >= kTokenMax) {
+        writeLength(literalLength - kTokenMax, out);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= kTokenMax) {
+        writeLength(matchCode - kTokenMax, out);
+    }
+}
+
+void LzCodec::compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    // 哈希表保存各4字节前缀最近一次出现的位置+1（0表示空）
+    uint32_t table[1 << kHashBits];
+    std::memset(table, 0, sizeof(table));
+
+    size_t anchor = 0; // 尚未输出的字面量起点
+    size_t pos = 0;
+    const size_t matchLimit = size > kLastLiterals ? size - kLastLiterals : 0;
+    while (pos + kMinMatch <= matchLimit) {
+        const uint32_t sequence = read32(data + pos);
+        uint32_t& entry = table[hash32(sequence)];
+        const size_t candidate = entry;
+        entry = static_cast<uint32_t>(pos + 1);
+        if (candidate == 0 || pos + 1 - candidate > static_cast<size_t>(kMaxOffset) || read32(data + candidate - 1) != sequence) {
+            ++pos;
+            continue;
+        }
+
+        // 向后延伸匹配（不越过末尾保留区）
+        const size_t matchStart = candidate - 1;
+        size_t length = kMinMatch;
+        while (pos + length < matchLimit && data[matchStart + length] == data[pos + length]) {
+            ++length;
+        }
+        writeSequence(data + anchor, pos - anchor, pos - matchStart, length, out);
+        pos += length;
+        anchor = pos;
+    }
+    writeSequence(data + anchor, size - anchor, 0, 0, out);
+}
+
+bool LzCodec::decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    size_t in = 0;
+    size_t written = 0;
+    while (in < size) {
+        const uint8_t token = data[in++];
+
+        // 字面量
+        size_t literalLength = token >> 4;
+        if (literalLength == kTokenMax) {
+            uint8_t extra = 255;
+            while (extra == 255) {
+                if (in >= size) {
+                    return false;
+                }
+                extra = data[in++];
+                literalLength += extra;
+            }
+        }
+        if (literalLength > size - in || literalLength > outSize - written) {
+            return false;
+        }
+        std::memcpy(out + written, data + in, literalLength);
+        in += literalLength;
+        written += literalLength;
+        if (in == size) {
+            break; // 最后一个序列只有字面量
+        }
+
+        // 匹配
+        if (size - in < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(data[in]) | (static_cast<size_t>(data[in + 1]) << 8);
+        in += 2;
+        size_t matchLength = (token & 0x0F) + kMinMatch;
+        if ((token & 0x0F) == kTokenMax) {
+            uint8_t extra = 255;
+            while (extra == 255) {
+                if (in >= size) {
+                    return false;
+                }
+                extra = data[in++];
+                matchLength += extra;
+            }
+        }
+        if (offset == 0 || offset > written || matchLength > outSize - written) {
+            return false;
+        }
+        // 匹配可能与输出重叠（偏移小于长度时重复前面的字节），逐字节复制
+        const uint8_t* source = out + written - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            out[written + i] = source[i];
+        }
+        written += matchLength;
+    }
+    return written == outSize;
+}
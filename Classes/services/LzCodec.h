@@ -0,0 +1,52 @@
+#ifndef LZ_CODEC_H_
+#define LZ_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+LZ4风格的块压缩（字节对齐的LZ77，无熵编码），用于存档、分析数据等小块数据的快速压缩
+核心功能：
+1. 压缩：以4字节哈希表查找最近一次出现的相同前缀，贪心匹配，单遍完成
+2. 序列格式：令牌字节（高4位字面量长度、低4位匹配长度-4，取15时后跟255累加的扩展字节）
+   + 字面量 + 2字节小端偏移 + 扩展匹配长度；最后一个序列只有字面量
+3. 解压：调用方提供原始长度，所有读写均做边界检查，损坏的输入返回false而不会越界
+采用静态类设计，无需实例化；压缩使用调用线程栈上的哈希表，可在多个线程上同时使用
+ */
+class LzCodec {
+public:
+    static const int kMinMatch = 4;            // 最短匹配长度
+    static const int kMaxOffset = 65535;       // 最远匹配距离
+    static const int kHashBits = 12;           // 哈希表容量为2^kHashBits项
+
+    /**
+     * 压缩一块数据
+     * @param data 原始数据
+     * @param size 原始长度
+     * @param out 输出缓冲区（追加压缩结果）
+     */
+    static void compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    /**
+     * 解压一块数据
+     * @param data 压缩数据
+     * @param size 压缩数据长度
+     * @param out 输出缓冲区，长度至少为outSize
+     * @param outSize 原始长度（由调用方保存）
+     * @return 输入完整且恰好解出outSize字节返回true
+     */
+    static bool decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+private:
+    LzCodec() = default;
+
+    // 写入长度扩展字节（每字节最多255，小于255的字节表示结束）
+    static void writeLength(size_t length, std::vector<uint8_t>& out);
+
+    // 写入一个序列：字面量 + 匹配（matchLength为0表示只有字面量）
+    static void writeSequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength,
+        std::vector<uint8_t>& out);
+};
+
+#endif // LZ_CODEC_H_
@@ -0,0 +1,153 @@
+#include "services/MatchKernel.h"
+#include "models/CardModel.h"
+
+// 按编译目标选择向量实现；MSVC的x64与默认的x86（/arch:SSE2）均保证SSE2可用
+#if !CARD_MATCH_KERNEL_SCALAR
+#if defined(__AVX2__)
+#define MATCH_KERNEL_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATCH_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace {
+    const int kWordBits = 64;
+    const uint8_t kPlayfieldZone = static_cast<uint8_t>(CardZone::Playfield);
+
+    // 64位置位计数（不依赖编译器内建函数）
+    int popCount(uint64_t value) {
+        value = value - ((value >> 1) & 0x5555555555555555ULL);
+        value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<int>((value * 0x0101010101010101ULL) >> 56);
+    }
+
+    // 标量计算[begin, begin + n)内的掩码，n不超过64
+    uint64_t scanScalar(const int8_t* faces, const int8_t* suits, const uint8_t* zones, int begin, int n,
+        const MatchQuery& q) {
+        uint64_t bits = 0;
+        for (int i = 0; i < n; ++i) {
+            const int8_t face = faces[begin + i];
+            const int8_t suit = suits[begin + i];
+            const int faceHit = (face == q.faces[0]) | (face == q.faces[1]) | (face == q.faces[2]) |
+                ((face > q.faceAbove) & (face < q.faceBelow));
+            const int suitHit = (suit == q.suits[0]) | (suit == q.suits[1]) | (suit == q.suits[2]) | (suit == q.suits[3]);
+            const int zoneHit = zones[begin + i] == kPlayfieldZone;
+            bits |= static_cast<uint64_t>(faceHit & suitHit & zoneHit) << i;
+        }
+        return bits;
+    }
+
+#if MATCH_KERNEL_AVX2
+    typedef __m256i Lanes;
+    const int kLaneCount = 32;
+    inline Lanes load(const void* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    inline Lanes splat(int8_t v) { return _mm256_set1_epi8(v); }
+    inline Lanes eq(Lanes a, Lanes b) { return _mm256_cmpeq_epi8(a, b); }
+    inline Lanes gt(Lanes a, Lanes b) { return _mm256_cmpgt_epi8(a, b); }
+    inline Lanes bitOr(Lanes a, Lanes b) { return _mm256_or_si256(a, b); }
+    inline Lanes bitAnd(Lanes a, Lanes b) { return _mm256_and_si256(a, b); }
+    inline uint64_t moveMask(Lanes a) { return static_cast<uint32_t>(_mm256_movemask_epi8(a)); }
+#elif MATCH_KERNEL_SSE2
+    typedef __m128i Lanes;
+    const int kLaneCount = 16;
+    inline Lanes load(const void* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline Lanes splat(int8_t v) { return _mm_set1_epi8(v); }
+    inline Lanes eq(Lanes a, Lanes b) { return _mm_cmpeq_epi8(a, b); }
+    inline Lanes gt(Lanes a, Lanes b) { return _mm_cmpgt_epi8(a, b); }
+    inline Lanes bitOr(Lanes a, Lanes b) { return _mm_or_si128(a, b); }
+    inline Lanes bitAnd(Lanes a, Lanes b) { return _mm_and_si128(a, b); }
+    inline uint64_t moveMask(Lanes a) { return static_cast<uint32_t>(_mm_movemask_epi8(a)); }
+#endif
+
+#if MATCH_KERNEL_AVX2 || MATCH_KERNEL_SSE2
+    // 匹配查询的各项预先广播到全部通道
+    struct SplatQuery {
+        Lanes faces[MatchQuery::kFaceCount];
+        Lanes faceAbove;
+        Lanes faceBelow;
+        Lanes suits[MatchQuery::kSuitCount];
+        Lanes playfield;
+
+        explicit SplatQuery(const MatchQuery& q) {
+            for (int i = 0; i < MatchQuery::kFaceCount; ++i) {
+                faces[i] = splat(q.faces[i]);
+            }
+            faceAbove = splat(q.faceAbove);
+            faceBelow = splat(q.faceBelow);
+            for (int i = 0; i < MatchQuery::kSuitCount; ++i) {
+                suits[i] = splat(q.suits[i]);
+            }
+            playfield = splat(static_cast<int8_t>(kPlayfieldZone));
+        }
+    };
+
+    // 一次比较kLaneCount张卡牌，返回kLaneCount位结果
+    inline uint64_t scanLanes(const int8_t* faces, const int8_t* suits, const uint8_t* zones, const SplatQuery& q) {
+        const Lanes f = load(faces);
+        const Lanes s = load(suits);
+        const Lanes z = load(zones);
+        Lanes faceHit = bitOr(bitOr(eq(f, q.faces[0]), eq(f, q.faces[1])), eq(f, q.faces[2]));
+        faceHit = bitOr(faceHit, bitAnd(gt(f, q.faceAbove), gt(q.faceBelow, f)));
+        const Lanes suitHit = bitOr(bitOr(eq(s, q.suits[0]), eq(s, q.suits[1])),
+            bitOr(eq(s, q.suits[2]), eq(s, q.suits[3])));
+        return moveMask(bitAnd(bitAnd(faceHit, suitHit), eq(z, q.playfield)));
+    }
+#endif
+}
+
+int MatchKernel::findPlayable(const int8_t* faces, const int8_t* suits, const uint8_t* zones, int count,
+    const MatchQuery& query, uint64_t* outMask) {
+#if MATCH_KERNEL_AVX2 || MATCH_KERNEL_SSE2
+    if (count <= 0) {
+        return 0;
+    }
+
+    const SplatQuery splatQuery(query);
+    const int words = wordCount(count);
+    int playable = 0;
+    for (int w = 0; w < words; ++w) {
+        const int begin = w * kWordBits;
+        const int n = count - begin < kWordBits ? count - begin : kWordBits;
+        // 字内每个完整的通道组向量比较，只有最后不足一组的n % kLaneCount张逐张比较，不越界读取
+        const int vectorEnd = n - n % kLaneCount;
+        uint64_t bits = 0;
+        for (int lane = 0; lane < vectorEnd; lane += kLaneCount) {
+            bits |= scanLanes(faces + begin + lane, suits + begin + lane, zones + begin + lane, splatQuery) << lane;
+        }
+        if (vectorEnd < n) {
+            bits |= scanScalar(faces, suits, zones, begin + vectorEnd, n - vectorEnd, query) << vectorEnd;
+        }
+        outMask[w] = bits;
+        playable += popCount(bits);
+    }
+    return playable;
+#else
+    return findPlayableScalar(faces, suits, zones, count, query, outMask);
+#endif
+}
+
+int MatchKernel::findPlayableScalar(const int8_t* faces, const int8_t* suits, const uint8_t* zones, int count,
+    const MatchQuery& query, uint64_t* outMask) {
+    const int words = wordCount(count);
+    int playable = 0;
+    for (int w = 0; w < words; ++w) {
+        const int begin = w * kWordBits;
+        const int n = count - begin < kWordBits ? count - begin : kWordBits;
+        outMask[w] = scanScalar(faces, suits, zones, begin, n, query);
+        playable += popCount(outMask[w]);
+    }
+    return playable;
+}
+
+const char* MatchKernel::backendName() {
+#if MATCH_KERNEL_AVX2
+    return "avx2";
+#elif MATCH_KERNEL_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
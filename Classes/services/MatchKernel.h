@@ -0,0 +1,92 @@
+#ifndef MATCH_KERNEL_H_
+#define MATCH_KERNEL_H_
+
+#include <cstdint>
+
+/*
+匹配查询：描述手牌栈顶下哪些游戏区卡牌可走，由规则策略（MatchRules.h）按栈顶卡牌生成
+卡牌可走当且仅当 牌面命中（等于faces之一，或落在(faceAbove, faceBelow)开区间内）且花色等于suits之一
+未用的项填kNoValue；查询的项数固定，内核逐组比较时不因规则不同而分支
+ */
+struct MatchQuery {
+    static const int8_t kNoValue = 127;  // 不会出现在牌面、花色列中的值
+    static const int kFaceCount = 3;     // 单值牌面项数
+    static const int kSuitCount = 4;     // 花色项数
+
+    int8_t faces[kFaceCount];            // 可匹配的牌面
+    int8_t faceAbove;                    // 牌面区间下界（不含），空区间为kNoValue
+    int8_t faceBelow;                    // 牌面区间上界（不含）
+    int8_t suits[kSuitCount];            // 允许的花色
+
+    /**
+     * 创建不匹配任何卡牌、允许全部花色的查询，供规则策略在此基础上填写
+     * @return 空查询
+     */
+    static MatchQuery none() {
+        MatchQuery query;
+        for (int i = 0; i < kFaceCount; ++i) {
+            query.faces[i] = kNoValue;
+        }
+        query.faceAbove = kNoValue;
+        query.faceBelow = kNoValue;
+        for (int i = 0; i < kSuitCount; ++i) {
+            query.suits[i] = static_cast<int8_t>(i);
+        }
+        return query;
+    }
+};
+
+/*
+批量匹配内核：一次扫描找出全部可与手牌栈顶匹配的游戏区卡牌
+核心功能：
+1. 直接读取CardStore的牌面、花色、区域三列（每卡各1字节），逐字节通道判断 牌面、花色命中匹配查询 且 区域 == 游戏区
+2. 按编译目标选择实现：AVX2每次32张、SSE2每次16张，其余平台及最后不足一组的卡牌走标量实现
+3. 结果为按槽位排列的位掩码（第slot位 = 第slot/64个字的第slot%64位），供求解器、自动对局、提示系统遍历可走的牌
+定义CARD_MATCH_KERNEL_SCALAR=1可强制使用标量实现（用于对照验证与性能比较）
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class MatchKernel {
+public:
+    /**
+     * 计算容纳count个槽位的位掩码所需的64位字数
+     * @param count 槽位数
+     * @return 字数
+     */
+    static int wordCount(int count) { return (count + 63) / 64; }
+
+    /**
+     * 找出命中匹配查询的游戏区卡牌（向量化实现）
+     * @param faces 牌面列（CardStore::getFaces）
+     * @param suits 花色列（CardStore::getSuits）
+     * @param zones 区域列（CardStore::getZones）
+     * @param count 槽位数
+     * @param query 由规则策略按手牌栈顶生成的匹配查询
+     * @param outMask 输出位掩码，至少wordCount(count)个字
+     * @return 可匹配的卡牌数
+     */
+    static int findPlayable(const int8_t* faces, const int8_t* suits, const uint8_t* zones, int count,
+        const MatchQuery& query, uint64_t* outMask);
+
+    /**
+     * 与findPlayable结果完全相同的标量实现
+     * @param faces 牌面列
+     * @param suits 花色列
+     * @param zones 区域列
+     * @param count 槽位数
+     * @param query 匹配查询
+     * @param outMask 输出位掩码，至少wordCount(count)个字
+     * @return 可匹配的卡牌数
+     */
+    static int findPlayableScalar(const int8_t* faces, const int8_t* suits, const uint8_t* zones, int count,
+        const MatchQuery& query, uint64_t* outMask);
+
+    /**
+     * 当前编译选用的实现名称（"avx2" / "sse2" / "scalar"），用于基准日志
+     */
+    static const char* backendName();
+
+private:
+    MatchKernel() = default;
+};
+
+#endif // MATCH_KERNEL_H_
@@ -0,0 +1,96 @@
+#include "services/PerfMonitor.h"
+#include "cocos2d.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
+#include <mach/mach.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include <unistd.h>
+#endif
+
+std::atomic<uint64_t> PerfMonitor::s_allocationCount(0);
+
+bool PerfMonitor::isAllocationTrackingEnabled() {
+#if CARD_PERF_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t PerfMonitor::getResidentMemoryBytes() {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<uint64_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return static_cast<uint64_t>(info.resident_size);
+    }
+    return 0;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    // /proc/self/statm 第二列为常驻页数
+    long pages = 0;
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (fp) {
+        long total = 0;
+        if (fscanf(fp, "%ld %ld", &total, &pages) != 2) {
+            pages = 0;
+        }
+        fclose(fp);
+    }
+    return static_cast<uint64_t>(pages) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+#if CARD_PERF_TRACK_ALLOCATIONS
+// 替换全局分配函数以统计堆分配次数，仅在性能门禁构建中启用
+void* operator new(std::size_t size) {
+    PerfMonitor::countAllocation();
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    PerfMonitor::countAllocation();
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+#endif // CARD_PERF_TRACK_ALLOCATIONS
@@ -0,0 +1,81 @@
+#ifndef PERF_MONITOR_H_
+#define PERF_MONITOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/*
+性能计量工具类，为基准测试与性能回归门禁提供计时和堆分配计数
+核心功能：
+1. 提供基于单调时钟的纳秒级时间读数
+2. 查询进程常驻内存大小
+3. 统计进程内的堆分配次数（需定义CARD_PERF_TRACK_ALLOCATIONS，
+   由PerfMonitor.cpp替换全局operator new，默认不开启，不影响正式包）
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class PerfMonitor {
+public:
+    /**
+     * 获取单调时钟当前读数
+     * @return 纳秒时间戳（仅用于计算差值）
+     */
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * 是否开启了堆分配统计
+     * @return 编译时定义了CARD_PERF_TRACK_ALLOCATIONS返回true
+     */
+    static bool isAllocationTrackingEnabled();
+
+    /**
+     * 获取进程启动以来的堆分配总次数
+     * @return 分配次数，未开启统计时恒为0
+     */
+    static uint64_t getAllocationCount() {
+        return s_allocationCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 获取当前进程的常驻内存大小
+     * @return 字节数，当前平台不支持时返回0
+     */
+    static uint64_t getResidentMemoryBytes();
+
+    /**
+     * 记录一次堆分配（由替换后的operator new调用）
+     */
+    static void countAllocation() {
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    PerfMonitor() = default;
+
+    static std::atomic<uint64_t> s_allocationCount; // 堆分配计数器
+};
+
+/*
+计量区间：构造时记录起始时间与分配计数
+通过elapsedNs()/allocations()读取从构造到调用时刻之间的增量
+ */
+class PerfScope {
+public:
+    PerfScope()
+        : _startNs(PerfMonitor::nowNs()), _startAllocations(PerfMonitor::getAllocationCount()) {}
+
+    // 区间耗时（纳秒）
+    uint64_t elapsedNs() const { return PerfMonitor::nowNs() - _startNs; }
+
+    // 区间内的堆分配次数
+    uint64_t allocations() const { return PerfMonitor::getAllocationCount() - _startAllocations; }
+
+private:
+    uint64_t _startNs;          // 起始时间戳
+    uint64_t _startAllocations; // 起始分配计数
+};
+
+#endif // PERF_MONITOR_H_
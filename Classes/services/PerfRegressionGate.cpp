@@ -0,0 +1,427 @@
+#include "services/PerfRegressionGate.h"
+#include "services/PerfMonitor.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "controllers/GameController.h"
+#include "models/GameModel.h"
+#include "services/MatchKernel.h"
+#include "services/SaveStateCodec.h"
+#include "services/DealEngine.h"
+#include "cocos2d.h"
+#include <cstdlib>
+
+namespace {
+    const int kLoaderIterations = 200;       // 加载路径迭代次数
+    const int kMatchCheckIterations = 20000; // 匹配检查迭代次数
+    const int kUndoIterations = 20000;       // 撤销路径迭代次数
+    const int kMatchKernelIterations = 200000; // 批量匹配内核迭代次数
+    const int kSaveStateIterations = 2000;   // 存档编解码迭代次数
+    const int kSaveStateHistory = 500;       // 存档基准的撤销历史长度
+    const int kDealIterations = 20000;       // 种子发牌迭代次数
+    const int kSmallHistory = 8;             // 规模对比：小撤销历史
+    const int kLargeHistory = 4096;          // 规模对比：大撤销历史
+    const int kRepetitions = 5;              // 整套基准的测量轮数
+
+    const double kDefaultTimeTolerance = 0.5;    // 默认耗时容差（相对基线的比例）
+    const double kDefaultAllocationSlack = 0.0;  // 默认分配次数容差（每次操作的绝对值）
+
+    // 根据计量区间与迭代次数生成探针结果
+    // 先读出耗时与分配次数再填写名称：名称字符串较长时赋值本身会分配堆内存，不能计入区间
+    PerfProbeResult makeResult(const char* name, const PerfScope& scope, int iterations) {
+        const uint64_t elapsedNs = scope.elapsedNs();
+        const uint64_t allocations = scope.allocations();
+        PerfProbeResult result;
+        result.name = name;
+        result.nsPerOp = static_cast<double>(elapsedNs) / iterations;
+        if (PerfMonitor::isAllocationTrackingEnabled()) {
+            result.allocsPerOp = static_cast<double>(allocations) / iterations;
+        }
+        return result;
+    }
+
+    // 参考机环境变量：CI在生成与比较基线时都设置为同一个机器标识
+    const char kMachineEnv[] = "CARD_PERF_GATE_MACHINE";
+
+    // 本次运行的测量环境：机器标识、编译器、构建配置与匹配内核实现，任一项与基线不同时耗时不可比
+    struct PerfReference {
+        std::string machine;
+        std::string compiler;
+        std::string build;
+        std::string matchKernel;
+    };
+
+    PerfReference currentReference() {
+        PerfReference reference;
+        const char* machine = std::getenv(kMachineEnv);
+        reference.machine = machine ? machine : "";
+#if defined(_MSC_VER)
+        reference.compiler = "MSVC " + std::to_string(_MSC_FULL_VER);
+#elif defined(__clang__)
+        reference.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        reference.compiler = "gcc " __VERSION__;
+#else
+        reference.compiler = "unknown";
+#endif
+#if COCOS2D_DEBUG > 0
+        reference.build = "Debug";
+#else
+        reference.build = "Release";
+#endif
+        reference.matchKernel = MatchKernel::backendName();
+        return reference;
+    }
+
+    // 读取字符串字段，缺失时返回空字符串
+    std::string readString(const rapidjson::Value& node, const char* key) {
+        if (node.HasMember(key) && node[key].IsString()) {
+            return node[key].GetString();
+        }
+        return std::string();
+    }
+
+    // 读取数值字段，缺失时返回默认值
+    double readNumber(const rapidjson::Value& node, const char* key, double defaultValue) {
+        if (node.HasMember(key) && node[key].IsNumber()) {
+            return node[key].GetDouble();
+        }
+        return defaultValue;
+    }
+}
+
+bool PerfRegressionGate::run(const std::string& levelFile, const std::string& baselineFile) {
+#if COCOS2D_DEBUG > 0
+    CCLOG(u8"PerfRegressionGate: 当前为调试构建，日志开销会使耗时结果偏高，请使用Release构建运行门禁");
+#endif
+    auto results = runBenchmarks(levelFile);
+    for (const auto& result : results) {
+        cocos2d::log("[perf] %-28s %10.1f ns/op  allocs/op: %6.2f  scaling: %.2f",
+            result.name.c_str(), result.nsPerOp, result.allocsPerOp, result.scaling);
+    }
+
+#if CARD_PERF_GATE_WRITE_BASELINE
+    writeBaseline(results, cocos2d::FileUtils::getInstance()->getWritablePath() + "perf_baseline.json");
+#endif
+
+    return checkAgainstBaseline(results, baselineFile);
+}
+
+std::vector<PerfProbeResult> PerfRegressionGate::runBenchmarks(const std::string& levelFile) {
+    // 整套基准重复多轮，每个探针取最快一轮：调度、频率调整等干扰只会让测量变慢，
+    // 各轮分散在整个运行期间，比连续重复同一探针更不容易整体落在一段受干扰的时间里
+    std::vector<PerfProbeResult> best = runRound(levelFile);
+    for (int round = 1; round < kRepetitions; ++round) {
+        std::vector<PerfProbeResult> results = runRound(levelFile);
+        for (size_t i = 0; i < best.size() && i < results.size(); ++i) {
+            if (results[i].nsPerOp < best[i].nsPerOp) {
+                best[i] = results[i];
+            }
+        }
+    }
+    return best;
+}
+
+std::vector<PerfProbeResult> PerfRegressionGate::runRound(const std::string& levelFile) {
+    std::vector<PerfProbeResult> results;
+    results.push_back(benchmarkLoader(levelFile, kLoaderIterations));
+
+    // 匹配检查在大小两种撤销历史下分别测量，规模比应接近1（栈顶查询为O(1)）
+    PerfProbeResult small = benchmarkMatchCheck(levelFile, kSmallHistory, kMatchCheckIterations);
+    PerfProbeResult large = benchmarkMatchCheck(levelFile, kLargeHistory, kMatchCheckIterations);
+    if (small.nsPerOp > 0) {
+        small.scaling = large.nsPerOp / small.nsPerOp;
+    }
+    results.push_back(small);
+
+    results.push_back(benchmarkUndo(levelFile, kUndoIterations));
+    results.push_back(benchmarkMatchKernel(levelFile, kMatchKernelIterations));
+    results.push_back(benchmarkSaveState(levelFile, kSaveStateHistory, kSaveStateIterations));
+    results.push_back(benchmarkDeal(kDealIterations));
+    return results;
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkLoader(const std::string& levelFile, int iterations) {
+    // 预热：让文件缓存与路径查找缓存就绪
+    LevelConfigLoader::releaseLevelConfig(LevelConfigLoader::loadLevelConfig(levelFile));
+
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        LevelConfigLoader::releaseLevelConfig(LevelConfigLoader::loadLevelConfig(levelFile));
+    }
+    return makeResult("loader.loadLevelConfig", scope, iterations);
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkMatchCheck(const std::string& levelFile, int historySize, int iterations) {
+    auto config = LevelConfigLoader::loadLevelConfig(levelFile);
+    GameModel gameModel(config);
+    LevelConfigLoader::releaseLevelConfig(config);
+
+    const auto& stackSlots = gameModel.getCards().getZoneMembers(CardZone::Stack);
+    if (stackSlots.empty()) {
+        CCLOG(u8"PerfRegressionGate: 关卡%s没有牌堆区卡牌，跳过匹配检查基准", levelFile.c_str());
+        return PerfProbeResult();
+    }
+
+    // 用同一张牌堆卡牌反复点击，构造指定长度的撤销历史
+    GameController controller(gameModel);
+    int stackCardId = gameModel.getCards().getId(stackSlots.front());
+    for (int i = 0; i < historySize; ++i) {
+        controller.clickStackCard(stackCardId);
+    }
+
+    // 探针即栈顶卡牌本身，牌面相同必然不匹配，选择操作不会改变任何状态
+    for (int i = 0; i < iterations / 10; ++i) {
+        controller.selectCardFromPlayefieldAndMatch(stackCardId);
+    }
+
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        controller.selectCardFromPlayefieldAndMatch(stackCardId);
+    }
+    return makeResult("controller.matchCheck", scope, iterations);
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkUndo(const std::string& levelFile, int iterations) {
+    auto config = LevelConfigLoader::loadLevelConfig(levelFile);
+    GameModel gameModel(config);
+    LevelConfigLoader::releaseLevelConfig(config);
+
+    const auto& stackSlots = gameModel.getCards().getZoneMembers(CardZone::Stack);
+    if (stackSlots.empty()) {
+        CCLOG(u8"PerfRegressionGate: 关卡%s没有牌堆区卡牌，跳过撤销基准", levelFile.c_str());
+        return PerfProbeResult();
+    }
+
+    GameController controller(gameModel);
+    int stackCardId = gameModel.getCards().getId(stackSlots.front());
+
+    // 预热：让撤销历史的容量稳定下来，后续记录与撤销不再触发扩容
+    for (int i = 0; i < iterations / 10; ++i) {
+        controller.clickStackCard(stackCardId);
+        controller.undo();
+    }
+
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        controller.clickStackCard(stackCardId);
+        controller.undo();
+    }
+    return makeResult("undo.recordAndUndo", scope, iterations);
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkMatchKernel(const std::string& levelFile, int iterations) {
+    auto config = LevelConfigLoader::loadLevelConfig(levelFile);
+    GameModel gameModel(config);
+    LevelConfigLoader::releaseLevelConfig(config);
+
+    const auto& stackSlots = gameModel.getCards().getZoneMembers(CardZone::Stack);
+    if (stackSlots.empty()) {
+        CCLOG(u8"PerfRegressionGate: 关卡%s没有牌堆区卡牌，跳过匹配内核基准", levelFile.c_str());
+        return PerfProbeResult();
+    }
+
+    // 把牌堆区首张卡牌翻到手牌区作为匹配基准
+    int stackCardId = gameModel.getCards().getId(stackSlots.front());
+    gameModel.moveCard(stackCardId, CardZone::Hand);
+    gameModel.getHand().push(stackCardId);
+
+    std::vector<uint64_t> mask;
+    int playable = gameModel.findPlayableCards(mask);
+    CCLOG(u8"PerfRegressionGate: 匹配内核实现：%s，可匹配卡牌数：%d", MatchKernel::backendName(), playable);
+
+    // 累加结果，防止编译器把循环体当作无副作用代码消除（以预热结果为初值，发布构建去掉CCLOG后它仍被使用）
+    volatile int sink = playable;
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + gameModel.findPlayableCards(mask);
+    }
+    return makeResult("matchKernel.findPlayable", scope, iterations);
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkSaveState(const std::string& levelFile, int historySize, int iterations) {
+    auto config = LevelConfigLoader::loadLevelConfig(levelFile);
+    GameModel gameModel(config);
+    LevelConfigLoader::releaseLevelConfig(config);
+
+    const auto& stackSlots = gameModel.getCards().getZoneMembers(CardZone::Stack);
+    if (stackSlots.empty()) {
+        CCLOG(u8"PerfRegressionGate: 关卡%s没有牌堆区卡牌，跳过存档基准", levelFile.c_str());
+        return PerfProbeResult();
+    }
+
+    // 翻开全部牌堆卡牌后用栈顶卡牌反复点击，构造指定长度的撤销历史
+    GameController controller(gameModel);
+    std::vector<int> stackIds;
+    for (int slot : stackSlots) {
+        stackIds.push_back(gameModel.getCards().getId(slot));
+    }
+    for (int cardId : stackIds) {
+        controller.clickStackCard(cardId);
+    }
+    while (controller.getGameModel().getUndoModel().getSize() < historySize) {
+        controller.clickStackCard(stackIds.back());
+    }
+
+    std::vector<uint8_t> data;
+    SaveState state;
+    SaveStateCodec::encode(controller.getInitialModel(), controller.getGameModel(),
+        controller.getMoveCount(), controller.getScore(), data);
+    CCLOG(u8"PerfRegressionGate: 存档大小：%d字节（撤销历史%d步）", static_cast<int>(data.size()), historySize);
+
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        SaveStateCodec::encode(controller.getInitialModel(), controller.getGameModel(),
+            controller.getMoveCount(), controller.getScore(), data);
+        SaveStateCodec::decode(data.data(), data.size(), state);
+    }
+    return makeResult("saveState.roundTrip", scope, iterations);
+}
+
+PerfProbeResult PerfRegressionGate::benchmarkDeal(int iterations) {
+    const DealTemplate& triPeaks = DealEngine::triPeaksTemplate();
+    int cardCount = 0;
+    PerfScope scope;
+    for (int i = 0; i < iterations; ++i) {
+        GameModel gameModel = DealEngine::deal(triPeaks, static_cast<uint64_t>(i));
+        cardCount += gameModel.getCards().size();
+    }
+    PerfProbeResult result = makeResult("deal.triPeaks", scope, iterations);
+    CCLOG(u8"PerfRegressionGate: 种子发牌共生成%d张卡牌", cardCount); // 使用结果，避免循环被优化掉
+    return result;
+}
+
+bool PerfRegressionGate::checkAgainstBaseline(const std::vector<PerfProbeResult>& results,
+    const std::string& baselineFile) {
+    std::string jsonStr = cocos2d::FileUtils::getInstance()->getStringFromFile(baselineFile);
+    rapidjson::Document doc;
+    doc.Parse<rapidjson::kParseDefaultFlags>(jsonStr.c_str());
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("Probes") || !doc["Probes"].IsArray()) {
+        CCLOG(u8"PerfRegressionGate: 基线文件%s缺失或格式错误", baselineFile.c_str());
+        return false;
+    }
+
+    const double timeTolerance = readNumber(doc, "TimeTolerance", kDefaultTimeTolerance);
+    const double allocationSlack = readNumber(doc, "AllocationSlack", kDefaultAllocationSlack);
+
+    // 耗时基线只在生成它的参考机与构建配置上可比；分配次数与规模比与机器无关，始终比较
+    const PerfReference current = currentReference();
+    bool compareTime = false;
+    if (doc.HasMember("Reference") && doc["Reference"].IsObject()) {
+        const rapidjson::Value& reference = doc["Reference"];
+        const std::string machine = readString(reference, "Machine");
+        compareTime = !machine.empty() && machine == current.machine &&
+            readString(reference, "Compiler") == current.compiler &&
+            readString(reference, "Build") == current.build &&
+            readString(reference, "MatchKernel") == current.matchKernel;
+        cocos2d::log("[perf] baseline reference: %s / %s / %s / %s", machine.c_str(),
+            readString(reference, "Compiler").c_str(), readString(reference, "Build").c_str(),
+            readString(reference, "MatchKernel").c_str());
+    }
+    cocos2d::log("[perf] this run: %s / %s / %s / %s", current.machine.empty() ? "(unset)" : current.machine.c_str(),
+        current.compiler.c_str(), current.build.c_str(), current.matchKernel.c_str());
+    if (!compareTime) {
+        cocos2d::log("[perf] not the baseline reference (set %s and match its build), ns/op is not compared", kMachineEnv);
+    }
+
+    bool passed = true;
+    const rapidjson::Value& probes = doc["Probes"];
+    for (const auto& result : results) {
+        if (result.name.empty()) {
+            continue; // 被跳过的探针
+        }
+
+        const rapidjson::Value* entry = nullptr;
+        for (rapidjson::SizeType i = 0; i < probes.Size(); ++i) {
+            const rapidjson::Value& node = probes[i];
+            if (node.IsObject() && node.HasMember("Name") && node["Name"].IsString() &&
+                result.name == node["Name"].GetString()) {
+                entry = &node;
+                break;
+            }
+        }
+        if (!entry) {
+            CCLOG(u8"PerfRegressionGate: 基线中没有探针%s，跳过比较", result.name.c_str());
+            continue;
+        }
+
+        // 耗时：超过 基线*(1+容差) 视为退化
+        double baselineNs = readNumber(*entry, "NsPerOp", 0);
+        double tolerance = readNumber(*entry, "TimeTolerance", timeTolerance);
+        if (compareTime && baselineNs > 0 && result.nsPerOp > baselineNs * (1.0 + tolerance)) {
+            cocos2d::log("[perf] REGRESSION %s: %.1f ns/op > baseline %.1f ns/op (+%.0f%%)",
+                result.name.c_str(), result.nsPerOp, baselineNs, tolerance * 100);
+            passed = false;
+        }
+
+        // 分配次数：超过 基线+容差 视为退化（未开启分配统计时不比较）
+        double baselineAllocs = readNumber(*entry, "AllocsPerOp", -1);
+        double slack = readNumber(*entry, "AllocationSlack", allocationSlack);
+        if (baselineAllocs >= 0 && result.allocsPerOp >= 0 && result.allocsPerOp > baselineAllocs + slack) {
+            cocos2d::log("[perf] REGRESSION %s: %.2f allocs/op > baseline %.2f allocs/op",
+                result.name.c_str(), result.allocsPerOp, baselineAllocs);
+            passed = false;
+        }
+
+        // 规模比：与机器快慢无关，用于捕获复杂度退化
+        double maxScaling = readNumber(*entry, "MaxScaling", 0);
+        if (maxScaling > 0 && result.scaling > maxScaling) {
+            cocos2d::log("[perf] REGRESSION %s: scaling %.2f > max %.2f (complexity regression?)",
+                result.name.c_str(), result.scaling, maxScaling);
+            passed = false;
+        }
+    }
+
+    cocos2d::log("[perf] gate %s", passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+bool PerfRegressionGate::writeBaseline(const std::vector<PerfProbeResult>& results, const std::string& outFile) {
+    rapidjson::Document doc;
+    doc.SetObject();
+    auto& allocator = doc.GetAllocator();
+    doc.AddMember("TimeTolerance", kDefaultTimeTolerance, allocator);
+    doc.AddMember("AllocationSlack", kDefaultAllocationSlack, allocator);
+
+    // 记录测量环境，比较时只有同一参考机与构建配置才比较耗时
+    const PerfReference current = currentReference();
+    if (current.machine.empty()) {
+        CCLOG(u8"PerfRegressionGate: 未设置%s，写出的基线不会在任何机器上比较耗时", kMachineEnv);
+    }
+    rapidjson::Value reference(rapidjson::kObjectType);
+    rapidjson::Value machine(current.machine.c_str(), allocator);
+    rapidjson::Value compiler(current.compiler.c_str(), allocator);
+    rapidjson::Value build(current.build.c_str(), allocator);
+    rapidjson::Value matchKernel(current.matchKernel.c_str(), allocator);
+    reference.AddMember("Machine", machine, allocator);
+    reference.AddMember("Compiler", compiler, allocator);
+    reference.AddMember("Build", build, allocator);
+    reference.AddMember("MatchKernel", matchKernel, allocator);
+    doc.AddMember("Reference", reference, allocator);
+
+    rapidjson::Value probes(rapidjson::kArrayType);
+    for (const auto& result : results) {
+        if (result.name.empty()) {
+            continue;
+        }
+        rapidjson::Value entry(rapidjson::kObjectType);
+        rapidjson::Value name(result.name.c_str(), allocator);
+        entry.AddMember("Name", name, allocator);
+        entry.AddMember("NsPerOp", result.nsPerOp, allocator);
+        if (result.allocsPerOp >= 0) {
+            entry.AddMember("AllocsPerOp", result.allocsPerOp, allocator);
+        }
+        if (result.scaling > 0) {
+            // 规模比本身应接近1，留出2倍余量吸收缓存效应
+            entry.AddMember("MaxScaling", 2.0, allocator);
+        }
+        probes.PushBack(entry, allocator);
+    }
+    doc.AddMember("Probes", probes, allocator);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    bool ok = cocos2d::FileUtils::getInstance()->writeStringToFile(buffer.GetString(), outFile);
+    CCLOG(u8"PerfRegressionGate: 基线写入%s %s", outFile.c_str(), ok ? u8"成功" : u8"失败");
+    return ok;
+}
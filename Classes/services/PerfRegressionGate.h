@@ -0,0 +1,89 @@
+#ifndef PERF_REGRESSION_GATE_H_
+#define PERF_REGRESSION_GATE_H_
+
+#include <string>
+#include <vector>
+
+/**
+ * 单个基准探针的测量结果
+ */
+struct PerfProbeResult {
+    std::string name;        // 探针名称，如 "controller.matchCheck"
+    double nsPerOp = 0;      // 单次操作平均耗时（纳秒）
+    double allocsPerOp = -1; // 单次操作平均堆分配次数，未开启分配统计时为-1
+    double scaling = 0;      // 大规模与小规模下单次耗时之比，未做规模对比时为0
+};
+
+/*
+性能回归门禁，无界面运行控制器、加载器和撤销路径的基准测试，并与提交的基线文件比较
+核心功能：
+1. 基准测试：直接驱动GameController / LevelConfigLoader / UndoManager，不创建任何视图
+2. 规模对比：在不同撤销历史长度下测量匹配检查耗时，捕获O(1)路径退化为O(n)的改动
+3. 基线比较：按基线文件中配置的噪声容差判定耗时、分配次数和规模比是否超标；
+   耗时只在基线记录的参考机（环境变量CARD_PERF_GATE_MACHINE）、编译器、构建配置与匹配内核实现都相同时比较，
+   分配次数与规模比与机器无关，始终比较
+4. 基线刷新：将当前测量结果连同测量环境写成新的基线文件
+启用方式：编译时定义CARD_PERF_GATE=1（建议同时定义CARD_PERF_TRACK_ALLOCATIONS=1），
+应用启动后只运行门禁并以退出码报告结果（0通过，1失败）
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class PerfRegressionGate {
+public:
+    /**
+     * 运行全部基准测试并与基线比较
+     * @param levelFile 基准测试使用的关卡文件
+     * @param baselineFile 基线文件路径（相对于资源目录）
+     * @return 全部探针在容差范围内返回true
+     */
+    static bool run(const std::string& levelFile, const std::string& baselineFile);
+
+    /**
+     * 运行全部基准测试（整套重复多轮，每个探针取最快一轮）
+     * @param levelFile 基准测试使用的关卡文件
+     * @return 各探针的测量结果
+     */
+    static std::vector<PerfProbeResult> runBenchmarks(const std::string& levelFile);
+
+    /**
+     * 将测量结果与基线比较，超标项逐条输出到日志
+     * @param results 测量结果
+     * @param baselineFile 基线文件路径
+     * @return 全部探针在容差范围内返回true，基线缺失或格式错误返回false
+     */
+    static bool checkAgainstBaseline(const std::vector<PerfProbeResult>& results,
+        const std::string& baselineFile);
+
+    /**
+     * 把测量结果与测量环境写成基线文件（用于在CI参考机上刷新基线）
+     * @param results 测量结果
+     * @param outFile 输出文件的完整路径
+     * @return 写入成功返回true
+     */
+    static bool writeBaseline(const std::vector<PerfProbeResult>& results, const std::string& outFile);
+
+private:
+    PerfRegressionGate() = default;
+
+    // 整套基准测量一轮
+    static std::vector<PerfProbeResult> runRound(const std::string& levelFile);
+
+    // 关卡加载路径：读取文件、解析JSON并生成配置
+    static PerfProbeResult benchmarkLoader(const std::string& levelFile, int iterations);
+
+    // 控制器匹配检查路径：在给定撤销历史长度下反复执行不匹配的选择操作
+    static PerfProbeResult benchmarkMatchCheck(const std::string& levelFile, int historySize, int iterations);
+
+    // 撤销路径：记录一次Stack区点击后立即撤销
+    static PerfProbeResult benchmarkUndo(const std::string& levelFile, int iterations);
+
+    // 批量匹配内核：以牌堆区首张卡牌为栈顶，反复求出全部可匹配的游戏区卡牌
+    static PerfProbeResult benchmarkMatchKernel(const std::string& levelFile, int iterations);
+
+    // 二进制存档：在给定撤销历史长度下反复编码并解码当前对局
+    static PerfProbeResult benchmarkSaveState(const std::string& levelFile, int historySize, int iterations);
+
+    // 种子发牌：用内置三峰模板按不同种子反复生成对局
+    static PerfProbeResult benchmarkDeal(int iterations);
+};
+
+#endif // PERF_REGRESSION_GATE_H_
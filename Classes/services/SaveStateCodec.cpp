@@ -0,0 +1,452 @@
+#include "services/SaveStateCodec.h"
+#include "services/Crc32.h"
+#include "services/GameLog.h"
+#include "services/LzCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    const uint8_t kFlagCompressed = 0x01;   // 数据体经过LzCodec压缩
+    const size_t kMaxRawSize = 16u << 20;   // 数据体原始长度上限（防止损坏的长度字段导致巨量分配）
+    const int kZoneBits = 2;                // 区域的位宽
+    const int kFaceSuitBits = 6;            // 牌面4位 + 花色2位
+
+    // 字节流写入：varint、zigzag与按位打包
+    class PayloadWriter {
+    public:
+        explicit PayloadWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+        void varint(uint32_t value) {
+            while (value >= 0x80) {
+                _out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            _out.push_back(static_cast<uint8_t>(value));
+        }
+
+        // 有符号数映射为无符号数，绝对值小的数编码短
+        void zigzag(int32_t value) {
+            varint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+        }
+
+        // 按位打包count个值，每个bits位，低位在前
+        template <class Getter>
+        void packed(int count, int bits, Getter get) {
+            uint32_t buffer = 0;
+            int used = 0;
+            for (int i = 0; i < count; ++i) {
+                buffer |= (static_cast<uint32_t>(get(i)) & ((1u << bits) - 1)) << used;
+                used += bits;
+                while (used >= 8) {
+                    _out.push_back(static_cast<uint8_t>(buffer));
+                    buffer >>= 8;
+                    used -= 8;
+                }
+            }
+            if (used > 0) {
+                _out.push_back(static_cast<uint8_t>(buffer));
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& _out;
+    };
+
+    // 字节流读取：所有读取都做边界检查，越界后ok()为false且读数为0
+    class PayloadReader {
+    public:
+        PayloadReader(const uint8_t* data, size_t size) : _data(data), _size(size), _pos(0), _ok(true) {}
+
+        bool ok() const { return _ok; }
+        size_t remaining() const { return _size - _pos; }
+
+        uint32_t varint() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                if (_pos >= _size) {
+                    _ok = false;
+                    return 0;
+                }
+                uint8_t byte = _data[_pos++];
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+            _ok = false;
+            return 0;
+        }
+
+        int32_t zigzag() {
+            uint32_t value = varint();
+            return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+        }
+
+        // 读取按位打包的count个值
+        template <class Setter>
+        void packed(int count, int bits, Setter set) {
+            const size_t bytes = (static_cast<size_t>(count) * bits + 7) / 8;
+            if (bytes > remaining()) {
+                _ok = false;
+                return;
+            }
+            uint32_t buffer = 0;
+            int available = 0;
+            for (int i = 0; i < count; ++i) {
+                while (available < bits) {
+                    buffer |= static_cast<uint32_t>(_data[_pos++]) << available;
+                    available += 8;
+                }
+                set(i, static_cast<int>(buffer & ((1u << bits) - 1)));
+                buffer >>= bits;
+                available -= bits;
+            }
+        }
+
+    private:
+        const uint8_t* _data;
+        size_t _size;
+        size_t _pos;
+        bool _ok;
+    };
+
+    int32_t quantize(float value) {
+        return static_cast<int32_t>(std::lround(value * SaveStateCodec::kPositionScale));
+    }
+
+    float dequantize(int32_t value) {
+        return static_cast<float>(value) / SaveStateCodec::kPositionScale;
+    }
+
+    void writeU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    uint32_t readU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+            (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+}
+
+bool SaveStateCodec::encode(const GameModel& initial, const GameModel& current, int moveCount, int score,
+    std::vector<uint8_t>& out) {
+    out.clear();
+    const CardStore& initialCards = initial.getCards();
+    const CardStore& currentCards = current.getCards();
+    if (initialCards.size() != currentCards.size()) {
+        GLOG_WARN(u8"存档编码失败：初始与当前棋盘卡牌数不同");
+        return false;
+    }
+    for (int slot = 0; slot < initialCards.size(); ++slot) {
+        if (initialCards.getId(slot) != currentCards.getId(slot)) {
+            GLOG_WARN(u8"存档编码失败：槽位%d的卡牌ID不一致", slot);
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> payload;
+    payload.reserve(static_cast<size_t>(initialCards.size()) * 4 + 64);
+    encodePayload(initial, current, moveCount, score, payload);
+
+    std::vector<uint8_t> compressed;
+    LzCodec::compress(payload.data(), payload.size(), compressed);
+    const bool useCompressed = compressed.size() < payload.size();
+
+    // 容器头：魔数、版本、标志、原始长度、原始数据CRC32
+    writeU32(out, kMagic);
+    out.push_back(static_cast<uint8_t>(kVersion));
+    out.push_back(useCompressed ? kFlagCompressed : 0);
+    PayloadWriter(out).varint(static_cast<uint32_t>(payload.size()));
+    writeU32(out, Crc32::compute(payload.data(), payload.size()));
+    const std::vector<uint8_t>& body = useCompressed ? compressed : payload;
+    out.insert(out.end(), body.begin(), body.end());
+    return true;
+}
+
+bool SaveStateCodec::decode(const uint8_t* data, size_t size, SaveState& outState) {
+    if (!data || size < 6 || readU32(data) != kMagic) {
+        GLOG_WARN(u8"存档无效：魔数不符");
+        return false;
+    }
+    if (data[4] != kVersion) {
+        GLOG_WARN(u8"存档版本不受支持：%d", static_cast<int>(data[4]));
+        return false;
+    }
+    const uint8_t flags = data[5];
+    if (flags & ~kFlagCompressed) {
+        GLOG_WARN(u8"存档无效：未知标志 0x%02x", static_cast<unsigned>(flags));
+        return false;
+    }
+
+    PayloadReader header(data + 6, size - 6);
+    const uint32_t rawSize = header.varint();
+    if (!header.ok() || rawSize > kMaxRawSize || header.remaining() < 4) {
+        GLOG_WARN(u8"存档无效：长度字段损坏");
+        return false;
+    }
+    const uint8_t* crcField = data + size - header.remaining();
+    const uint32_t expectedCrc = readU32(crcField);
+    const uint8_t* body = crcField + 4;
+    const size_t bodySize = header.remaining() - 4;
+
+    std::vector<uint8_t> payload;
+    if (flags & kFlagCompressed) {
+        payload.resize(rawSize);
+        if (!LzCodec::decompress(body, bodySize, payload.data(), rawSize)) {
+            GLOG_WARN(u8"存档无效：解压失败");
+            return false;
+        }
+    }
+    else {
+        if (bodySize != rawSize) {
+            GLOG_WARN(u8"存档无效：数据长度不符");
+            return false;
+        }
+        payload.assign(body, body + bodySize);
+    }
+    if (Crc32::compute(payload.data(), payload.size()) != expectedCrc) {
+        GLOG_WARN(u8"存档无效：校验失败");
+        return false;
+    }
+    return decodePayload(payload.data(), payload.size(), outState);
+}
+
+void SaveStateCodec::encodePayload(const GameModel& initial, const GameModel& current, int moveCount, int score,
+    std::vector<uint8_t>& out) {
+    const CardStore& initialCards = initial.getCards();
+    const CardStore& currentCards = current.getCards();
+    const int count = initialCards.size();
+    PayloadWriter writer(out);
+
+    // 规则与卡牌数
+    writer.varint(static_cast<uint32_t>(initial.getRuleParams().variant));
+    writer.zigzag(initial.getRuleParams().wildFace);
+    writer.varint(static_cast<uint32_t>(count));
+
+    // 卡牌ID：与上一张ID+1之差（关卡加载的ID连续，全为0）
+    int previousId = -1;
+    for (int slot = 0; slot < count; ++slot) {
+        writer.zigzag(initialCards.getId(slot) - (previousId + 1));
+        previousId = initialCards.getId(slot);
+    }
+
+    // 牌面与花色、初始区域：按位打包
+    writer.packed(count, kFaceSuitBits, [&](int slot) {
+        return static_cast<int>(initialCards.getFace(slot)) | (static_cast<int>(initialCards.getSuit(slot)) << 4);
+    });
+    writer.packed(count, kZoneBits, [&](int slot) { return static_cast<int>(initialCards.getZone(slot)); });
+
+    // 初始坐标：与上一张卡牌之差
+    int32_t previousX = 0;
+    int32_t previousY = 0;
+    for (int slot = 0; slot < count; ++slot) {
+        const cocos2d::Vec2 position = initialCards.getPosition(slot);
+        const int32_t x = quantize(position.x);
+        const int32_t y = quantize(position.y);
+        writer.zigzag(x - previousX);
+        writer.zigzag(y - previousY);
+        previousX = x;
+        previousY = y;
+    }
+
+    // 当前区域；当前坐标只写与初始不同的卡牌（位图 + 与上一张移动卡牌之差）
+    writer.packed(count, kZoneBits, [&](int slot) { return static_cast<int>(currentCards.getZone(slot)); });
+    auto moved = [&](int slot) {
+        const cocos2d::Vec2 from = initialCards.getPosition(slot);
+        const cocos2d::Vec2 to = currentCards.getPosition(slot);
+        return quantize(from.x) != quantize(to.x) || quantize(from.y) != quantize(to.y);
+    };
+    writer.packed(count, 1, [&](int slot) { return moved(slot) ? 1 : 0; });
+    previousX = 0;
+    previousY = 0;
+    for (int slot = 0; slot < count; ++slot) {
+        if (moved(slot)) {
+            const cocos2d::Vec2 position = currentCards.getPosition(slot);
+            const int32_t x = quantize(position.x);
+            const int32_t y = quantize(position.y);
+            writer.zigzag(x - previousX);
+            writer.zigzag(y - previousY);
+            previousX = x;
+            previousY = y;
+        }
+    }
+
+    // 手牌栈（从底到顶的槽位号）
+    const HandPileModel& hand = current.getHand();
+    writer.varint(static_cast<uint32_t>(hand.size()));
+    for (int i = 0; i < hand.size(); ++i) {
+        writer.varint(static_cast<uint32_t>(currentCards.slotOf(hand.cardAt(i))));
+    }
+
+    // 撤销历史：槽位<<3 | 区域<<1 | 坐标等于初始坐标，坐标不同时再写与初始坐标之差
+    const std::vector<UndoCardState>& history = current.getUndoModel().getHistory();
+    writer.varint(static_cast<uint32_t>(history.size()));
+    for (const auto& state : history) {
+        const int slot = currentCards.slotOf(state.id);
+        const cocos2d::Vec2 home = initialCards.getPosition(slot);
+        const int32_t dx = quantize(state.position.x) - quantize(home.x);
+        const int32_t dy = quantize(state.position.y) - quantize(home.y);
+        const bool atHome = dx == 0 && dy == 0;
+        writer.varint((static_cast<uint32_t>(slot) << 3) | (static_cast<uint32_t>(state.zone) << 1) | (atHome ? 1u : 0u));
+        if (!atHome) {
+            writer.zigzag(dx);
+            writer.zigzag(dy);
+        }
+        writer.zigzag(state.score);
+    }
+
+    // 本局统计
+    writer.varint(static_cast<uint32_t>(moveCount));
+    writer.zigzag(score);
+}
+
+bool SaveStateCodec::decodePayload(const uint8_t* data, size_t size, SaveState& outState) {
+    PayloadReader reader(data, size);
+
+    RuleParams params;
+    const uint32_t variant = reader.varint();
+    params.wildFace = reader.zigzag();
+    const uint32_t count = reader.varint();
+    // 每张卡牌至少占ID、坐标共3字节，借此拒绝损坏的卡牌数
+    if (!reader.ok() || variant >= static_cast<uint32_t>(RuleVariant::Count) || count > size / 3) {
+        GLOG_WARN(u8"存档数据体无效：规则或卡牌数损坏");
+        return false;
+    }
+    params.variant = static_cast<RuleVariant>(variant);
+    const int cardCount = static_cast<int>(count);
+
+    std::vector<int> ids(cardCount);
+    int previousId = -1;
+    for (int slot = 0; slot < cardCount; ++slot) {
+        ids[slot] = previousId + 1 + reader.zigzag();
+        previousId = ids[slot];
+    }
+    std::vector<int> faceSuits(cardCount);
+    std::vector<int> zones(cardCount);
+    reader.packed(cardCount, kFaceSuitBits, [&](int slot, int value) { faceSuits[slot] = value; });
+    reader.packed(cardCount, kZoneBits, [&](int slot, int value) { zones[slot] = value; });
+
+    // 重建初始棋盘（按槽位顺序添加，层级区间按各区域卡牌数划分，原区域层级随之推导）
+    GameModel initial(nullptr);
+    initial.setRuleParams(params);
+    initial.reserveZones(static_cast<int>(std::count(zones.begin(), zones.end(), static_cast<int>(CardZone::Playfield))),
+        static_cast<int>(std::count(zones.begin(), zones.end(), static_cast<int>(CardZone::Stack))));
+    int32_t previousX = 0;
+    int32_t previousY = 0;
+    for (int slot = 0; slot < cardCount && reader.ok(); ++slot) {
+        previousX += reader.zigzag();
+        previousY += reader.zigzag();
+        const int face = faceSuits[slot] & 0x0F;
+        if (face >= static_cast<int>(CardFaceType::CFT_NUM_CARD_FACE_TYPES) || initial.getCards().slotOf(ids[slot]) >= 0) {
+            GLOG_WARN(u8"存档数据体无效：槽位%d的卡牌损坏", slot);
+            return false;
+        }
+        initial.addCard(CardModel(static_cast<CardFaceType>(face), static_cast<CardSuitType>(faceSuits[slot] >> 4),
+            cocos2d::Vec2(dequantize(previousX), dequantize(previousY)), ids[slot], static_cast<CardZone>(zones[slot])));
+    }
+    if (!reader.ok()) {
+        GLOG_WARN(u8"存档数据体无效：卡牌数据不完整");
+        return false;
+    }
+
+    // 当前棋盘：从初始棋盘出发应用区域、坐标
+    GameModel current = initial;
+    CardStore& cards = current.getCards();
+    reader.packed(cardCount, kZoneBits, [&](int slot, int value) { cards.setZone(slot, static_cast<CardZone>(value)); });
+    std::vector<int> moved(cardCount);
+    reader.packed(cardCount, 1, [&](int slot, int value) { moved[slot] = value; });
+    previousX = 0;
+    previousY = 0;
+    for (int slot = 0; slot < cardCount && reader.ok(); ++slot) {
+        if (moved[slot]) {
+            previousX += reader.zigzag();
+            previousY += reader.zigzag();
+            cards.setPosition(slot, cocos2d::Vec2(dequantize(previousX), dequantize(previousY)));
+        }
+    }
+
+    // 手牌栈：入栈即得到手牌区层级
+    const uint32_t handSize = reader.varint();
+    if (handSize > count) {
+        GLOG_WARN(u8"存档数据体无效：手牌数损坏");
+        return false;
+    }
+    for (uint32_t i = 0; i < handSize && reader.ok(); ++i) {
+        const uint32_t slot = reader.varint();
+        if (slot >= count || cards.getZone(slot) != CardZone::Hand) {
+            GLOG_WARN(u8"存档数据体无效：手牌槽位损坏");
+            return false;
+        }
+        cards.setZOrder(slot, current.getHand().push(cards.getId(slot)));
+    }
+
+    // 撤销历史
+    const uint32_t historySize = reader.varint();
+    if (historySize > reader.remaining()) {
+        GLOG_WARN(u8"存档数据体无效：撤销历史长度损坏");
+        return false;
+    }
+    UndoModel& undoModel = current.getUndoModel();
+    for (uint32_t i = 0; i < historySize && reader.ok(); ++i) {
+        const uint32_t packedState = reader.varint();
+        const uint32_t slot = packedState >> 3;
+        if (slot >= count) {
+            GLOG_WARN(u8"存档数据体无效：撤销记录损坏");
+            return false;
+        }
+        UndoCardState state;
+        state.id = cards.getId(slot);
+        state.zone = static_cast<CardZone>((packedState >> 1) & 0x03);
+        state.position = initial.getCards().getPosition(slot);
+        if (!(packedState & 1)) {
+            const int32_t dx = reader.zigzag();
+            const int32_t dy = reader.zigzag();
+            state.position = cocos2d::Vec2(dequantize(quantize(state.position.x) + dx),
+                dequantize(quantize(state.position.y) + dy));
+        }
+        state.score = reader.zigzag();
+        undoModel.record(state);
+    }
+
+    const int moveCount = static_cast<int>(reader.varint());
+    const int score = reader.zigzag();
+    if (!reader.ok()) {
+        GLOG_WARN(u8"存档数据体无效：数据不完整");
+        return false;
+    }
+
+    outState.initial = initial;
+    outState.current = current;
+    outState.moveCount = moveCount;
+    outState.score = score;
+    return true;
+}
+
+bool SaveStateCodec::writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        GLOG_ERROR(u8"存档文件创建失败：%s", path.c_str());
+        return false;
+    }
+    const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    std::fclose(file);
+    return written;
+}
+
+bool SaveStateCodec::readFile(const std::string& path, std::vector<uint8_t>& outData) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    outData.clear();
+    uint8_t buffer[4096];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        outData.insert(outData.end(), buffer, buffer + read);
+    }
+    std::fclose(file);
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef SAVE_STATE_CODEC_H_
+#define SAVE_STATE_CODEC_H_
+
+#include "models/GameModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 解码得到的存档：关卡初始棋盘、当前棋盘（含撤销历史与手牌栈）以及本局统计
+ */
+struct SaveState {
+    GameModel initial = GameModel(nullptr); // 关卡初始棋盘（用于创建视图与重新开始）
+    GameModel current = GameModel(nullptr); // 存档时的棋盘
+    int moveCount = 0;                      // 本局累计移动次数
+    int score = 0;                          // 本局当前得分
+};
+
+/*
+二进制存档编解码：把一局游戏（初始棋盘 + 当前棋盘 + 撤销历史）编码为紧凑的字节块，用于暂停/恢复与测试夹具
+核心功能：
+1. 容器：魔数、版本、标志、原始长度（varint）、原始数据的CRC32，之后是（可选压缩的）数据体；版本不符或校验失败拒绝加载
+2. 数据体：区域每张2位、牌面+花色每张6位按位打包；卡牌ID与坐标写成与前一项之差的zigzag varint
+   （关卡ID连续、坐标成排，差值多为0或很小）；当前坐标只写与初始不同的卡牌；
+   撤销记录的坐标写成与该卡牌初始坐标之差，通常只需一个标志位
+3. 数据体经LzCodec压缩，压缩后不更小时原样保存
+4. 层级不写入：原区域层级由初始区域重新推导，手牌区层级由手牌栈位置推导
+坐标以1/16点为单位量化保存
+采用静态类设计，无需实例化；不使用任何全局状态，可在多个线程上同时编解码
+ */
+class SaveStateCodec {
+public:
+    static const uint32_t kMagic = 0x53534743; // 文件魔数（小端"CGSS"）
+    static const uint8_t kVersion = 1;         // 格式版本
+    static const int kPositionScale = 16;      // 坐标量化倍数（1/16点）
+
+    /**
+     * 编码存档
+     * @param initial 关卡初始棋盘
+     * @param current 当前棋盘，槽位须与初始棋盘一一对应
+     * @param moveCount 本局累计移动次数
+     * @param score 本局当前得分
+     * @param out 输出缓冲区（清空后写入）
+     * @return 两个棋盘卡牌一致返回true
+     */
+    static bool encode(const GameModel& initial, const GameModel& current, int moveCount, int score,
+        std::vector<uint8_t>& out);
+
+    /**
+     * 解码存档
+     * @param data 存档数据
+     * @param size 数据长度
+     * @param outState 输出参数，接收解码结果
+     * @return 魔数、版本、校验均有效且数据完整返回true
+     */
+    static bool decode(const uint8_t* data, size_t size, SaveState& outState);
+
+    /**
+     * 把存档写入文件
+     * @param path 文件路径
+     * @param data 编码后的存档
+     * @return 写入成功返回true
+     */
+    static bool writeFile(const std::string& path, const std::vector<uint8_t>& data);
+
+    /**
+     * 读取存档文件
+     * @param path 文件路径
+     * @param outData 输出参数，接收文件内容
+     * @return 读取成功返回true
+     */
+    static bool readFile(const std::string& path, std::vector<uint8_t>& outData);
+
+private:
+    SaveStateCodec() = default;
+
+    // 编码数据体（压缩前）
+    static void encodePayload(const GameModel& initial, const GameModel& current, int moveCount, int score,
+        std::vector<uint8_t>& out);
+
+    // 解码数据体（解压后）
+    static bool decodePayload(const uint8_t* data, size_t size, SaveState& outState);
+};
+
+#endif // SAVE_STATE_CODEC_H_
@@ -0,0 +1,403 @@
+#include "services/SessionJournal.h"
+#include "services/Crc32.h"
+#include "services/GameLog.h"
+#include "services/PerfMonitor.h"
+#include "cocos2d.h"
+#include <chrono>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    const char* const kJournalFileName = "session.journal"; // 默认日志文件名
+    const char* const kTempSuffix = ".tmp";                  // 压缩时临时文件的后缀
+    const size_t kHeaderFixedSize = 4 + 1 + 2 + 2;           // 魔数 + 版本 + 卡牌数 + 文件名长度
+    const size_t kMaxLevelFileLength = 1024;                 // 文件头中关卡文件名的最大长度
+
+    void writeU16(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void writeU32(std::vector<uint8_t>& out, uint32_t value) {
+        writeU16(out, value & 0xFFFF);
+        writeU16(out, value >> 16);
+    }
+
+    uint32_t readU16(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8);
+    }
+
+    uint32_t readU32(const uint8_t* in) {
+        return readU16(in) | (readU16(in + 2) << 16);
+    }
+
+    // 读取整个文件，文件不存在返回false
+    bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+        uint8_t buffer[4096];
+        size_t read = 0;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            out.insert(out.end(), buffer, buffer + read);
+        }
+        std::fclose(file);
+        return true;
+    }
+
+    // 把文件内容同步到磁盘
+    void syncFile(std::FILE* file) {
+        std::fflush(file);
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+}
+
+SessionJournal::SessionJournal()
+    : _cardCount(0), _eventBus(nullptr), _commandSubscription(-1), _clearedSubscription(-1), _deadEndSubscription(-1),
+      _compactAfterCommand(false), _endAfterCommand(false), _levelEnded(false), _file(nullptr), _unsyncedRecords(0), _lastSyncNs(0),
+      _pendingRecords(0), _rewriteRequested(false), _running(false) {
+}
+
+SessionJournal::~SessionJournal() {
+    stop();
+}
+
+std::string SessionJournal::defaultPath() {
+    return cocos2d::FileUtils::getInstance()->getWritablePath() + kJournalFileName;
+}
+
+void SessionJournal::commandsFromUndo(const UndoModel& undoModel, std::vector<GameCommand>& out) {
+    out.clear();
+    out.reserve(undoModel.getHistory().size());
+    for (const auto& state : undoModel.getHistory()) {
+        out.push_back(state.zone == CardZone::Stack ? GameCommand::drawStack(state.id) : GameCommand::selectPlayfield(state.id));
+    }
+}
+
+void SessionJournal::encodeHeader(const std::string& levelFile, int cardCount, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    const size_t nameLength = levelFile.size() < kMaxLevelFileLength ? levelFile.size() : kMaxLevelFileLength;
+    writeU32(out, kMagic);
+    out.push_back(static_cast<uint8_t>(kVersion));
+    writeU16(out, static_cast<uint32_t>(cardCount));
+    writeU16(out, static_cast<uint32_t>(nameLength));
+    out.insert(out.end(), levelFile.begin(), levelFile.begin() + nameLength);
+    writeU32(out, Crc32::compute(out.data() + start, out.size() - start));
+}
+
+void SessionJournal::encodeRecord(const GameCommand& command, std::vector<uint8_t>& out) {
+    uint8_t bytes[GameCommand::kSerializedSize];
+    command.serialize(bytes);
+    out.insert(out.end(), bytes, bytes + sizeof(bytes));
+    writeU32(out, Crc32::compute(bytes, sizeof(bytes)));
+}
+
+bool SessionJournal::recover(const std::string& path, JournalContents& outContents) {
+    // 压缩在替换原日志的间隙被打断时，只剩下临时文件
+    std::vector<uint8_t> data;
+    if (!readFile(path, data) && !readFile(path + kTempSuffix, data)) {
+        return false;
+    }
+
+    // 文件头
+    if (data.size() < kHeaderFixedSize + 4 || readU32(data.data()) != kMagic || data[4] != kVersion) {
+        GLOG_WARN(u8"会话日志文件头无效，忽略 - 长度：%d", static_cast<int>(data.size()));
+        return false;
+    }
+    const size_t nameLength = readU16(data.data() + 7);
+    const size_t headerSize = kHeaderFixedSize + nameLength + 4;
+    if (data.size() < headerSize ||
+        readU32(data.data() + headerSize - 4) != Crc32::compute(data.data(), headerSize - 4)) {
+        GLOG_WARN(u8"会话日志文件头校验失败，忽略");
+        return false;
+    }
+    outContents.cardCount = static_cast<int>(readU16(data.data() + 5));
+    outContents.levelFile.assign(reinterpret_cast<const char*>(data.data() + kHeaderFixedSize), nameLength);
+
+    // 定长记录：遇到不完整或校验失败的记录即停止
+    outContents.commands.clear();
+    size_t offset = headerSize;
+    while (offset + kRecordSize <= data.size()) {
+        const uint8_t* record = data.data() + offset;
+        GameCommand command;
+        if (readU32(record + GameCommand::kSerializedSize) != Crc32::compute(record, GameCommand::kSerializedSize) ||
+            !GameCommand::deserialize(record, GameCommand::kSerializedSize, command)) {
+            break;
+        }
+        outContents.commands.push_back(command);
+        offset += kRecordSize;
+    }
+    outContents.discardedBytes = data.size() - offset;
+    if (outContents.discardedBytes > 0) {
+        GLOG_WARN(u8"会话日志末尾有%d字节损坏，已丢弃", static_cast<int>(outContents.discardedBytes));
+    }
+    return true;
+}
+
+bool SessionJournal::start(const std::string& path, const std::string& levelFile, int cardCount,
+    const std::vector<GameCommand>& history, GameEventBus* eventBus) {
+    stop();
+    _path = path;
+    _levelFile = levelFile;
+    _cardCount = cardCount;
+    _compactAfterCommand = false;
+    _endAfterCommand = false;
+    _levelEnded = false;
+    _effective.clear();
+    for (const auto& command : history) {
+        track(command);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.clear();
+        _pendingRecords = 0;
+        _rewriteRequested = true; // 先以有效序列重写，同时截掉上次会话损坏的尾部
+        _rewriteCommands = _effective;
+        _running = true;
+    }
+    _worker = std::thread(&SessionJournal::run, this);
+
+    _eventBus = eventBus;
+    if (_eventBus) {
+        _commandSubscription = _eventBus->subscribe<CommandAppliedEvent>([this](const CommandAppliedEvent& event) {
+            onCommandApplied(event);
+        });
+        // 关卡结束事件在触发它的那条指令的CommandAppliedEvent之前发布，先标记，处理完该指令再截断
+        _clearedSubscription = _eventBus->subscribe<LevelClearedEvent>([this](const LevelClearedEvent&) {
+            _endAfterCommand = true;
+        });
+        _deadEndSubscription = _eventBus->subscribe<NoMovesLeftEvent>([this](const NoMovesLeftEvent&) {
+            _endAfterCommand = true;
+        });
+    }
+    GLOG_INFO(u8"会话日志已开始 - 关卡：%s，已有指令：%d", levelFile.c_str(), static_cast<int>(_effective.size()));
+    return true;
+}
+
+void SessionJournal::stop() {
+    if (_eventBus) {
+        _eventBus->unsubscribe<CommandAppliedEvent>(_commandSubscription);
+        _eventBus->unsubscribe<LevelClearedEvent>(_clearedSubscription);
+        _eventBus->unsubscribe<NoMovesLeftEvent>(_deadEndSubscription);
+        _eventBus = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _wake.notify_one();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+void SessionJournal::append(const GameCommand& command) {
+    track(command);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        encodeRecord(command, _pending);
+        ++_pendingRecords;
+    }
+    _wake.notify_one();
+}
+
+void SessionJournal::compact() {
+    requestRewrite(_effective);
+}
+
+void SessionJournal::requestRewrite(const std::vector<GameCommand>& commands) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // 新序列已包含或作废了尚未写出的记录，重写后这些记录不必再追加
+        _pending.clear();
+        _pendingRecords = 0;
+        _rewriteRequested = true;
+        _rewriteCommands = commands;
+    }
+    _wake.notify_one();
+}
+
+void SessionJournal::onCommandApplied(const CommandAppliedEvent& event) {
+    if (event.accepted) {
+        const bool reopens = event.command.type == GameCommandType::Undo ||
+            event.command.type == GameCommandType::UndoTo || event.command.type == GameCommandType::Restart;
+        if (_levelEnded) {
+            // 磁盘上只有文件头，只更新有效序列；撤销或重新开始使对局继续，以有效序列重写
+            track(event.command);
+            if (reopens) {
+                _levelEnded = false;
+                _compactAfterCommand = true;
+            }
+        }
+        else {
+            append(event.command);
+            // 重新开始后旧记录全部作废，直接压缩为只有文件头
+            if (event.command.type == GameCommandType::Restart) {
+                _compactAfterCommand = true;
+            }
+        }
+    }
+    if (_endAfterCommand) {
+        // 已结束的对局不应在下次启动时恢复：只保留文件头，有效序列留在内存中供结束后撤销
+        _endAfterCommand = false;
+        _compactAfterCommand = false;
+        _levelEnded = true;
+        requestRewrite(std::vector<GameCommand>());
+    }
+    else if (_compactAfterCommand) {
+        _compactAfterCommand = false;
+        compact();
+    }
+}
+
+void SessionJournal::track(const GameCommand& command) {
+    switch (command.type) {
+    case GameCommandType::SelectPlayfield:
+    case GameCommandType::DrawStack:
+        _effective.push_back(command);
+        break;
+    case GameCommandType::Undo:
+        if (!_effective.empty()) {
+            _effective.pop_back();
+        }
+        break;
+    case GameCommandType::UndoTo:
+        // 每次移动恰好记录一条撤销状态，历史长度即有效移动数
+        if (command.cardId >= 0 && static_cast<size_t>(command.cardId) < _effective.size()) {
+            _effective.resize(command.cardId);
+        }
+        break;
+    case GameCommandType::Restart:
+        _effective.clear();
+        break;
+    default:
+        break;
+    }
+}
+
+void SessionJournal::run() {
+    std::vector<uint8_t> bytes;
+    std::vector<GameCommand> rewriteCommands;
+    for (;;) {
+        bool needRewrite = false;
+        bool running = true;
+        size_t records = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            // 有未同步的记录时按同步间隔定时醒来
+            auto ready = [this] { return !_pending.empty() || _rewriteRequested || !_running; };
+            if (_unsyncedRecords > 0) {
+                _wake.wait_for(lock, std::chrono::milliseconds(kSyncIntervalMs), ready);
+            }
+            else {
+                _wake.wait(lock, ready);
+            }
+            // 重写请求之前的记录已包含在有效序列中，之后的记录在重写完成后追加
+            if (_rewriteRequested) {
+                needRewrite = true;
+                rewriteCommands.swap(_rewriteCommands);
+                _rewriteRequested = false;
+            }
+            bytes.swap(_pending);
+            records = _pendingRecords;
+            _pendingRecords = 0;
+            running = _running;
+        }
+
+        if (needRewrite) {
+            rewrite(rewriteCommands);
+        }
+        writeBytes(bytes, records);
+        bytes.clear();
+
+        if (!running) {
+            break;
+        }
+    }
+
+    if (_file) {
+        sync();
+        std::fclose(_file);
+        _file = nullptr;
+    }
+}
+
+bool SessionJournal::rewrite(const std::vector<GameCommand>& commands) {
+    if (_file) {
+        std::fclose(_file);
+        _file = nullptr;
+    }
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(kHeaderFixedSize + _levelFile.size() + 4 + commands.size() * kRecordSize);
+    encodeHeader(_levelFile, _cardCount, bytes);
+    for (const auto& command : commands) {
+        encodeRecord(command, bytes);
+    }
+
+    // 先写临时文件并同步，再替换原日志，任何时刻磁盘上都有一份完整的日志
+    const std::string tempPath = _path + kTempSuffix;
+    std::FILE* temp = std::fopen(tempPath.c_str(), "wb");
+    if (!temp) {
+        GLOG_ERROR(u8"会话日志临时文件创建失败：%s", tempPath.c_str());
+        return false;
+    }
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), temp) == bytes.size();
+    syncFile(temp);
+    std::fclose(temp);
+    if (!written) {
+        GLOG_ERROR(u8"会话日志临时文件写入失败：%s", tempPath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    // Windows上rename不能覆盖已有文件；两步之间被打断时recover会读取临时文件
+    std::remove(_path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), _path.c_str()) != 0) {
+        GLOG_ERROR(u8"会话日志替换失败：%s", _path.c_str());
+        return false;
+    }
+
+    _file = std::fopen(_path.c_str(), "ab");
+    _unsyncedRecords = 0;
+    _lastSyncNs = PerfMonitor::nowNs();
+    GLOG_DEBUG(u8"会话日志已压缩 - 有效指令：%d，字节数：%d", static_cast<int>(commands.size()), static_cast<int>(bytes.size()));
+    return _file != nullptr;
+}
+
+void SessionJournal::writeBytes(const std::vector<uint8_t>& bytes, size_t recordCount) {
+    if (!_file) {
+        return;
+    }
+    if (!bytes.empty()) {
+        if (std::fwrite(bytes.data(), 1, bytes.size(), _file) != bytes.size()) {
+            GLOG_ERROR(u8"会话日志写入失败：%s", _path.c_str());
+        }
+        // 交给操作系统即可在进程被杀后保留；fsync按批次进行
+        std::fflush(_file);
+        _unsyncedRecords += static_cast<int>(recordCount);
+    }
+    if (_unsyncedRecords >= kSyncBatch ||
+        (_unsyncedRecords > 0 && PerfMonitor::nowNs() - _lastSyncNs >= static_cast<uint64_t>(kSyncIntervalMs) * 1000000ULL)) {
+        sync();
+    }
+}
+
+void SessionJournal::sync() {
+    if (_file && _unsyncedRecords > 0) {
+        syncFile(_file);
+    }
+    _unsyncedRecords = 0;
+    _lastSyncNs = PerfMonitor::nowNs();
+}
@@ -0,0 +1,174 @@
+#ifndef SESSION_JOURNAL_H_
+#define SESSION_JOURNAL_H_
+
+#include "models/GameCommand.h"
+#include "models/UndoModel.h"
+#include "services/GameEventBus.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 从会话日志恢复出的内容
+ */
+struct JournalContents {
+    std::string levelFile;              // 关卡文件
+    int cardCount = 0;                  // 关卡卡牌数（恢复时与重新加载的关卡核对）
+    std::vector<GameCommand> commands;  // 按执行顺序排列的已生效指令
+    size_t discardedBytes = 0;          // 末尾被丢弃的字节数（进程被杀时写了一半的记录）
+};
+
+/*
+会话日志：把每条生效的玩家指令追加为一条带校验的小记录，进程被杀后据此恢复棋盘与撤销历史
+核心功能：
+1. 订阅事件总线的CommandAppliedEvent，只记录被规则接受的指令；主线程只把13字节记录拷入待写缓冲区，不做I/O
+2. 后台线程批量写入：每批写入后立即fflush（进程被杀不丢数据），
+   累计kSyncBatch条或距上次同步超过kSyncIntervalMs时才fsync（断电最多丢一小批）
+3. 文件格式：文件头（魔数、版本、卡牌数、关卡文件名、CRC32）+ 定长记录（指令9字节 + CRC32）；
+   恢复时遇到长度不足或校验失败的记录即停止，之前的记录全部可用
+4. 压缩：同步维护"有效指令"序列（撤销抵消对应的移动，重新开始清空），重新开始时
+   由后台线程把有效序列写入临时文件再替换原日志；重放有效序列得到同样的棋盘与撤销历史
+5. 关卡结束（过关或死局）时日志截断为只有文件头，下次启动从关卡初始状态开始，不再恢复已结束的棋盘；
+   结束后撤销使对局继续时，再以有效序列重写日志
+ */
+class SessionJournal {
+public:
+    static const uint32_t kMagic = 0x4A534743;     // 文件魔数（小端"CGSJ"）
+    static const uint8_t kVersion = 1;             // 格式版本
+    static const size_t kRecordSize = GameCommand::kSerializedSize + 4; // 记录长度：指令 + CRC32
+    static const int kSyncBatch = 32;              // 累计多少条记录后fsync
+    static const int kSyncIntervalMs = 200;        // 有未同步记录时最长多久fsync一次（毫秒）
+
+    SessionJournal();
+
+    /**
+     * 析构函数：退订事件、写完剩余记录并同步后停止后台线程
+     */
+    ~SessionJournal();
+
+    SessionJournal(const SessionJournal&) = delete;
+    SessionJournal& operator=(const SessionJournal&) = delete;
+
+    /**
+     * 获取默认日志路径（可写目录下的session.journal）
+     * @return 日志文件路径
+     */
+    static std::string defaultPath();
+
+    /**
+     * 读取并校验日志（启动时调用）
+     * @param path 日志文件路径（不存在时尝试压缩中途留下的临时文件）
+     * @param outContents 输出参数，接收恢复出的关卡与指令
+     * @return 文件头有效返回true
+     */
+    static bool recover(const std::string& path, JournalContents& outContents);
+
+    /**
+     * 开始记录：以已有的指令历史为起点重写日志（同时完成压缩、截掉损坏的尾部），启动后台线程并订阅事件
+     * @param path 日志文件路径
+     * @param levelFile 关卡文件
+     * @param cardCount 关卡卡牌数
+     * @param history 已重放的指令（新对局为空）
+     * @param eventBus 事件总线（不持有，须比日志后析构），为nullptr时只能手动append
+     * @return 后台线程启动成功返回true
+     */
+    bool start(const std::string& path, const std::string& levelFile, int cardCount,
+        const std::vector<GameCommand>& history, GameEventBus* eventBus);
+
+    /**
+     * 停止记录：退订事件，写完并同步剩余记录后结束后台线程（可重复调用）
+     */
+    void stop();
+
+    /**
+     * 追加一条已生效的指令（主线程调用，只拷贝到待写缓冲区）
+     * @param command 已生效的指令
+     */
+    void append(const GameCommand& command);
+
+    /**
+     * 请求压缩：把当前有效指令序列交给后台线程重写日志
+     */
+    void compact();
+
+    /**
+     * 获取当前有效指令序列（撤销、重新开始已抵消）
+     * @return 有效指令序列
+     */
+    const std::vector<GameCommand>& getEffectiveCommands() const { return _effective; }
+
+    /**
+     * 由撤销历史推出有效指令序列（每条撤销记录对应一次移动），载入存档后以此作为日志的起点
+     * @param undoModel 撤销模型
+     * @param out 输出参数，接收有效指令序列（清空后写入）
+     */
+    static void commandsFromUndo(const UndoModel& undoModel, std::vector<GameCommand>& out);
+
+    /**
+     * 编码文件头
+     * @param levelFile 关卡文件
+     * @param cardCount 关卡卡牌数
+     * @param out 输出缓冲区（追加）
+     */
+    static void encodeHeader(const std::string& levelFile, int cardCount, std::vector<uint8_t>& out);
+
+    /**
+     * 编码一条记录
+     * @param command 指令
+     * @param out 输出缓冲区（追加）
+     */
+    static void encodeRecord(const GameCommand& command, std::vector<uint8_t>& out);
+
+private:
+    // 后台线程主循环
+    void run();
+
+    // 事件回调：记录生效的指令，重新开始后立即压缩，关卡结束后截断为只有文件头
+    void onCommandApplied(const CommandAppliedEvent& event);
+
+    // 请求后台线程以给定指令序列重写日志，丢弃尚未写出的记录
+    void requestRewrite(const std::vector<GameCommand>& commands);
+
+    // 按指令更新有效序列
+    void track(const GameCommand& command);
+
+    // 以有效序列重写日志（后台线程），成功后以追加方式重新打开
+    bool rewrite(const std::vector<GameCommand>& commands);
+
+    // 把数据写入文件并按批次决定是否fsync（后台线程）
+    void writeBytes(const std::vector<uint8_t>& bytes, size_t recordCount);
+
+    // 把已写入的数据同步到磁盘（后台线程）
+    void sync();
+
+    std::string _path;                      // 日志文件路径
+    std::string _levelFile;                 // 关卡文件
+    int _cardCount;                         // 关卡卡牌数
+    GameEventBus* _eventBus;                // 事件总线（不持有）
+    int _commandSubscription;               // CommandAppliedEvent订阅句柄
+    int _clearedSubscription;               // LevelClearedEvent订阅句柄
+    int _deadEndSubscription;               // NoMovesLeftEvent订阅句柄
+    bool _compactAfterCommand;              // 已重新开始，记录完当前指令后压缩
+    bool _endAfterCommand;                  // 关卡已结束，记录完当前指令后截断
+    bool _levelEnded;                       // 日志已截断为只有文件头，撤销或重新开始前不再追加记录
+    std::vector<GameCommand> _effective;    // 有效指令序列（仅主线程访问）
+
+    std::FILE* _file;                       // 日志文件（仅后台线程访问）
+    int _unsyncedRecords;                   // 已写入但未fsync的记录数（仅后台线程访问）
+    uint64_t _lastSyncNs;                   // 上次fsync的时刻（仅后台线程访问）
+
+    std::mutex _mutex;                      // 保护以下待写状态
+    std::condition_variable _wake;          // 唤醒后台线程
+    std::vector<uint8_t> _pending;          // 待写入的记录
+    size_t _pendingRecords;                 // 待写入的记录数
+    bool _rewriteRequested;                 // 有待执行的重写
+    std::vector<GameCommand> _rewriteCommands; // 重写使用的有效序列
+    bool _running;                          // 后台线程运行标记
+    std::thread _worker;                    // 后台写入线程
+};
+
+#endif // SESSION_JOURNAL_H_
@@ -0,0 +1,283 @@
+#include "services/SolutionTable.h"
+#include "models/BoardSnapshot.h"
+#include "services/GameLog.h"
+#include "cocos2d.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    const char kLevelSuffix[] = ".json";        // 关卡文件扩展名
+    const char kTableSuffix[] = ".hints";       // 提示表文件扩展名
+    const size_t kHeaderSize = 32;              // 表头字节数
+    const size_t kEntrySize = 12;               // 表项字节数：键8 + 卡牌ID 2 + 标志1 + 步数1
+    const uint8_t kFromStackFlag = 0x01;        // 走法为翻开牌堆区卡牌
+    const uint32_t kMinCapacity = 16;           // 散列表最小容量
+
+    // 卡牌键：由卡牌ID经splitmix64混合得到，离线与运行时无需共享随机表
+    uint64_t mixKey(uint64_t value) {
+        uint64_t z = value * 0x9e3779b97f4a7c15ULL + 0x632be59bd9b4e019ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void writeU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void writeU64(uint8_t* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    uint32_t readU32(const uint8_t* in) {
+        uint32_t value = 0;
+        for (int i = 3; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    uint64_t readU64(const uint8_t* in) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    // 走法是否可在当前局面执行：游戏区卡牌须能与手牌栈顶匹配，牌堆区卡牌可直接翻开
+    bool isLegal(const GameModel& model, const HintMove& move, std::vector<uint64_t>& mask) {
+        const CardStore& cards = model.getCards();
+        const int slot = cards.slotOf(move.cardId);
+        if (slot < 0) {
+            return false;
+        }
+        if (move.fromStack) {
+            return cards.getZone(slot) == CardZone::Stack;
+        }
+        return cards.getZone(slot) == CardZone::Playfield && model.findPlayableCards(mask) > 0 &&
+            ((mask[slot / 64] >> (slot % 64)) & 1) != 0;
+    }
+
+    void applyMove(GameModel& model, const HintMove& move) {
+        model.moveCard(move.cardId, CardZone::Hand);
+        model.getHand().push(move.cardId);
+    }
+
+    /**
+     * 沿参考解的剩余走法（跳过已被偏离一步拿走的卡牌）继续走，不搜索
+     * @return 清空了游戏区时返回第一步走法（depth为总步数），否则返回无效走法
+     */
+    HintMove replayRemaining(GameModel model, const std::vector<HintMove>& solution, int nextStep, int takenId,
+        std::vector<uint64_t>& mask) {
+        HintMove first;
+        int plies = 0;
+        for (int step = nextStep; step < static_cast<int>(solution.size()); ++step) {
+            if (solution[step].cardId == takenId) {
+                continue;
+            }
+            if (!isLegal(model, solution[step], mask)) {
+                return HintMove();
+            }
+            if (plies++ == 0) {
+                first = solution[step];
+            }
+            applyMove(model, solution[step]);
+        }
+        if (plies == 0 || !model.getCards().getZoneMembers(CardZone::Playfield).empty()) {
+            return HintMove();
+        }
+        first.depth = plies;
+        return first;
+    }
+
+    /**
+     * 由求解器逐步选择走法把局面走到底（置换表在同一关卡的连续局面之间保留，后续各步多为命中）
+     * @return 清空了游戏区时返回第一步走法（depth为总步数），否则返回无效走法
+     */
+    HintMove playOut(GameModel model, BoardSolver& solver, uint64_t nodeLimit) {
+        HintMove first;
+        int plies = 0;
+        while (!model.getCards().getZoneMembers(CardZone::Playfield).empty()) {
+            HintMove move = solver.solveNodes(*BoardSnapshot::capture(model), nodeLimit).best;
+            if (!move.isValid()) {
+                return HintMove(); // 死局或求解器判定必输
+            }
+            if (plies++ == 0) {
+                first = move;
+            }
+            applyMove(model, move);
+        }
+        first.depth = plies;
+        return first;
+    }
+}
+
+SolutionTable::SolutionTable(const std::string& file)
+    : _file(file), _loaded(false), _capacity(0), _entryCount(0) {
+}
+
+std::string SolutionTable::fileForLevel(const std::string& levelFile) {
+    const size_t suffixLength = sizeof(kLevelSuffix) - 1;
+    if (levelFile.size() <= suffixLength ||
+        levelFile.compare(levelFile.size() - suffixLength, suffixLength, kLevelSuffix) != 0) {
+        return std::string();
+    }
+    return levelFile.substr(0, levelFile.size() - suffixLength) + kTableSuffix;
+}
+
+uint64_t SolutionTable::stateKey(const GameModel& model) {
+    const CardStore& cards = model.getCards();
+    uint64_t key = 0;
+    for (int slot : cards.getZoneMembers(CardZone::Hand)) {
+        key ^= mixKey(static_cast<uint64_t>(cards.getId(slot)) * 2 + 1);
+    }
+    if (!model.getHand().empty()) {
+        key ^= mixKey(static_cast<uint64_t>(model.getHand().top()) * 2 + 2);
+    }
+    return key != 0 ? key : 1; // 0表示空槽
+}
+
+bool SolutionTable::lookup(const GameModel& model, HintMove& outMove) {
+    if (!_loaded) {
+        load(model);
+    }
+    if (_capacity == 0) {
+        return false;
+    }
+
+    const uint64_t key = stateKey(model);
+    const uint8_t* entries = _data.data() + kHeaderSize;
+    for (uint32_t probe = 0, index = static_cast<uint32_t>(key) & (_capacity - 1); probe < _capacity;
+        ++probe, index = (index + 1) & (_capacity - 1)) {
+        const uint8_t* entry = entries + static_cast<size_t>(index) * kEntrySize;
+        const uint64_t entryKey = readU64(entry);
+        if (entryKey == 0) {
+            return false;
+        }
+        if (entryKey == key) {
+            outMove.cardId = entry[8] | (entry[9] << 8);
+            outMove.fromStack = (entry[10] & kFromStackFlag) != 0;
+            outMove.depth = entry[11];
+            return true;
+        }
+    }
+    return false;
+}
+
+void SolutionTable::load(const GameModel& model) {
+    _loaded = true;
+    cocos2d::FileUtils* fileUtils = cocos2d::FileUtils::getInstance();
+    if (_file.empty() || !fileUtils->isFileExist(_file)) {
+        return; // 没有随关卡发布提示表
+    }
+    cocos2d::Data fileData = fileUtils->getDataFromFile(_file);
+    if (fileData.isNull()) {
+        return;
+    }
+    _data.assign(fileData.getBytes(), fileData.getBytes() + fileData.getSize());
+
+    // 表头：魔数、版本、关卡标识、卡牌数、容量、表项数
+    const uint32_t capacity = _data.size() >= kHeaderSize ? readU32(&_data[20]) : 0;
+    const uint64_t levelKey = BoardSnapshot::capture(model)->getLevelKey();
+    if (_data.size() < kHeaderSize || readU32(&_data[0]) != kMagic || readU32(&_data[4]) != kVersion ||
+        readU64(&_data[8]) != levelKey || readU32(&_data[16]) != static_cast<uint32_t>(model.getCards().size()) ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        _data.size() != kHeaderSize + static_cast<size_t>(capacity) * kEntrySize) {
+        GLOG_WARN(u8"提示表无效或与关卡不符 - 文件：%s", _file.c_str());
+        _data.clear();
+        return;
+    }
+    _capacity = capacity;
+    _entryCount = readU32(&_data[24]);
+    GLOG_INFO(u8"提示表已加载 - 文件：%s，局面数：%u", _file.c_str(), _entryCount);
+}
+
+uint32_t SolutionTable::build(const GameModel& initial, const std::vector<HintMove>& solution, BoardSolver& solver,
+    uint64_t nodeLimit, std::vector<uint8_t>& out) {
+    std::unordered_map<uint64_t, HintMove> entries;
+    std::vector<uint64_t> mask;
+    GameModel model = initial;
+    const int solutionLength = static_cast<int>(solution.size());
+    for (int step = 0; step < solutionLength; ++step) {
+        const HintMove& mainMove = solution[step];
+        if (!isLegal(model, mainMove, mask)) {
+            return 0;
+        }
+        HintMove recorded = mainMove;
+        recorded.depth = solutionLength - step;
+        entries[stateKey(model)] = recorded; // 路线上的局面优先于先前记下的同键偏离局面
+
+        // 偏离一步：每张可匹配的游戏区卡牌与牌堆顶；沿参考解的剩余走法或由求解器能走到清空时记下其第一步
+        const CardStore& cards = model.getCards();
+        std::vector<HintMove> alternatives;
+        if (model.findPlayableCards(mask) > 0) {
+            for (int slot : cards.getZoneMembers(CardZone::Playfield)) {
+                if ((mask[slot / 64] >> (slot % 64)) & 1) {
+                    HintMove move;
+                    move.cardId = cards.getId(slot);
+                    alternatives.push_back(move);
+                }
+            }
+        }
+        const std::vector<int>& stackSlots = cards.getZoneMembers(CardZone::Stack);
+        if (!stackSlots.empty()) {
+            HintMove move;
+            move.cardId = cards.getId(stackSlots.back());
+            move.fromStack = true;
+            alternatives.push_back(move);
+        }
+        for (const HintMove& alternative : alternatives) {
+            if (alternative.cardId == mainMove.cardId) {
+                continue;
+            }
+            GameModel child = model;
+            applyMove(child, alternative);
+            const uint64_t childKey = stateKey(child);
+            if (child.getCards().getZoneMembers(CardZone::Playfield).empty() || entries.count(childKey) != 0) {
+                continue;
+            }
+            HintMove proven = replayRemaining(child, solution, step, alternative.cardId, mask);
+            if (!proven.isValid()) {
+                proven = playOut(child, solver, nodeLimit);
+            }
+            if (proven.isValid()) {
+                entries.emplace(childKey, proven);
+            }
+        }
+        applyMove(model, mainMove);
+    }
+    if (!model.getCards().getZoneMembers(CardZone::Playfield).empty()) {
+        return 0;
+    }
+
+    // 开放寻址：容量为不小于两倍表项数的2的幂，线性探测
+    uint32_t capacity = kMinCapacity;
+    while (capacity < entries.size() * 2) {
+        capacity <<= 1;
+    }
+    out.assign(kHeaderSize + static_cast<size_t>(capacity) * kEntrySize, 0);
+    writeU32(&out[0], kMagic);
+    writeU32(&out[4], kVersion);
+    writeU64(&out[8], BoardSnapshot::capture(initial)->getLevelKey());
+    writeU32(&out[16], static_cast<uint32_t>(initial.getCards().size()));
+    writeU32(&out[20], capacity);
+    writeU32(&out[24], static_cast<uint32_t>(entries.size()));
+    for (const auto& item : entries) {
+        uint32_t index = static_cast<uint32_t>(item.first) & (capacity - 1);
+        while (readU64(&out[kHeaderSize + static_cast<size_t>(index) * kEntrySize]) != 0) {
+            index = (index + 1) & (capacity - 1);
+        }
+        uint8_t* entry = &out[kHeaderSize + static_cast<size_t>(index) * kEntrySize];
+        writeU64(entry, item.first);
+        entry[8] = static_cast<uint8_t>(item.second.cardId);
+        entry[9] = static_cast<uint8_t>(item.second.cardId >> 8);
+        entry[10] = item.second.fromStack ? kFromStackFlag : 0;
+        entry[11] = static_cast<uint8_t>(std::min(item.second.depth, 255));
+    }
+    return static_cast<uint32_t>(entries.size());
+}
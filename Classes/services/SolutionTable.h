@@ -0,0 +1,83 @@
+#ifndef SOLUTION_TABLE_H_
+#define SOLUTION_TABLE_H_
+
+#include "models/GameModel.h"
+#include "services/BoardSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+关卡提示表：离线为一个关卡预先算好的"局面 -> 最佳走法"表，随关卡文件发布（level_1.json对应level_1.hints）
+核心功能：
+1. 收录参考解路线上的每个局面，以及从路线上任一局面偏离一步后、求解器仍能证明可解的局面
+2. 局面键只取决于哪些卡牌已进入手牌区与手牌栈顶，与走法顺序无关（Zobrist异或，按卡牌ID固定生成，离线与运行时一致）；
+   表为开放寻址散列（容量为2的幂、负载不超过一半），按原样存盘，加载后不再建表，查询为O(1)
+3. 延迟加载：构造时只记下文件名，第一次查询时才读取并校验（魔数、版本、长度、关卡标识与卡牌数），
+   文件不存在或与关卡不符时视为空表，所有查询落空，由调用方回退到BoardSolver实时搜索
+4. 离线生成（build）供关卡流水线调用，运行时只读
+只能在主线程查询
+ */
+class SolutionTable {
+public:
+    static const uint32_t kMagic = 0x54484743;  // 文件魔数（小端"CGHT"）
+    static const uint32_t kVersion = 1;         // 格式版本
+
+    /**
+     * 构造函数（不读取文件）
+     * @param file 提示表文件路径（相对于资源目录）
+     */
+    explicit SolutionTable(const std::string& file);
+
+    SolutionTable(const SolutionTable&) = delete;
+    SolutionTable& operator=(const SolutionTable&) = delete;
+
+    /**
+     * 由关卡文件名得出提示表文件名（.json替换为.hints）
+     * @param levelFile 关卡配置文件路径
+     * @return 提示表文件路径，非.json关卡（如种子发牌）返回空字符串
+     */
+    static std::string fileForLevel(const std::string& levelFile);
+
+    /**
+     * 查询当前局面的最佳走法（首次调用时加载文件）
+     * @param model 当前棋盘
+     * @param outMove 输出参数，接收走法（depth为清空游戏区还需的步数）
+     * @return 局面在表中返回true
+     */
+    bool lookup(const GameModel& model, HintMove& outMove);
+
+    /**
+     * 已加载的表项数（尚未加载或加载失败为0）
+     * @return 表项数
+     */
+    uint32_t getEntryCount() const { return _entryCount; }
+
+    /**
+     * 离线生成提示表
+     * @param initial 关卡初始棋盘
+     * @param solution 从初始棋盘清空游戏区的走法序列
+     * @param solver 求解偏离局面用的求解器（同步搜索，逐步走到底以证明可解）
+     * @param nodeLimit 求解偏离局面时每步的搜索节点数上限（按节点数而非时间，生成结果可复现）
+     * @param out 输出缓冲区（清空后写入文件内容）
+     * @return 收录的局面数；走法序列不合法或不能清空游戏区时返回0
+     */
+    static uint32_t build(const GameModel& initial, const std::vector<HintMove>& solution, BoardSolver& solver,
+        uint64_t nodeLimit, std::vector<uint8_t>& out);
+
+private:
+    // 局面键：手牌区各卡牌的键与栈顶键异或（不为0）
+    static uint64_t stateKey(const GameModel& model);
+
+    // 读取并校验文件
+    void load(const GameModel& model);
+
+    const std::string _file;        // 提示表文件路径
+    bool _loaded;                   // 是否已尝试加载
+    std::vector<uint8_t> _data;     // 文件内容（表头 + 散列表）
+    uint32_t _capacity;             // 散列表容量（2的幂，加载失败为0）
+    uint32_t _entryCount;           // 表项数
+};
+
+#endif // SOLUTION_TABLE_H_
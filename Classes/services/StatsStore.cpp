@@ -0,0 +1,376 @@
+#include "services/StatsStore.h"
+#include "services/GameLog.h"
+#include "cocos2d.h"
+#include <chrono>
+
+#if CARD_STATS_STORE
+#include "sqlite3.h"
+#endif
+
+namespace {
+    const char* const kStatsFileName = "stats.db"; // 默认数据库文件名
+
+#if CARD_STATS_STORE
+    // 表结构：回放单独成表；(level, won, moves)索引覆盖中位数查询
+    const char* const kSchemaSql =
+        "CREATE TABLE IF NOT EXISTS games("
+        " id INTEGER PRIMARY KEY,"
+        " level TEXT NOT NULL,"
+        " won INTEGER NOT NULL,"
+        " moves INTEGER NOT NULL,"
+        " score INTEGER NOT NULL,"
+        " finished_at INTEGER NOT NULL);"
+        "CREATE INDEX IF NOT EXISTS games_level_won_moves ON games(level, won, moves);"
+        "CREATE TABLE IF NOT EXISTS replays("
+        " game_id INTEGER PRIMARY KEY,"
+        " data BLOB NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS level_stats("
+        " level TEXT PRIMARY KEY,"
+        " attempts INTEGER NOT NULL DEFAULT 0,"
+        " wins INTEGER NOT NULL DEFAULT 0,"
+        " best_score INTEGER);";
+
+    // 执行不返回结果的SQL，失败时记录日志
+    bool execute(sqlite3* db, const char* sql, const char* what) {
+        char* message = nullptr;
+        if (sqlite3_exec(db, sql, nullptr, nullptr, &message) != SQLITE_OK) {
+            GLOG_ERROR(u8"统计数据库%s失败：%s", what, message ? message : sqlite3_errmsg(db));
+            sqlite3_free(message);
+            return false;
+        }
+        return true;
+    }
+
+    // 执行一条预编译语句直到完成，之后重置以便复用
+    bool step(sqlite3_stmt* stmt) {
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        return rc == SQLITE_DONE || rc == SQLITE_ROW;
+    }
+
+    void bindText(sqlite3_stmt* stmt, int index, const std::string& text) {
+        sqlite3_bind_text(stmt, index, text.c_str(), static_cast<int>(text.size()), SQLITE_TRANSIENT);
+    }
+#endif
+}
+
+StatsStore::StatsStore()
+    : _writeDb(nullptr), _readDb(nullptr), _beginStmt(nullptr), _commitStmt(nullptr), _rollbackStmt(nullptr),
+      _insertGameStmt(nullptr), _insertReplayStmt(nullptr), _ensureLevelStmt(nullptr), _updateLevelStmt(nullptr),
+      _selectLevelStmt(nullptr), _selectMedianStmt(nullptr), _selectReplayStmt(nullptr),
+      _queuedCount(0), _committedCount(0), _flushRequested(false), _running(false) {
+}
+
+StatsStore::~StatsStore() {
+    close();
+}
+
+std::string StatsStore::defaultPath() {
+    return cocos2d::FileUtils::getInstance()->getWritablePath() + kStatsFileName;
+}
+
+#if CARD_STATS_STORE
+
+sqlite3* StatsStore::openConnection(const std::string& path) {
+    sqlite3* db = nullptr;
+    // 每个连接只在一个线程上使用，关闭SQLite内部的连接级互斥
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(path.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+        GLOG_ERROR(u8"统计数据库打开失败：%s（%s）", path.c_str(), db ? sqlite3_errmsg(db) : "out of memory");
+        sqlite3_close(db);
+        return nullptr;
+    }
+    sqlite3_busy_timeout(db, kBusyTimeoutMs);
+    return db;
+}
+
+sqlite3_stmt* StatsStore::prepare(sqlite3* db, const char* sql) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        GLOG_ERROR(u8"统计数据库语句预编译失败：%s（%s）", sql, sqlite3_errmsg(db));
+        return nullptr;
+    }
+    return stmt;
+}
+
+bool StatsStore::open(const std::string& path) {
+    close();
+
+    _writeDb = openConnection(path);
+    if (!_writeDb) {
+        return false;
+    }
+    // WAL模式下读写互不阻塞；synchronous=NORMAL只在检查点时fsync，断电最多丢最后一批
+    if (!execute(_writeDb, "PRAGMA journal_mode=WAL;", u8"启用WAL") ||
+        !execute(_writeDb, "PRAGMA synchronous=NORMAL;", u8"设置同步级别") ||
+        !execute(_writeDb, kSchemaSql, u8"建表")) {
+        releaseStatements();
+        return false;
+    }
+    sqlite3_stmt* versionStmt = prepare(_writeDb, "PRAGMA user_version;");
+    int version = 0;
+    if (versionStmt && sqlite3_step(versionStmt) == SQLITE_ROW) {
+        version = sqlite3_column_int(versionStmt, 0);
+    }
+    sqlite3_finalize(versionStmt);
+    if (version > kSchemaVersion) {
+        GLOG_ERROR(u8"统计数据库版本%d高于当前支持的%d，不再写入", version, kSchemaVersion);
+        releaseStatements();
+        return false;
+    }
+    if (version < kSchemaVersion) {
+        execute(_writeDb, "PRAGMA user_version=1;", u8"写入表结构版本");
+    }
+
+    _readDb = openConnection(path);
+    _beginStmt = prepare(_writeDb, "BEGIN IMMEDIATE;");
+    _commitStmt = prepare(_writeDb, "COMMIT;");
+    _rollbackStmt = prepare(_writeDb, "ROLLBACK;");
+    _insertGameStmt = prepare(_writeDb,
+        "INSERT INTO games(level, won, moves, score, finished_at) VALUES(?1, ?2, ?3, ?4, ?5);");
+    _insertReplayStmt = prepare(_writeDb, "INSERT INTO replays(game_id, data) VALUES(?1, ?2);");
+    _ensureLevelStmt = prepare(_writeDb, "INSERT OR IGNORE INTO level_stats(level) VALUES(?1);");
+    _updateLevelStmt = prepare(_writeDb,
+        "UPDATE level_stats SET attempts = attempts + 1, wins = wins + ?2,"
+        " best_score = MAX(COALESCE(best_score, ?3), ?3) WHERE level = ?1;");
+    if (_readDb) {
+        _selectLevelStmt = prepare(_readDb,
+            "SELECT attempts, wins, COALESCE(best_score, 0) FROM level_stats WHERE level = ?1;");
+        _selectMedianStmt = prepare(_readDb,
+            "SELECT moves FROM games WHERE level = ?1 AND won = 1 ORDER BY moves LIMIT ?2 OFFSET ?3;");
+        _selectReplayStmt = prepare(_readDb,
+            "SELECT r.data FROM games g JOIN replays r ON r.game_id = g.id"
+            " WHERE g.level = ?1 ORDER BY g.id DESC LIMIT 1;");
+    }
+    if (!_readDb || !_beginStmt || !_commitStmt || !_rollbackStmt || !_insertGameStmt || !_insertReplayStmt ||
+        !_ensureLevelStmt || !_updateLevelStmt || !_selectLevelStmt || !_selectMedianStmt || !_selectReplayStmt) {
+        releaseStatements();
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.clear();
+        _running = true;
+    }
+    _worker = std::thread(&StatsStore::run, this);
+    GLOG_INFO(u8"统计数据库已打开：%s", path.c_str());
+    return true;
+}
+
+void StatsStore::releaseStatements() {
+    sqlite3_stmt** statements[] = { &_beginStmt, &_commitStmt, &_rollbackStmt, &_insertGameStmt, &_insertReplayStmt,
+        &_ensureLevelStmt, &_updateLevelStmt, &_selectLevelStmt, &_selectMedianStmt, &_selectReplayStmt };
+    for (sqlite3_stmt** stmt : statements) {
+        sqlite3_finalize(*stmt);
+        *stmt = nullptr;
+    }
+    sqlite3_close(_readDb);
+    _readDb = nullptr;
+    sqlite3_close(_writeDb);
+    _writeDb = nullptr;
+}
+
+void StatsStore::close() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _wake.notify_one();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+    if (_writeDb) {
+        releaseStatements();
+    }
+}
+
+void StatsStore::record(GameRecord record) {
+    if (!_writeDb) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(std::move(record));
+        ++_queuedCount;
+    }
+    // 后台线程被唤醒后继续攒批，满一批或到提交间隔才开事务
+    _wake.notify_one();
+}
+
+void StatsStore::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    const uint64_t target = _queuedCount;
+    _flushRequested = true;
+    _wake.notify_one();
+    _committed.wait(lock, [this, target] { return _committedCount >= target || !_running; });
+}
+
+void StatsStore::run() {
+    std::vector<GameRecord> batch;
+    for (;;) {
+        bool running = true;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return !_pending.empty() || !_running; });
+            // 攒批：未满一批、未请求flush且仍在运行时，最多再等一个提交间隔
+            auto batchReady = [this] {
+                return static_cast<int>(_pending.size()) >= kBatchSize || _flushRequested || !_running;
+            };
+            if (!batchReady()) {
+                _wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), batchReady);
+            }
+            _flushRequested = false;
+            batch.swap(_pending);
+            running = _running;
+        }
+
+        if (!batch.empty()) {
+            writeBatch(batch);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _committedCount += batch.size();
+            }
+            _committed.notify_all();
+            batch.clear();
+        }
+        if (!running) {
+            break;
+        }
+    }
+}
+
+bool StatsStore::writeBatch(const std::vector<GameRecord>& records) {
+    if (!step(_beginStmt)) {
+        GLOG_ERROR(u8"统计数据库开始事务失败：%s", sqlite3_errmsg(_writeDb));
+        return false;
+    }
+    for (const auto& record : records) {
+        if (!writeRecord(record)) {
+            GLOG_ERROR(u8"统计数据库写入失败，放弃本批%d条记录：%s",
+                static_cast<int>(records.size()), sqlite3_errmsg(_writeDb));
+            step(_rollbackStmt);
+            return false;
+        }
+    }
+    if (!step(_commitStmt)) {
+        GLOG_ERROR(u8"统计数据库提交失败：%s", sqlite3_errmsg(_writeDb));
+        step(_rollbackStmt);
+        return false;
+    }
+    GLOG_DEBUG(u8"统计数据库已提交%d条记录", static_cast<int>(records.size()));
+    return true;
+}
+
+bool StatsStore::writeRecord(const GameRecord& record) {
+    bindText(_insertGameStmt, 1, record.levelFile);
+    sqlite3_bind_int(_insertGameStmt, 2, record.won ? 1 : 0);
+    sqlite3_bind_int(_insertGameStmt, 3, record.moveCount);
+    sqlite3_bind_int(_insertGameStmt, 4, record.score);
+    sqlite3_bind_int64(_insertGameStmt, 5, record.finishedAt);
+    if (!step(_insertGameStmt)) {
+        return false;
+    }
+
+    if (!record.replay.empty()) {
+        sqlite3_bind_int64(_insertReplayStmt, 1, sqlite3_last_insert_rowid(_writeDb));
+        sqlite3_bind_blob(_insertReplayStmt, 2, record.replay.data(), static_cast<int>(record.replay.size()),
+            SQLITE_STATIC);
+        if (!step(_insertReplayStmt)) {
+            return false;
+        }
+    }
+
+    bindText(_ensureLevelStmt, 1, record.levelFile);
+    bindText(_updateLevelStmt, 1, record.levelFile);
+    sqlite3_bind_int(_updateLevelStmt, 2, record.won ? 1 : 0);
+    sqlite3_bind_int(_updateLevelStmt, 3, record.score);
+    return step(_ensureLevelStmt) && step(_updateLevelStmt);
+}
+
+bool StatsStore::queryLevelStats(const std::string& levelFile, LevelStats& outStats) {
+    outStats = LevelStats();
+    if (!_readDb) {
+        return false;
+    }
+
+    bindText(_selectLevelStmt, 1, levelFile);
+    int rc = sqlite3_step(_selectLevelStmt);
+    if (rc == SQLITE_ROW) {
+        outStats.attempts = sqlite3_column_int(_selectLevelStmt, 0);
+        outStats.wins = sqlite3_column_int(_selectLevelStmt, 1);
+        outStats.bestScore = sqlite3_column_int(_selectLevelStmt, 2);
+    }
+    sqlite3_reset(_selectLevelStmt);
+    if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+        GLOG_ERROR(u8"统计数据库查询失败：%s", sqlite3_errmsg(_readDb));
+        return false;
+    }
+    if (outStats.wins == 0) {
+        return true;
+    }
+
+    // 过关次数为奇数取正中一条，为偶数取中间两条的平均值；偏移在索引上定位，不读表
+    const int wins = outStats.wins;
+    bindText(_selectMedianStmt, 1, levelFile);
+    sqlite3_bind_int(_selectMedianStmt, 2, wins % 2 ? 1 : 2);
+    sqlite3_bind_int(_selectMedianStmt, 3, (wins - 1) / 2);
+    int64_t sum = 0;
+    int rows = 0;
+    while ((rc = sqlite3_step(_selectMedianStmt)) == SQLITE_ROW) {
+        sum += sqlite3_column_int(_selectMedianStmt, 0);
+        ++rows;
+    }
+    sqlite3_reset(_selectMedianStmt);
+    if (rc != SQLITE_DONE) {
+        GLOG_ERROR(u8"统计数据库查询中位数失败：%s", sqlite3_errmsg(_readDb));
+        return false;
+    }
+    outStats.medianMoves = rows > 0 ? static_cast<double>(sum) / rows : 0;
+    return true;
+}
+
+bool StatsStore::queryLatestReplay(const std::string& levelFile, std::vector<uint8_t>& outReplay) {
+    outReplay.clear();
+    if (!_readDb) {
+        return false;
+    }
+    bindText(_selectReplayStmt, 1, levelFile);
+    bool found = false;
+    if (sqlite3_step(_selectReplayStmt) == SQLITE_ROW) {
+        const uint8_t* data = static_cast<const uint8_t*>(sqlite3_column_blob(_selectReplayStmt, 0));
+        const int size = sqlite3_column_bytes(_selectReplayStmt, 0);
+        outReplay.assign(data, data + size);
+        found = true;
+    }
+    sqlite3_reset(_selectReplayStmt);
+    return found;
+}
+
+#else
+
+bool StatsStore::open(const std::string& path) {
+    GLOG_INFO(u8"统计数据库未启用（CARD_STATS_STORE=0）：%s", path.c_str());
+    return false;
+}
+
+void StatsStore::close() {
+}
+
+void StatsStore::record(GameRecord) {
+}
+
+void StatsStore::flush() {
+}
+
+bool StatsStore::queryLevelStats(const std::string&, LevelStats& outStats) {
+    outStats = LevelStats();
+    return false;
+}
+
+bool StatsStore::queryLatestReplay(const std::string&, std::vector<uint8_t>& outReplay) {
+    outReplay.clear();
+    return false;
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef STATS_STORE_H_
+#define STATS_STORE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 统计数据库依赖SQLite：Windows工程随引擎链接sqlite3.lib，其他平台默认关闭（open返回false，其余接口为空操作）
+#ifndef CARD_STATS_STORE
+#ifdef _WIN32
+#define CARD_STATS_STORE 1
+#else
+#define CARD_STATS_STORE 0
+#endif
+#endif
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+/**
+ * 一局结束时写入的记录
+ */
+struct GameRecord {
+    std::string levelFile;          // 关卡文件
+    bool won = false;               // 是否过关（否则为死局）
+    int moveCount = 0;              // 本局累计移动次数
+    int score = 0;                  // 结束时得分
+    int64_t finishedAt = 0;         // 结束时刻（Unix时间，秒）
+    std::vector<uint8_t> replay;    // 回放数据（SaveStateCodec编码的终局与完整撤销历史），可为空
+};
+
+/**
+ * 单个关卡的汇总统计
+ */
+struct LevelStats {
+    int attempts = 0;               // 已结束的对局数
+    int wins = 0;                   // 过关次数
+    int bestScore = 0;              // 最高得分
+    double medianMoves = 0;         // 过关对局移动次数的中位数（没有过关记录时为0）
+};
+
+/*
+基于SQLite的本地统计库：记录每局的关卡、胜负、移动次数、得分与回放数据，供统计界面查询
+核心功能：
+1. 数据库使用WAL模式（synchronous=NORMAL），写入与查询分别使用独立连接，查询不会被后台写入阻塞
+2. 主线程只把记录移入待写队列；后台线程攒满kBatchSize条或等待kFlushIntervalMs后，
+   用一个事务、预编译语句批量写入
+3. 表结构：games（每局一行，不含回放）、replays（回放数据单独存放，扫描games时不读大字段）、
+   level_stats（按关卡累计的对局数、过关数、最高分，与对局记录在同一事务中更新）
+4. 查询：汇总值直接读level_stats；中位数借助(level, won, moves)索引按偏移定位，
+   只走索引不回表，十万局记录下仍在毫秒级完成
+所有SQL语句在open时预编译一次；写入连接只在后台线程使用，查询接口须在同一线程（主线程）调用
+ */
+class StatsStore {
+public:
+    static const int kSchemaVersion = 1;        // 表结构版本（PRAGMA user_version）
+    static const int kBatchSize = 64;           // 攒满多少条记录立即提交
+    static const int kFlushIntervalMs = 500;    // 有待写记录时最长多久提交一次（毫秒）
+    static const int kBusyTimeoutMs = 2000;     // 数据库被锁时的等待时间（毫秒）
+
+    StatsStore();
+
+    /**
+     * 析构函数：提交剩余记录后关闭数据库
+     */
+    ~StatsStore();
+
+    StatsStore(const StatsStore&) = delete;
+    StatsStore& operator=(const StatsStore&) = delete;
+
+    /**
+     * 获取默认数据库路径（可写目录下的stats.db）
+     * @return 数据库文件路径
+     */
+    static std::string defaultPath();
+
+    /**
+     * 打开（必要时创建）数据库，预编译语句并启动后台写入线程
+     * @param path 数据库文件路径
+     * @return 打开成功返回true；未启用SQLite（CARD_STATS_STORE=0）时返回false
+     */
+    bool open(const std::string& path);
+
+    /**
+     * 提交剩余记录，结束后台线程并关闭数据库（可重复调用）
+     */
+    void close();
+
+    /**
+     * 数据库是否已打开
+     * @return 已打开返回true
+     */
+    bool isOpen() const { return _writeDb != nullptr; }
+
+    /**
+     * 记录一局（只移入待写队列，不做I/O）
+     * @param record 对局记录
+     */
+    void record(GameRecord record);
+
+    /**
+     * 阻塞等待此前记录的对局全部提交
+     */
+    void flush();
+
+    /**
+     * 查询关卡的汇总统计
+     * @param levelFile 关卡文件
+     * @param outStats 输出参数，接收统计结果
+     * @return 查询成功返回true（关卡没有记录时统计值均为0）
+     */
+    bool queryLevelStats(const std::string& levelFile, LevelStats& outStats);
+
+    /**
+     * 读取关卡最近一局的回放数据
+     * @param levelFile 关卡文件
+     * @param outReplay 输出参数，接收回放数据
+     * @return 找到回放返回true
+     */
+    bool queryLatestReplay(const std::string& levelFile, std::vector<uint8_t>& outReplay);
+
+private:
+    // 后台线程主循环
+    void run();
+
+    // 在一个事务中写入一批记录（后台线程）
+    bool writeBatch(const std::vector<GameRecord>& records);
+
+    // 写入一条记录（后台线程，事务内）
+    bool writeRecord(const GameRecord& record);
+
+    // 打开连接并设置繁忙等待
+    static sqlite3* openConnection(const std::string& path);
+
+    // 预编译一条语句，失败时记录日志并返回nullptr
+    static sqlite3_stmt* prepare(sqlite3* db, const char* sql);
+
+    // 释放全部预编译语句并关闭连接
+    void releaseStatements();
+
+    sqlite3* _writeDb;                      // 写入连接（打开后仅后台线程访问）
+    sqlite3* _readDb;                       // 查询连接（仅调用线程访问）
+    sqlite3_stmt* _beginStmt;               // BEGIN IMMEDIATE
+    sqlite3_stmt* _commitStmt;              // COMMIT
+    sqlite3_stmt* _rollbackStmt;            // ROLLBACK
+    sqlite3_stmt* _insertGameStmt;          // 写入对局
+    sqlite3_stmt* _insertReplayStmt;        // 写入回放
+    sqlite3_stmt* _ensureLevelStmt;         // 确保关卡汇总行存在
+    sqlite3_stmt* _updateLevelStmt;         // 累加关卡汇总
+    sqlite3_stmt* _selectLevelStmt;         // 查询关卡汇总
+    sqlite3_stmt* _selectMedianStmt;        // 按偏移查询过关移动次数
+    sqlite3_stmt* _selectReplayStmt;        // 查询最近一局回放
+
+    std::mutex _mutex;                      // 保护以下待写状态
+    std::condition_variable _wake;          // 唤醒后台线程
+    std::condition_variable _committed;     // 一批记录提交后通知flush
+    std::vector<GameRecord> _pending;       // 待写入的记录
+    uint64_t _queuedCount;                  // 累计入队的记录数
+    uint64_t _committedCount;               // 累计处理完（提交或放弃）的记录数
+    bool _flushRequested;                   // flush正在等待，不再攒批
+    bool _running;                          // 后台线程运行标记
+    std::thread _worker;                    // 后台写入线程
+};
+
+#endif // STATS_STORE_H_
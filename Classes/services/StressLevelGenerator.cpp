@@ -0,0 +1,74 @@
+#include "services/StressLevelGenerator.h"
+#include "cocos2d.h"
+#include "json/document.h"
+#include "json/writer.h"
+#include "json/stringbuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    // 游戏区卡牌坐标范围（加载时会再叠加游戏区偏移）
+    const float kAreaLeft = 120.0f;
+    const float kAreaRight = 960.0f;
+    const float kAreaBottom = 150.0f;
+    const float kAreaTop = 1250.0f;
+
+    // 构造单张卡牌的JSON节点
+    rapidjson::Value makeCardNode(int face, int suit, int x, int y, rapidjson::Document::AllocatorType& allocator) {
+        rapidjson::Value position(rapidjson::kObjectType);
+        position.AddMember("x", x, allocator);
+        position.AddMember("y", y, allocator);
+
+        rapidjson::Value card(rapidjson::kObjectType);
+        card.AddMember("CardFace", face, allocator);
+        card.AddMember("CardSuit", suit, allocator);
+        card.AddMember("Position", position, allocator);
+        return card;
+    }
+}
+
+std::string StressLevelGenerator::generateLevelFile(int playfieldCount, int stackCount, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> faceDist(0, 12);
+    std::uniform_int_distribution<int> suitDist(0, 3);
+
+    rapidjson::Document doc;
+    doc.SetObject();
+    auto& allocator = doc.GetAllocator();
+
+    // 按近似正方形网格排布游戏区卡牌
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(playfieldCount)))));
+    int rows = std::max(1, (playfieldCount + columns - 1) / columns);
+    float stepX = columns > 1 ? (kAreaRight - kAreaLeft) / (columns - 1) : 0.0f;
+    float stepY = rows > 1 ? (kAreaTop - kAreaBottom) / (rows - 1) : 0.0f;
+
+    rapidjson::Value playfield(rapidjson::kArrayType);
+    for (int i = 0; i < playfieldCount; ++i) {
+        int x = static_cast<int>(kAreaLeft + stepX * (i % columns));
+        int y = static_cast<int>(kAreaTop - stepY * (i / columns));
+        rapidjson::Value card = makeCardNode(faceDist(rng), suitDist(rng), x, y, allocator);
+        playfield.PushBack(card, allocator);
+    }
+    doc.AddMember("Playfield", playfield, allocator);
+
+    rapidjson::Value stack(rapidjson::kArrayType);
+    for (int i = 0; i < stackCount; ++i) {
+        rapidjson::Value card = makeCardNode(faceDist(rng), suitDist(rng), 0, 0, allocator);
+        stack.PushBack(card, allocator);
+    }
+    doc.AddMember("Stack", stack, allocator);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    auto fileUtils = cocos2d::FileUtils::getInstance();
+    std::string path = fileUtils->getWritablePath() + cocos2d::StringUtils::format("stress_level_%d_%d.json", playfieldCount, stackCount);
+    if (!fileUtils->writeStringToFile(buffer.GetString(), path)) {
+        CCLOG("StressLevelGenerator: 写入合成关卡失败 %s", path.c_str());
+        return "";
+    }
+    CCLOG("StressLevelGenerator: 已生成合成关卡 %s（游戏区%d张，牌堆区%d张）", path.c_str(), playfieldCount, stackCount);
+    return path;
+}
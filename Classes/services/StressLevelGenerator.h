@@ -0,0 +1,28 @@
+#ifndef STRESS_LEVEL_GENERATOR_H_
+#define STRESS_LEVEL_GENERATOR_H_
+
+#include <string>
+
+/*
+合成关卡生成器，按指定规模生成与level_1.json格式相同的超大关卡文件
+生成结果写入可写目录，再由LevelConfigLoader按正常流程加载，
+保证压力测试覆盖真实的加载、建模与视图创建路径
+采用静态类设计，所有方法均为静态，无需实例化即可使用
+ */
+class StressLevelGenerator {
+public:
+    /**
+     * 生成合成关卡文件
+     * 游戏区卡牌按网格铺满上方区域（卡牌数量大时允许互相重叠），牌面与花色随机
+     * @param playfieldCount 游戏区卡牌数量
+     * @param stackCount 牌堆区卡牌数量
+     * @param seed 随机种子，相同参数生成完全相同的关卡
+     * @return 关卡文件的完整路径，写入失败返回空字符串
+     */
+    static std::string generateLevelFile(int playfieldCount, int stackCount, unsigned int seed);
+
+private:
+    StressLevelGenerator() = default;
+};
+
+#endif // STRESS_LEVEL_GENERATOR_H_
@@ -0,0 +1,216 @@
+#include "services/StressTestRunner.h"
+#include "services/PerfMonitor.h"
+#include "views/GameView.h"
+#include "views/CardView.h"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+    const int kWarmupFrames = 30;     // 预热帧数（不计入统计）
+    const int kScriptFrames = 1200;   // 脚本运行帧数
+    const int kDragFrames = 12;       // 单次拖拽持续帧数
+    const int kUndoBurst = 5;         // 单次连续撤销次数
+    const unsigned int kSeed = 20240101;
+
+    // 计算百分位数（p取0~1），空数据返回0
+    float percentile(std::vector<float> values, float p) {
+        if (values.empty()) return 0.0f;
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5f);
+        return values[std::min(index, values.size() - 1)];
+    }
+
+    // 写出一组数据的百分位统计行
+    void appendStats(std::ostringstream& out, const char* name, const std::vector<float>& values) {
+        out << name << "_p50," << percentile(values, 0.50f) << "\n";
+        out << name << "_p90," << percentile(values, 0.90f) << "\n";
+        out << name << "_p99," << percentile(values, 0.99f) << "\n";
+        out << name << "_max," << percentile(values, 1.0f) << "\n";
+    }
+
+    // 卡牌视图中心的世界坐标
+    cocos2d::Vec2 worldPositionOf(cocos2d::Node* node) {
+        return node->getParent() ? node->getParent()->convertToWorldSpace(node->getPosition()) : node->getPosition();
+    }
+}
+
+StressTestRunner* StressTestRunner::create(GameView* gameView, int cardCount, double viewCreationMs) {
+    auto runner = new (std::nothrow) StressTestRunner();
+    if (runner && runner->init(gameView, cardCount, viewCreationMs)) {
+        runner->autorelease();
+        return runner;
+    }
+    CC_SAFE_DELETE(runner);
+    return nullptr;
+}
+
+bool StressTestRunner::init(GameView* gameView, int cardCount, double viewCreationMs) {
+    if (!Node::init() || !gameView) {
+        return false;
+    }
+
+    _gameView = gameView;
+    _cardCount = cardCount;
+    _viewCreationMs = viewCreationMs;
+    _rng.seed(kSeed);
+    _startMemory = PerfMonitor::getResidentMemoryBytes();
+    _peakMemory = _startMemory;
+
+    _frameTimesMs.reserve(kScriptFrames);
+    _nodeCounts.reserve(kScriptFrames);
+    _drawCalls.reserve(kScriptFrames);
+    _runningActions.reserve(kScriptFrames);
+
+    scheduleUpdate();
+    CCLOG("StressTestRunner: 开始压力测试 - 卡牌数：%d，视图创建耗时：%.2fms", cardCount, viewCreationMs);
+    return true;
+}
+
+void StressTestRunner::update(float dt) {
+    ++_frame;
+    if (_frame <= kWarmupFrames) {
+        return;
+    }
+
+    sampleFrame(dt);
+
+    if (_frame < kWarmupFrames + kScriptFrames) {
+        runScriptStep();
+        return;
+    }
+
+    // 脚本结束：收尾未完成的拖拽并输出报告
+    _touch.cancelled();
+    unscheduleUpdate();
+    writeReport();
+}
+
+void StressTestRunner::sampleFrame(float dt) {
+    _frameTimesMs.push_back(dt * 1000.0f);
+    _nodeCounts.push_back(static_cast<float>(countNodes(_gameView)));
+    _drawCalls.push_back(static_cast<float>(cocos2d::Director::getInstance()->getRenderer()->getDrawnBatches()));
+
+    size_t actions = 0;
+    for (auto cardView : _gameView->getPlayfieldCardViews()) {
+        actions += cardView->getNumberOfRunningActions();
+    }
+    for (auto cardView : _gameView->getStackfieldCardViews()) {
+        actions += cardView->getNumberOfRunningActions();
+    }
+    _runningActions.push_back(static_cast<float>(actions));
+
+    // 内存查询有系统调用开销，每30帧采样一次
+    if (_frame % 30 == 0) {
+        _peakMemory = std::max(_peakMemory, PerfMonitor::getResidentMemoryBytes());
+    }
+}
+
+void StressTestRunner::runScriptStep() {
+    if (_dragFramesLeft > 0) {
+        continueDrag();
+        return;
+    }
+
+    std::uniform_int_distribution<int> actionDist(0, 99);
+    int roll = actionDist(_rng);
+    if (roll < 40) {
+        // 随机点击一张卡牌
+        CardView* card = pickRandomCard();
+        if (card) {
+            timedTap(worldPositionOf(card));
+        }
+    }
+    else if (roll < 55) {
+        // 开始一次跨多帧的拖拽
+        CardView* card = pickRandomCard();
+        if (card) {
+            std::uniform_real_distribution<float> offsetDist(-300.0f, 300.0f);
+            _dragPos = worldPositionOf(card);
+            _dragStep = cocos2d::Vec2(offsetDist(_rng), offsetDist(_rng)) * (1.0f / kDragFrames);
+            _dragFramesLeft = kDragFrames;
+
+            PerfScope scope;
+            _touch.began(_dragPos);
+            _dispatchTimesUs.push_back(scope.elapsedNs() / 1000.0f);
+        }
+    }
+    else if (roll < 60) {
+        // 连续撤销
+        cocos2d::Node* undoButton = _gameView->getUndoButton();
+        if (undoButton) {
+            cocos2d::Vec2 pos = worldPositionOf(undoButton);
+            for (int i = 0; i < kUndoBurst; ++i) {
+                timedTap(pos);
+            }
+        }
+    }
+    // 其余情况空闲一帧，让动画自然推进
+}
+
+void StressTestRunner::continueDrag() {
+    _dragPos += _dragStep;
+    --_dragFramesLeft;
+
+    PerfScope scope;
+    if (_dragFramesLeft > 0) {
+        _touch.moved(_dragPos);
+    }
+    else {
+        _touch.ended(_dragPos);
+    }
+    _dispatchTimesUs.push_back(scope.elapsedNs() / 1000.0f);
+}
+
+CardView* StressTestRunner::pickRandomCard() {
+    const auto& playfield = _gameView->getPlayfieldCardViews();
+    const auto& stackfield = _gameView->getStackfieldCardViews();
+    size_t total = playfield.size() + stackfield.size();
+    if (total == 0) {
+        return nullptr;
+    }
+
+    std::uniform_int_distribution<size_t> indexDist(0, total - 1);
+    size_t index = indexDist(_rng);
+    return index < playfield.size() ? playfield[index] : stackfield[index - playfield.size()];
+}
+
+void StressTestRunner::timedTap(const cocos2d::Vec2& worldPos) {
+    PerfScope scope;
+    _touch.tap(worldPos);
+    _dispatchTimesUs.push_back(scope.elapsedNs() / 1000.0f);
+}
+
+void StressTestRunner::writeReport() {
+    const double mb = 1024.0 * 1024.0;
+
+    std::ostringstream out;
+    out << "metric,value\n";
+    out << "cards," << _cardCount << "\n";
+    out << "frames," << _frameTimesMs.size() << "\n";
+    out << "view_creation_ms," << _viewCreationMs << "\n";
+    appendStats(out, "frame_ms", _frameTimesMs);
+    appendStats(out, "touch_dispatch_us", _dispatchTimesUs);
+    appendStats(out, "nodes", _nodeCounts);
+    appendStats(out, "draw_calls", _drawCalls);
+    appendStats(out, "running_actions", _runningActions);
+    out << "memory_start_mb," << _startMemory / mb << "\n";
+    out << "memory_peak_mb," << _peakMemory / mb << "\n";
+
+    auto fileUtils = cocos2d::FileUtils::getInstance();
+    std::string path = fileUtils->getWritablePath() + cocos2d::StringUtils::format("stress_report_%d.csv", _cardCount);
+    if (fileUtils->writeStringToFile(out.str(), path)) {
+        CCLOG("StressTestRunner: 压力测试报告已写入 %s", path.c_str());
+    }
+    else {
+        CCLOG("StressTestRunner: 压力测试报告写入失败 %s", path.c_str());
+    }
+    cocos2d::log("%s", out.str().c_str());
+}
+
+int StressTestRunner::countNodes(cocos2d::Node* node) {
+    int count = 1;
+    for (auto child : node->getChildren()) {
+        count += countNodes(child);
+    }
+    return count;
+}
@@ -0,0 +1,82 @@
+#ifndef STRESS_TEST_RUNNER_H_
+#define STRESS_TEST_RUNNER_H_
+
+#include "cocos2d.h"
+#include "services/TouchInjector.h"
+#include <random>
+#include <vector>
+
+class GameView;
+class CardView;
+
+/*
+场景规模压力测试驱动节点，挂在场景上逐帧脚本化地操作GameView
+核心功能：
+1. 通过TouchInjector注入随机点击、跨多帧的拖拽和连续撤销，走真实的触摸分发路径
+2. 逐帧记录帧耗时、触摸分发耗时、节点数、绘制批次、运行中的动作数与内存
+3. 脚本结束后把百分位统计写入可写目录下的 stress_report_<卡牌数>.csv
+用于定位卡牌创建、触摸分发与动画在大规模关卡下的性能拐点
+ */
+class StressTestRunner : public cocos2d::Node {
+public:
+    /**
+     * 静态创建方法
+     * @param gameView 被测试的游戏视图
+     * @param cardCount 关卡卡牌总数（写入报告）
+     * @param viewCreationMs 创建GameView的耗时（毫秒，写入报告）
+     * @return 成功返回实例，失败返回nullptr
+     */
+    static StressTestRunner* create(GameView* gameView, int cardCount, double viewCreationMs);
+
+    /**
+     * 每帧回调：采样上一帧数据并执行一步脚本
+     * @param dt 上一帧耗时（秒）
+     */
+    virtual void update(float dt) override;
+
+protected:
+    bool init(GameView* gameView, int cardCount, double viewCreationMs);
+
+private:
+    // 采样一帧的统计数据
+    void sampleFrame(float dt);
+
+    // 按随机权重选择并执行一步脚本动作
+    void runScriptStep();
+
+    // 推进进行中的拖拽手势
+    void continueDrag();
+
+    // 随机选取一张卡牌视图，没有卡牌时返回nullptr
+    CardView* pickRandomCard();
+
+    // 派发触摸并记录分发耗时
+    void timedTap(const cocos2d::Vec2& worldPos);
+
+    // 写出统计报告
+    void writeReport();
+
+    // 递归统计节点数量
+    static int countNodes(cocos2d::Node* node);
+
+    GameView* _gameView = nullptr;   // 被测试的游戏视图（由场景持有）
+    int _cardCount = 0;              // 关卡卡牌总数
+    double _viewCreationMs = 0;      // 视图创建耗时
+    TouchInjector _touch;            // 触摸注入器
+    std::mt19937 _rng;               // 固定种子的随机数发生器，保证脚本可复现
+
+    int _frame = 0;                  // 已运行帧数
+    int _dragFramesLeft = 0;         // 拖拽剩余帧数
+    cocos2d::Vec2 _dragPos;          // 当前拖拽位置
+    cocos2d::Vec2 _dragStep;         // 每帧拖拽位移
+
+    std::vector<float> _frameTimesMs;    // 每帧耗时（毫秒）
+    std::vector<float> _dispatchTimesUs; // 单次触摸事件分发耗时（微秒）
+    std::vector<float> _nodeCounts;      // 每帧场景节点数
+    std::vector<float> _drawCalls;       // 每帧绘制批次
+    std::vector<float> _runningActions;  // 每帧运行中的动作数（反映动画并发量）
+    uint64_t _startMemory = 0;           // 开始时的常驻内存
+    uint64_t _peakMemory = 0;            // 常驻内存峰值
+};
+
+#endif // STRESS_TEST_RUNNER_H_
@@ -0,0 +1,63 @@
+#include "services/TouchInjector.h"
+
+TouchInjector::TouchInjector(int touchId)
+    : _touchId(touchId) {}
+
+TouchInjector::~TouchInjector() {
+    releaseTouch();
+}
+
+void TouchInjector::began(const cocos2d::Vec2& worldPos) {
+    if (_touch) {
+        cancelled(); // 上一次手势未结束，先取消
+    }
+    _touch = new (std::nothrow) cocos2d::Touch();
+    if (!_touch) {
+        CCLOG("TouchInjector: 创建Touch失败");
+        return;
+    }
+    dispatch(cocos2d::EventTouch::EventCode::BEGAN, worldPos);
+}
+
+void TouchInjector::moved(const cocos2d::Vec2& worldPos) {
+    if (!_touch) return;
+    dispatch(cocos2d::EventTouch::EventCode::MOVED, worldPos);
+}
+
+void TouchInjector::ended(const cocos2d::Vec2& worldPos) {
+    if (!_touch) return;
+    dispatch(cocos2d::EventTouch::EventCode::ENDED, worldPos);
+    releaseTouch();
+}
+
+void TouchInjector::cancelled() {
+    if (!_touch) return;
+    dispatch(cocos2d::EventTouch::EventCode::CANCELLED, _lastPos);
+    releaseTouch();
+}
+
+void TouchInjector::tap(const cocos2d::Vec2& worldPos) {
+    began(worldPos);
+    ended(worldPos);
+}
+
+void TouchInjector::dispatch(cocos2d::EventTouch::EventCode code, const cocos2d::Vec2& worldPos) {
+    auto director = cocos2d::Director::getInstance();
+
+    // Touch内部保存的是屏幕坐标（y轴向下），getLocation()时再转换回GL坐标
+    cocos2d::Vec2 screenPos = director->convertToUI(worldPos);
+    _touch->setTouchInfo(_touchId, screenPos.x, screenPos.y);
+    _lastPos = worldPos;
+
+    cocos2d::EventTouch event;
+    event.setEventCode(code);
+    event.setTouches(std::vector<cocos2d::Touch*>{ _touch });
+    director->getEventDispatcher()->dispatchEvent(&event);
+}
+
+void TouchInjector::releaseTouch() {
+    if (_touch) {
+        _touch->release();
+        _touch = nullptr;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef TOUCH_INJECTOR_H_
+#define TOUCH_INJECTOR_H_
+
+#include "cocos2d.h"
+
+/*
+触摸事件注入器，通过导演的事件分发器派发合成的触摸事件
+与真实输入走完全相同的分发路径（监听器优先级排序、吞没、回调），
+用于压力测试与无界面集成测试中脚本化地模拟点击与拖拽
+ */
+class TouchInjector {
+public:
+    /**
+     * 构造函数
+     * @param touchId 注入触摸的ID，多指模拟时使用不同ID
+     */
+    explicit TouchInjector(int touchId = 0);
+
+    /**
+     * 析构函数
+     * 释放当前手势持有的触摸对象
+     */
+    ~TouchInjector();
+
+    /**
+     * 开始一次手势
+     * @param worldPos 触摸点的世界坐标（GL坐标系）
+     */
+    void began(const cocos2d::Vec2& worldPos);
+
+    /**
+     * 手势移动
+     * @param worldPos 新的触摸点世界坐标
+     */
+    void moved(const cocos2d::Vec2& worldPos);
+
+    /**
+     * 结束手势
+     * @param worldPos 抬起位置的世界坐标
+     */
+    void ended(const cocos2d::Vec2& worldPos);
+
+    /**
+     * 取消手势
+     */
+    void cancelled();
+
+    /**
+     * 在指定位置完成一次点击（按下后立即抬起）
+     * @param worldPos 点击位置的世界坐标
+     */
+    void tap(const cocos2d::Vec2& worldPos);
+
+    // 当前是否有进行中的手势
+    bool isActive() const { return _touch != nullptr; }
+
+private:
+    // 更新触摸位置并派发指定阶段的触摸事件
+    void dispatch(cocos2d::EventTouch::EventCode code, const cocos2d::Vec2& worldPos);
+
+    // 释放当前手势的触摸对象
+    void releaseTouch();
+
+    int _touchId;                        // 注入触摸的ID
+    cocos2d::Touch* _touch = nullptr;    // 当前手势的触摸对象（每次手势重新创建，保证起始点正确）
+    cocos2d::Vec2 _lastPos;              // 最近一次触摸位置
+};
+
+#endif // TOUCH_INJECTOR_H_
@@ -0,0 +1,74 @@
+#include "views/BoardReconciler.h"
+#include <algorithm>
+
+void BoardReconciler::reset(const std::vector<std::pair<int, CardViewState>>& cards) {
+    _displayed.clear();
+    _displayed.reserve(cards.size());
+    for (const auto& entry : cards) {
+        _displayed[entry.first] = entry.second;
+    }
+}
+
+int BoardReconciler::reconcile(const CardStateChange* changes, int count, std::vector<ViewOp>& outOps) {
+    const size_t before = outOps.size();
+    bool handChanged = false;
+
+    for (int i = 0; i < count; ++i) {
+        const CardStateChange& change = changes[i];
+        CardViewState& state = _displayed[change.cardId];
+
+        // 离开手牌区的卡牌一定可见；新登记的卡牌默认可见
+        if (!state.visible && change.zone != CardZone::Hand) {
+            outOps.push_back(ViewOp{ ViewOp::Reveal, change.cardId, change.position, change.zOrder });
+            state.visible = true;
+        }
+        if (!state.position.equals(change.position)) {
+            outOps.push_back(ViewOp{ ViewOp::Move, change.cardId, change.position, change.zOrder });
+            state.position = change.position;
+        }
+        if (state.zOrder != change.zOrder) {
+            outOps.push_back(ViewOp{ ViewOp::ReorderZ, change.cardId, change.position, change.zOrder });
+            state.zOrder = change.zOrder;
+        }
+        if (state.zone != change.zone) {
+            handChanged = handChanged || state.zone == CardZone::Hand || change.zone == CardZone::Hand;
+            state.zone = change.zone;
+        }
+    }
+
+    if (handChanged) {
+        updateHandVisibility(outOps);
+    }
+    return static_cast<int>(outOps.size() - before);
+}
+
+const CardViewState* BoardReconciler::getState(int cardId) const {
+    auto it = _displayed.find(cardId);
+    return it != _displayed.end() ? &it->second : nullptr;
+}
+
+int BoardReconciler::updateHandVisibility(std::vector<ViewOp>& outOps) {
+    _handScratch.clear();
+    for (const auto& entry : _displayed) {
+        if (entry.second.zone == CardZone::Hand) {
+            _handScratch.push_back(std::make_pair(entry.second.zOrder, entry.first));
+        }
+    }
+
+    // 按层级从高到低排序，前kVisibleHandCards张可见，其余被完全遮挡
+    std::sort(_handScratch.begin(), _handScratch.end(),
+        [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+
+    int ops = 0;
+    for (size_t i = 0; i < _handScratch.size(); ++i) {
+        CardViewState& state = _displayed[_handScratch[i].second];
+        bool visible = static_cast<int>(i) < kVisibleHandCards;
+        if (state.visible != visible) {
+            outOps.push_back(ViewOp{ visible ? ViewOp::Reveal : ViewOp::Hide,
+                _handScratch[i].second, state.position, state.zOrder });
+            state.visible = visible;
+            ++ops;
+        }
+    }
+    return ops;
+}
@@ -0,0 +1,87 @@
+#ifndef BOARD_RECONCILER_H_
+#define BOARD_RECONCILER_H_
+
+#include "cocos2d.h"
+#include "models/CardModel.h"
+#include "services/GameEventBus.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * 单张卡牌当前显示的状态
+ */
+struct CardViewState {
+    CardZone zone = CardZone::Unknown;              // 所在区域
+    cocos2d::Vec2 position = cocos2d::Vec2::ZERO;   // 目标位置
+    int zOrder = 0;                                 // 层级
+    bool visible = true;                            // 是否显示
+};
+
+/**
+ * 视图操作：调和结果中的最小操作单元
+ */
+struct ViewOp {
+    enum Type {
+        Move,       // 移动到新位置（播放动画）
+        ReorderZ,   // 调整层级
+        Reveal,     // 重新显示
+        Hide        // 隐藏（被完全遮挡的卡牌，减少绘制批次）
+    };
+
+    Type type;                // 操作类型
+    int cardId;               // 目标卡牌ID
+    cocos2d::Vec2 position;   // Move的目标位置
+    int zOrder;               // ReorderZ的目标层级
+};
+
+/*
+视图调和器，比较当前显示状态与新的目标状态，只生成真正需要执行的视图操作
+核心功能：
+1. 维护每张卡牌当前显示的区域、位置、层级与可见性
+2. 输入一批卡牌目标状态（来自控制器的合并状态差异），输出移动、调层级、显示、隐藏的最小操作集合；
+   一批内移动后又撤销回原位的卡牌不产生任何操作
+3. 手牌区只保留最上面两张可见（新移入的一张在飞行动画中需要露出下面一张），
+   更下面被完全遮挡的卡牌隐藏，撤销时再依次显示
+撤销到指定步、重新开始本关等批量变化都经过调和，只触及状态真正改变的卡牌
+ */
+class BoardReconciler {
+public:
+    /**
+     * 以当前已创建的视图状态作为基准，不生成任何操作
+     * @param cards 卡牌ID与显示状态
+     */
+    void reset(const std::vector<std::pair<int, CardViewState>>& cards);
+
+    /**
+     * 调和一批卡牌目标状态
+     * @param changes 目标状态数组
+     * @param count 数组长度
+     * @param outOps 输出参数，追加需要执行的视图操作（同一张卡牌按显示、移动、调层级、隐藏的顺序）
+     * @return 追加的操作数
+     */
+    int reconcile(const CardStateChange* changes, int count, std::vector<ViewOp>& outOps);
+
+    /**
+     * 查询卡牌当前的显示状态
+     * @param cardId 卡牌ID
+     * @return 状态指针，卡牌未登记时返回nullptr
+     */
+    const CardViewState* getState(int cardId) const;
+
+private:
+    // 手牌区可见的卡牌数（最上面的若干张）
+    static const int kVisibleHandCards = 2;
+
+    /**
+     * 根据手牌区的层级顺序重新计算可见性，生成显示/隐藏操作
+     * @param outOps 输出参数，追加操作
+     * @return 追加的操作数
+     */
+    int updateHandVisibility(std::vector<ViewOp>& outOps);
+
+    std::unordered_map<int, CardViewState> _displayed;  // 卡牌ID -> 当前显示状态
+    std::vector<std::pair<int, int>> _handScratch;      // 计算手牌可见性的临时缓冲区（层级，卡牌ID）
+};
+
+#endif // BOARD_RECONCILER_H_
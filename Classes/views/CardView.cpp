@@ -1,9 +1,9 @@
 #include "CardView.h"
 #include <iostream>
 
-CardView* CardView::create(const CardModel& model, const Vec2& offset) {
+CardView* CardView::create(const CardModel& model, const Vec2& offset, CardIdManagerMap* cardManagers) {
     auto view = new (std::nothrow) CardView();
-    if (view && view->init(model, offset)) {
+    if (view && view->init(model, offset, cardManagers)) {
         view->autorelease(); // 启用内存自动释放机制
         return view;
     }
@@ -11,15 +11,9 @@ CardView* CardView::create(const CardModel& model, const Vec2& offset) {
     return nullptr;
 }
 
-void CardView::setClickCallback(const ClickCallback& callback) {
-    _clickCallback = callback;
+void CardView::setEventBus(GameEventBus* eventBus) {
     if (_cardManager) {
-        // 绑定卡牌点击回调，将视图自身作为参数传递
-        _cardManager->setCardClickedCallback([this, callback](CardModel& model) {
-            if (callback) {
-                callback(this);
-            }
-        });
+        _cardManager->setEventBus(eventBus);
     }
 }
 
@@ -29,7 +23,7 @@ bool CardView::isTouchInside(const Vec2& touchPos) {
     return _background->getBoundingBox().containsPoint(touchPos);
 }
 
-bool CardView::init(const CardModel& model, const Vec2& offset) {
+bool CardView::init(const CardModel& model, const Vec2& offset, CardIdManagerMap* cardManagers) {
     if (!Node::init()) {
         return false;
     }
@@ -42,7 +36,7 @@ bool CardView::init(const CardModel& model, const Vec2& offset) {
     }
 
     // 2. 创建并初始化卡牌管理器
-    _cardManager = new (std::nothrow) CardManager(model);
+    _cardManager = new (std::nothrow) CardManager(model, cardManagers);
     if (!_cardManager) {
         CCLOG("CardView: 创建CardManager失败");
         return false;
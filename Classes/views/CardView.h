@@ -3,11 +3,12 @@
 
 #include "cocos2d.h"
 #include "models/CardModel.h"      // 卡牌数据模型
-#include "configs/CardResConfig.h" // 卡牌资源配置
+#include "configs/models/CardResConfig.h" // 卡牌资源配置
 #include "managers/CardManager.h"
-#include <functional>
 
 class CardManager;
+class CardIdManagerMap;
+class GameEventBus;
 USING_NS_CC;
 
 /*
@@ -25,21 +26,22 @@ public:
      * 静态创建方法
      * @param model 卡牌数据模型，提供花色、数值等信息
      * @param offset 位置偏移量，用于调整卡牌在场景中的显示位置
+     * @param cardManagers 所属对局的卡牌管理器映射（不持有），为nullptr时不登记
      * @return 成功返回CardView实例，失败返回nullptr
      */
-    static CardView* create(const CardModel& model, const Vec2& offset);
-    
+    static CardView* create(const CardModel& model, const Vec2& offset, CardIdManagerMap* cardManagers = nullptr);
+
     /**
-     * 点击回调函数类型定义
-     * 参数为触发事件的CardView实例
+     * 析构函数
+     * 释放关联的卡牌管理器
      */
-    using ClickCallback = std::function<void(CardView* cardView)>;
+    virtual ~CardView();
     
     /**
-     * 设置卡牌点击回调
-     * @param callback 回调函数，触摸结束时触发
+     * 设置事件总线，卡牌被点击时由管理器向其发布CardClickedEvent
+     * @param eventBus 事件总线（由GameView持有）
      */
-    void setClickCallback(const ClickCallback& callback);
+    void setEventBus(GameEventBus* eventBus);
 
     /**
      * 加载卡牌背景图
@@ -69,9 +71,10 @@ public:
      * 初始化方法
      * @param model 卡牌数据模型
      * @param offset 位置偏移量
+     * @param cardManagers 所属对局的卡牌管理器映射
      * @return 初始化成功返回true，否则返回false
      */
-    bool init(const CardModel& model, const Vec2& offset);
+    bool init(const CardModel& model, const Vec2& offset, CardIdManagerMap* cardManagers);
     
     /**
      * 判断触摸点是否在卡牌范围内
@@ -93,7 +96,6 @@ private:
     const Vec2 _suitIconPos = Vec2(80, 130);     // 右上角花色图标位置
     const Vec2 _bigNumberPos = Vec2(0, 0);       // 中间大数字位置
 
-    ClickCallback _clickCallback;  // 点击回调函数
     bool _isSelected = false;      // 卡牌选中状态标记
 };
 
@@ -1,8 +1,20 @@
 #include "GameView.h"
+#include "services/GameLog.h"
+#include <climits>
 
-GameView* GameView::create(GameModel& model) {
+namespace {
+    const int kMoveActionTag = 0x4d4f56; // 卡牌移动动画的标签，用于只停止移动动画
+    const float kMoveDuration = 0.5f;    // 卡牌移动动画时长（秒）
+    const int kUiZOrder = INT_MAX;       // 界面元素层级：手牌区层级区间随关卡规模上移且不设上限，界面取最高层
+    const int kHintActionTag = 0x48494e; // 提示高亮动画的标签
+    const float kHintPulseDuration = 0.15f; // 提示高亮单次缩放时长（秒）
+    const float kHintPulseScale = 1.15f;    // 提示高亮放大倍数
+    const float kAutoPlayInterval = kMoveDuration + 0.1f; // 自动对局两步之间的间隔（秒），等上一步动画播完
+}
+
+GameView* GameView::create(GameModel& model, std::shared_ptr<GameContext> context) {
     GameView* pRet = new(std::nothrow) GameView();
-    if (pRet && pRet->init(model)) {
+    if (pRet && pRet->init(model, std::move(context))) {
         pRet->autorelease();
         return pRet;
     }
@@ -10,13 +22,14 @@ GameView* GameView::create(GameModel& model) {
     return nullptr;
 }
 
-bool GameView::init(GameModel& model) {
+bool GameView::init(GameModel& model, std::shared_ptr<GameContext> context) {
     if (!Node::init()) {
         return false;
     }
+    _context = context ? std::move(context) : std::make_shared<GameContext>();
 
     // 初始化游戏控制器并关联模型
-    _gameController = std::make_unique<GameController>(model);
+    _gameController.reset(new GameController(model, _context.get()));
     if (!_gameController) {
         CCLOG("GameView: 创建GameController失败");
         return false;
@@ -25,17 +38,47 @@ bool GameView::init(GameModel& model) {
     // 生成所有卡牌视图
     generateCardViews(model);
 
+    // 启动后台提示服务，控制器每次操作后向其提交快照
+    _hintService.reset(new BoardSolver());
+    _hintService->start();
+    _gameController->setHintService(_hintService.get());
+
     // 1. 创建撤销标签（交互控件）
     _statusLabel = cocos2d::Label::createWithSystemFont(u8"撤销", "Microsoft YaHei", 36);
     if (!_statusLabel) {
         CCLOG("GameView: 创建状态标签失败");
-        CC_SAFE_DELETE(_gameController);
+        _gameController.reset();
         return false;
     }
 
     _statusLabel->setPosition(900, 400);
     _statusLabel->setTextColor(cocos2d::Color4B::WHITE);
-    this->addChild(_statusLabel, 100); // z轴层级100（确保显示在最上层）
+    this->addChild(_statusLabel, kUiZOrder); // 高于所有卡牌层级区间（确保显示在最上层）
+
+    // 创建提示标签（交互控件）
+    _hintLabel = cocos2d::Label::createWithSystemFont(u8"提示", "Microsoft YaHei", 36);
+    if (_hintLabel) {
+        _hintLabel->setPosition(900, 320);
+        _hintLabel->setTextColor(cocos2d::Color4B::WHITE);
+        this->addChild(_hintLabel, kUiZOrder);
+    }
+
+    // 创建自动对局标签（交互控件）
+    _autoPlayLabel = cocos2d::Label::createWithSystemFont(u8"自动", "Microsoft YaHei", 36);
+    if (_autoPlayLabel) {
+        _autoPlayLabel->setPosition(900, 240);
+        _autoPlayLabel->setTextColor(cocos2d::Color4B::WHITE);
+        this->addChild(_autoPlayLabel, kUiZOrder);
+    }
+
+    // 创建对局结果标签（过关、死局时显示）
+    _resultLabel = cocos2d::Label::createWithSystemFont("", "Microsoft YaHei", 48);
+    if (_resultLabel) {
+        _resultLabel->setPosition(900, 500);
+        _resultLabel->setTextColor(cocos2d::Color4B::YELLOW);
+        _resultLabel->setVisible(false);
+        this->addChild(_resultLabel, kUiZOrder);
+    }
 
     // 输出标签属性到日志
     CCLOG("标签尺寸: %f, %f",
@@ -47,68 +90,154 @@ bool GameView::init(GameModel& model) {
 
     // 2. 注册触摸事件监听器（处理标签点击）
     registerTouchEvents();
+
+    // 3. 订阅状态差异并开启每帧指令批处理
+    _boardDiffSubscription = _context->getEventBus().subscribe<BoardDiffEvent>([this](const BoardDiffEvent& event) {
+        onBoardDiff(event);
+    });
+    _clearedSubscription = _context->getEventBus().subscribe<LevelClearedEvent>([this](const LevelClearedEvent&) {
+        showResult(u8"过关");
+    });
+    _deadEndSubscription = _context->getEventBus().subscribe<NoMovesLeftEvent>([this](const NoMovesLeftEvent&) {
+        showResult(u8"无牌可走");
+    });
+    this->scheduleUpdate();
     return true;
 }
 
 void GameView::generateCardViews(GameModel& model) {
-    // 创建游戏区卡牌视图
-    const auto& playfield = model.getPlayfield();
-    for (const auto& cardModel : playfield) {
-        CardView* cardView = CardView::create(cardModel, Vec2(0, 0));
-        if (cardView) {
-            _playfieldCardViews.push_back(cardView);
-            this->addChild(cardView);
-        }
-        else {
-            CCLOG("GameView: 创建游戏区卡牌视图失败，ID: %d", cardModel._id);
+    // 按槽位顺序创建卡牌视图，各卡牌落在其区域层级区间内的原层级上
+    const CardStore& cards = model.getCards();
+    std::vector<std::pair<int, CardViewState>> initialStates;
+    initialStates.reserve(cards.size());
+    for (int slot = 0; slot < cards.size(); ++slot) {
+        CardModel cardModel = cards.toCardModel(slot);
+        CardView* cardView = CardView::create(cardModel, Vec2(0, 0), &_context->getCardManagers());
+        if (!cardView) {
+            CCLOG("GameView: 创建卡牌视图失败，ID: %d", cardModel._id);
+            continue;
         }
-    }
-
-    // 创建牌堆区卡牌视图
-    const auto& stackfield = model.getStackfield();
-    for (const auto& cardModel : stackfield) {
-        CardView* cardView = CardView::create(cardModel, Vec2(0, 0));
-        if (cardView) {
+        if (cardModel.getZone() == CardZone::Stack) {
             _stackfieldCardViews.push_back(cardView);
-            this->addChild(cardView);
         }
         else {
-            CCLOG("GameView: 创建牌堆区卡牌视图失败，ID: %d", cardModel._id);
+            _playfieldCardViews.push_back(cardView);
         }
+        this->addChild(cardView, cards.getHomeZOrder(slot));
+
+        // 以刚创建的视图作为调和基准
+        CardViewState state;
+        state.zone = cardModel.getZone();
+        state.position = cardModel.getPosition();
+        state.zOrder = cards.getHomeZOrder(slot);
+        initialStates.push_back(std::make_pair(cardModel._id, state));
     }
+    _reconciler.reset(initialStates);
 
-    // 卡牌点击处理逻辑（统一回调）
-    auto handleCardClick = [this](CardView* cardView) {
-        if (!cardView) return;
+    // 卡牌点击经事件总线同时派发给控制器（规则处理）与视图（选中反馈）
+    for (auto cardView : _playfieldCardViews) {
+        cardView->setEventBus(&_context->getEventBus());
+    }
+    for (auto cardView : _stackfieldCardViews) {
+        cardView->setEventBus(&_context->getEventBus());
+    }
+    _clickSubscription = _context->getEventBus().subscribe<CardClickedEvent>([this](const CardClickedEvent& event) {
+        onCardClicked(event);
+    });
+}
 
-        // 视觉反馈：降低透明度表示选中
-        cardView->setOpacity(180);
+void GameView::onCardClicked(const CardClickedEvent& event) {
+    CardManager* cardManager = _context->getCardManagers().getCardManager(event.cardId);
+    if (!cardManager || !cardManager->getView()) return;
 
-        // 通过管理器获取模型数据
-        CardModel& cardModel = cardView->_cardManager->getModel();
-        CCLOG(u8"卡牌点击 - ID: %d，区域: %d", 
-            cardModel._id, static_cast<int>(cardModel.getZone()));
+    // 视觉反馈：降低透明度表示选中
+    cardManager->getView()->setOpacity(180);
+    GLOG_DEBUG(u8"卡牌点击 - ID: %d", event.cardId);
+}
 
-        // 根据卡牌所在区域分发事件到控制器
-        if (cardModel.getZone() == CardZone::Playfield) {
-            _gameController->selectCardFromPlayefieldAndMatch(cardModel);
-        }
-        else if (cardModel.getZone() == CardZone::Stack) {
-            _gameController->clickStackCard(cardModel);
-        }
-    };
+void GameView::update(float dt) {
+    Node::update(dt);
+    if (_gameController) {
+        _gameController->processCommands();
+    }
+    if (_autoPlaying) {
+        updateAutoPlay(dt);
+    }
+}
 
-    // 为游戏区卡牌绑定点击回调
-    for (auto cardView : _playfieldCardViews) {
-        if (cardView) {
-            cardView->setClickCallback(handleCardClick);
-        }
+void GameView::setSolutionTable(std::unique_ptr<SolutionTable> solutionTable) {
+    _solutionTable = std::move(solutionTable);
+    _gameController->setSolutionTable(_solutionTable.get());
+}
+
+void GameView::setAutoPlay(bool enabled) {
+    if (enabled && !_autoPlayer) {
+        _autoPlayer.reset(new AutoPlayer());
+    }
+    _autoPlaying = enabled;
+    _autoPlayCooldown = 0.0f;
+    if (_autoPlayLabel) {
+        _autoPlayLabel->setString(enabled ? u8"停止" : u8"自动");
     }
+}
 
-    // 为牌堆区卡牌绑定点击回调
-    for (auto cardView : _stackfieldCardViews) {
-        if (cardView) {
-            cardView->setClickCallback(handleCardClick);
+void GameView::updateAutoPlay(float dt) {
+    _autoPlayCooldown -= dt;
+    if (_autoPlayCooldown > 0.0f) {
+        return;
+    }
+    if (!_gameController || !_autoPlayer->step(*_gameController)) {
+        GLOG_INFO(u8"自动对局结束 - 移动次数：%d", _gameController ? _gameController->getMoveCount() : 0);
+        setAutoPlay(false);
+        return;
+    }
+    _autoPlayCooldown = kAutoPlayInterval;
+}
+
+void GameView::onBoardDiff(const BoardDiffEvent& event) {
+    _viewOps.clear();
+    _reconciler.reconcile(event.changes, event.count, _viewOps);
+    applyViewOps(_viewOps);
+
+    // 撤销、重开后回到进行中，收起结果标签
+    if (_resultLabel && _gameController && _gameController->getStatus() == GameStatus::Playing) {
+        _resultLabel->setVisible(false);
+    }
+}
+
+void GameView::showResult(const char* text) {
+    if (!_resultLabel) return;
+    _resultLabel->setString(text);
+    _resultLabel->setVisible(true);
+}
+
+void GameView::applyViewOps(const std::vector<ViewOp>& ops) {
+    for (const auto& op : ops) {
+        CardManager* cardManager = _context->getCardManagers().getCardManager(op.cardId);
+        if (!cardManager || !cardManager->getView()) {
+            GLOG_DEBUG(u8"视图操作的卡牌没有视图 - ID：%d", op.cardId);
+            continue;
+        }
+
+        CardView* cardView = cardManager->getView();
+        switch (op.type) {
+        case ViewOp::Move: {
+            // 只停止该卡牌上仍在进行的移动动画，避免新旧MoveTo交错
+            cardView->stopActionByTag(kMoveActionTag);
+            auto moveTo = cocos2d::MoveTo::create(kMoveDuration, op.position);
+            moveTo->setTag(kMoveActionTag);
+            cardView->runAction(moveTo);
+            break;
+        }
+        case ViewOp::ReorderZ:
+            cardView->setLocalZOrder(op.zOrder);
+            break;
+        case ViewOp::Reveal:
+            cardView->setVisible(true);
+            break;
+        case ViewOp::Hide:
+            cardView->setVisible(false);
+            break;
         }
     }
 }
@@ -122,36 +251,50 @@ void GameView::registerTouchEvents() {
 
     touchListener->setSwallowTouches(true);
 
-    // 触摸开始：检测是否点击标签
+    // 触摸开始：检测是否点击撤销或提示标签
     touchListener->onTouchBegan = [this](cocos2d::Touch* touch, cocos2d::Event* event) {
-        if (!touch || !_statusLabel) return false;
+        if (!touch) return false;
 
         cocos2d::Vec2 touchPos = this->convertToNodeSpace(touch->getLocation());
-        if (_statusLabel->getBoundingBox().containsPoint(touchPos)) {
-            _statusLabel->setScale(1.2f); // 触摸缩放反馈
-            return true;
+        for (cocos2d::Label* label : { _statusLabel, _hintLabel, _autoPlayLabel }) {
+            if (label && label->getBoundingBox().containsPoint(touchPos)) {
+                _pressedLabel = label;
+                label->setScale(1.2f); // 触摸缩放反馈
+                return true;
+            }
         }
         return false;
     };
 
     // 触摸结束：处理标签点击事件
     touchListener->onTouchEnded = [this](cocos2d::Touch* touch, cocos2d::Event* event) {
-        if (!_statusLabel) return;
+        cocos2d::Label* label = _pressedLabel;
+        _pressedLabel = nullptr;
+        if (!label) return;
 
-        _statusLabel->setScale(1.0f); // 恢复缩放
+        label->setScale(1.0f); // 恢复缩放
 
         if (touch) {
             cocos2d::Vec2 touchPos = this->convertToNodeSpace(touch->getLocation());
-            if (_statusLabel->getBoundingBox().containsPoint(touchPos)) {
-                onLabelClicked(); // 触发撤销操作
+            if (label->getBoundingBox().containsPoint(touchPos)) {
+                if (label == _hintLabel) {
+                    onHintClicked();
+                }
+                else if (label == _autoPlayLabel) {
+                    setAutoPlay(!_autoPlaying);
+                }
+                else {
+                    onLabelClicked(); // 触发撤销操作
+                }
             }
         }
     };
 
     // 触摸取消：恢复标签状态
     touchListener->onTouchCancelled = [this](cocos2d::Touch* touch, cocos2d::Event* event) {
-        if (_statusLabel) {
-            _statusLabel->setScale(1.0f);
+        if (_pressedLabel) {
+            _pressedLabel->setScale(1.0f);
+            _pressedLabel = nullptr;
         }
     };
 
@@ -159,12 +302,53 @@ void GameView::registerTouchEvents() {
 }
 
 void GameView::onLabelClicked() {
-    CCLOG(u8"撤销标签被点击 - 触发撤销操作");
+    GLOG_DEBUG(u8"撤销标签被点击 - 触发撤销操作");
     if (_gameController) {
         _gameController->handleLabelClick();
     }
 }
 
+void GameView::onHintClicked() {
+    HintMove hint;
+    bool precomputed = _solutionTable && _solutionTable->lookup(_gameController->getGameModel(), hint);
+    if (!precomputed && (!_hintService || !_hintService->getHint(hint))) {
+        GLOG_INFO(u8"提示尚在计算中");
+        return;
+    }
+    if (!hint.isValid()) {
+        GLOG_INFO(u8"提示：当前局面已无可用走法");
+        return;
+    }
+
+    CardManager* cardManager = _context->getCardManagers().getCardManager(hint.cardId);
+    if (!cardManager || !cardManager->getView()) return;
+
+    // 放大再复原两次，提示建议操作的卡牌
+    CardView* cardView = cardManager->getView();
+    cardView->stopActionByTag(kHintActionTag);
+    cardView->setScale(1.0f);
+    auto pulse = cocos2d::Sequence::create(
+        cocos2d::ScaleTo::create(kHintPulseDuration, kHintPulseScale),
+        cocos2d::ScaleTo::create(kHintPulseDuration, 1.0f),
+        cocos2d::ScaleTo::create(kHintPulseDuration, kHintPulseScale),
+        cocos2d::ScaleTo::create(kHintPulseDuration, 1.0f),
+        nullptr);
+    pulse->setTag(kHintActionTag);
+    cardView->runAction(pulse);
+    GLOG_DEBUG(u8"提示 - 卡牌ID：%d，来自牌堆区：%d，深度：%d，查表：%d",
+        hint.cardId, hint.fromStack ? 1 : 0, hint.depth, precomputed ? 1 : 0);
+}
+
 // 析构函数 - 智能指针会自动释放资源
 GameView::~GameView() {
+    // 上下文由场景等共同持有，可能比本视图活得久：注销捕获this的订阅，之后的事件不再派发到已释放的视图
+    if (_context) {
+        GameEventBus& eventBus = _context->getEventBus();
+        eventBus.unsubscribe<BoardDiffEvent>(_boardDiffSubscription);
+        eventBus.unsubscribe<LevelClearedEvent>(_clearedSubscription);
+        eventBus.unsubscribe<NoMovesLeftEvent>(_deadEndSubscription);
+        eventBus.unsubscribe<CardClickedEvent>(_clickSubscription);
+    }
+    // 卡牌视图随子节点释放时会从上下文的映射中注销，需在上下文可能随本视图一起释放之前完成
+    this->removeAllChildrenWithCleanup(true);
 }
\ No newline at end of file
@@ -4,9 +4,14 @@
 #include "cocos2d.h"
 #include "models/GameModel.h"
 #include "CardView.h"
+#include "BoardReconciler.h"
 #include <vector>
 #include <memory>
 #include "controllers/GameController.h"
+#include "services/GameContext.h"
+#include "services/BoardSolver.h"
+#include "services/AutoPlayer.h"
+#include "services/SolutionTable.h"
 
 USING_NS_CC;
 
@@ -14,29 +19,84 @@ USING_NS_CC;
 游戏主视图类，负责管理全局游戏界面元素与交互
 核心功能：
 1. 管理游戏区（Playfield）和牌堆区（Stack）的所有卡牌视图
-2. 维护全局UI元素（如撤销标签）并处理其交互事件
+2. 维护全局UI元素（撤销、提示标签）并处理其交互事件
 3. 通过GameController衔接视图与数据模型，转发用户操作
+4. 共享持有对局上下文（GameContext），控制器与卡牌管理器通过其中的事件总线传递点击与规则事件，
+   通过其中的卡牌管理器映射按ID定位卡牌；每个GameView各用一份上下文，可同时存在多个棋盘
+5. 每帧驱动控制器执行排队的玩家指令，合并后的状态差异经BoardReconciler调和，
+   只对状态真正改变的卡牌执行移动、调层级、显示、隐藏操作
+6. 持有后台提示服务（BoardSolver），点击提示标签时高亮其给出的最佳走法；
+   关卡附带预计算提示表时先查表，局面不在表中才使用实时搜索的结果
+7. 订阅关卡完成、死局事件并显示结果标签，撤销或重开回到进行中时隐藏
+8. 自动对局：点击"自动"标签（或调用setAutoPlay）后由AutoPlayer每隔一段时间走一步，
+   走法经控制器指令队列执行，动画与撤销照常；对局结束或无路可走时自动停止
  */
 class GameView : public Node {
 public:
     /*
     静态创建方法，初始化游戏视图并关联数据模型
     @param model 游戏数据模型，包含需要显示的卡牌信息
+    @param context 对局上下文，为nullptr时使用默认布局新建一份
     @return 成功创建返回GameView实例，失败返回nullptr
     */
-    static GameView* create(GameModel& model);
+    static GameView* create(GameModel& model, std::shared_ptr<GameContext> context = nullptr);
+
+    /*
+    析构函数：先移除卡牌视图（其管理器要从上下文的映射中注销），控制器由智能指针自动释放
+    */
+    virtual ~GameView();
+
+    // 获取游戏区卡牌视图集合（供压力测试等脚本驱动使用）
+    const std::vector<CardView*>& getPlayfieldCardViews() const { return _playfieldCardViews; }
+
+    // 获取牌堆区卡牌视图集合
+    const std::vector<CardView*>& getStackfieldCardViews() const { return _stackfieldCardViews; }
+
+    // 获取撤销按钮节点（供脚本注入触摸事件时定位）
+    cocos2d::Node* getUndoButton() const { return _statusLabel; }
+
+    // 获取提示按钮节点
+    cocos2d::Node* getHintButton() const { return _hintLabel; }
+
+    // 获取游戏控制器（供脚本与自动对局提交指令）
+    GameController* getGameController() const { return _gameController.get(); }
+
+    // 获取自动对局按钮节点
+    cocos2d::Node* getAutoPlayButton() const { return _autoPlayLabel; }
+
+    /*
+    开启或停止自动对局（演示模式、"帮我走"、无界面浸泡测试）
+    @param enabled true为开启
+    */
+    void setAutoPlay(bool enabled);
+
+    /*
+    接入关卡的预计算提示表（随关卡发布，首次查询时才读取文件）
+    @param solutionTable 提示表
+    */
+    void setSolutionTable(std::unique_ptr<SolutionTable> solutionTable);
+
+    // 是否正在自动对局
+    bool isAutoPlaying() const { return _autoPlaying; }
+
+    /*
+    每帧回调：让控制器批量执行本帧排队的指令
+    @param dt 帧间隔（秒）
+    */
+    virtual void update(float dt) override;
 
 protected:
     /*
     初始化方法，设置视图层级与控制器
     @param model 游戏数据模型
+    @param context 对局上下文
     @return 初始化成功返回true，否则返回false
     */
-    bool init(GameModel& model);
+    bool init(GameModel& model, std::shared_ptr<GameContext> context);
 
     /*
     根据游戏模型生成所有卡牌视图
-    为每个卡牌创建对应的CardView并绑定点击事件
+    为每个卡牌创建对应的CardView并接入事件总线
     @param model 游戏数据模型，包含卡牌集合信息
     */
     void generateCardViews(GameModel& model);
@@ -45,8 +105,48 @@ private:
     std::vector<CardView*> _playfieldCardViews; // 游戏区卡牌视图集合
     std::vector<CardView*> _stackfieldCardViews; // 牌堆区卡牌视图集合
 
-    cocos2d::Label* _statusLabel; // 状态标签（可作为撤销按钮）
+    cocos2d::Label* _statusLabel = nullptr; // 状态标签（可作为撤销按钮）
+    cocos2d::Label* _hintLabel = nullptr; // 提示按钮
+    cocos2d::Label* _autoPlayLabel = nullptr; // 自动对局按钮
+    cocos2d::Label* _pressedLabel = nullptr; // 当前按下的标签
+    cocos2d::Label* _resultLabel = nullptr; // 对局结果标签（过关、死局时显示）
+    std::shared_ptr<GameContext> _context; // 对局上下文（声明在控制器之前，保证比控制器后析构）
+    int _boardDiffSubscription = -1; // 状态差异事件的订阅句柄（上下文可能比视图活得久，析构时注销）
+    int _clearedSubscription = -1; // 过关事件的订阅句柄
+    int _deadEndSubscription = -1; // 死局事件的订阅句柄
+    int _clickSubscription = -1; // 卡牌点击事件的订阅句柄
+    BoardReconciler _reconciler; // 视图调和器，记录各卡牌当前显示状态
+    std::vector<ViewOp> _viewOps; // 调和结果缓冲区（复用，避免每帧分配）
+    std::unique_ptr<BoardSolver> _hintService; // 后台提示服务（声明在控制器之前，保证比控制器后析构）
+    std::unique_ptr<SolutionTable> _solutionTable; // 预计算提示表（同上，控制器持有其裸指针）
     std::unique_ptr<GameController> _gameController; // 游戏控制器，处理业务逻辑
+    std::unique_ptr<AutoPlayer> _autoPlayer; // 自动对局机器人（首次开启时创建）
+    bool _autoPlaying = false; // 是否正在自动对局
+    float _autoPlayCooldown = 0.0f; // 距自动对局下一步的剩余时间（秒）
+
+    /*
+    卡牌点击事件处理：为被点击的卡牌提供视觉反馈
+    @param event 卡牌点击事件
+    */
+    void onCardClicked(const CardClickedEvent& event);
+
+    /*
+    状态差异处理：经调和器计算最小视图操作后执行
+    @param event 合并后的状态差异
+    */
+    void onBoardDiff(const BoardDiffEvent& event);
+
+    /*
+    显示对局结果
+    @param text 结果文字
+    */
+    void showResult(const char* text);
+
+    /*
+    执行视图操作
+    @param ops 调和器输出的操作序列
+    */
+    void applyViewOps(const std::vector<ViewOp>& ops);
 
     /*
     标签点击事件处理方法
@@ -54,6 +154,18 @@ private:
     */
     void onLabelClicked();
 
+    /*
+    提示标签点击事件处理方法
+    读取提示服务的最新结果并高亮建议操作的卡牌
+    */
+    void onHintClicked();
+
+    /*
+    自动对局的每帧推进：上一步动画播完后走下一步，无路可走时停止
+    @param dt 帧间隔（秒）
+    */
+    void updateAutoPlay(float dt);
+
     /*
     注册触摸事件监听器
     处理全局UI元素（如标签）的触摸交互
@@ -0,0 +1,403 @@
+/*
+关卡流水线：离线批量处理关卡JSON文件，与游戏使用同一套加载、规则、求解代码
+子命令：
+1. compile <关卡目录> <输出目录> [--threads N] [--nodes N] [--playouts N] [--hint-nodes N] [--tablebase 文件]
+   在线程池上并行处理目录下的全部.json关卡：按LevelConfigLoader的规则严格校验，机器人求解并估计难度，
+   把初始棋盘以SaveStateCodec格式写成<关卡名>.cgss，解出的关卡再写出预计算提示表<关卡名>.hints
+   （随关卡文件一起放入Resources；--hint-nodes 0不生成），最后按文件名顺序写出report.csv；有无效关卡时退出码为1
+   搜索一律按节点数上限，每个关卡使用新的求解器（置换表不跨关卡），除耗时列外输出与机器速度、线程数无关
+2. tablebase <输出文件>
+   生成残局库（默认与首尾相接两种规则），供compile的--tablebase使用；残局库只在离线工具中使用，不随游戏发布
+3. builtin <资源目录> <输出头文件> <关卡文件>...
+   把指定的首批关卡（路径相对于资源目录，即游戏内使用的关卡名）严格校验后写成constexpr数组，
+   供BuiltinLevelLoader在启动时免读文件加载；内容未变时不改写输出文件，避免触发重新编译
+ */
+#include "configs/loaders/LevelConfigLoader.h"
+#include "models/GameModel.h"
+#include "services/DifficultyEstimator.h"
+#include "services/EndgameTablebase.h"
+#include "services/PerfMonitor.h"
+#include "services/SaveStateCodec.h"
+#include "services/SolutionTable.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const char kLevelSuffix[] = ".json";        // 关卡文件扩展名
+    const char kPackedSuffix[] = ".cgss";       // 打包关卡扩展名
+    const char kHintsSuffix[] = ".hints";       // 提示表扩展名
+    const char kReportFile[] = "report.csv";    // 报告文件名
+
+    /**
+     * compile子命令的参数
+     */
+    struct CompileOptions {
+        std::string levelDir;                                       // 关卡目录
+        std::string outDir;                                         // 输出目录
+        int threads = 0;                                            // 线程数，0表示按硬件线程数
+        uint64_t nodes = DifficultyEstimator::kDefaultNodeLimit;    // 引导对局每步的搜索节点数上限
+        int playouts = DifficultyEstimator::kDefaultPlayouts;       // 随机对局局数
+        uint64_t hintNodes = 20000;                                 // 提示表偏离局面每步的搜索节点数上限，0表示不生成
+        std::string tablebase;                                      // 残局库文件，空表示不使用
+    };
+
+    /**
+     * 单个关卡的处理结果（报告的一行）
+     */
+    struct LevelResult {
+        std::string name;               // 关卡文件名（不含目录）
+        bool valid = false;             // 通过校验
+        std::vector<std::string> errors; // 校验问题或输出失败原因
+        int playfieldCount = 0;         // 游戏区卡牌数
+        int stackCount = 0;             // 牌堆区卡牌数
+        RuleVariant variant = RuleVariant::Adjacent; // 规则变体
+        DifficultyReport difficulty;    // 难度评估
+        size_t packedBytes = 0;         // 打包后的字节数
+        uint32_t hintEntries = 0;       // 提示表收录的局面数
+        double elapsedMs = 0.0;         // 处理耗时
+    };
+
+    void printUsage() {
+        std::fprintf(stderr,
+            "usage:\n"
+            "  level_pipeline compile <level_dir> <out_dir> [--threads N] [--nodes N] [--playouts N]\n"
+            "                 [--hint-nodes N] [--tablebase FILE]\n"
+            "  level_pipeline tablebase <out_file>\n"
+            "  level_pipeline builtin <resource_dir> <out_header> <level_file>...\n");
+    }
+
+    bool endsWith(const std::string& text, const char* suffix) {
+        const size_t length = std::strlen(suffix);
+        return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+    }
+
+    std::string baseName(const std::string& path) {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    bool readText(const std::string& path, std::string& outText) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outText = buffer.str();
+        return true;
+    }
+
+    // CSV字段转义：含逗号、引号或换行时整体加引号，内部引号加倍
+    std::string csvField(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (char c : text) {
+            quoted += c;
+            if (c == '"') {
+                quoted += '"';
+            }
+        }
+        return quoted + "\"";
+    }
+
+    /**
+     * 处理一个关卡：校验、评估、打包
+     * @param path 关卡文件完整路径
+     * @param options 子命令参数
+     * @param tablebase 残局库（未打开时为nullptr）
+     * @param outResult 输出参数，接收处理结果
+     */
+    void processLevel(const std::string& path, const CompileOptions& options, const EndgameTablebase* tablebase,
+        LevelResult& outResult) {
+        const uint64_t startNs = PerfMonitor::nowNs();
+        outResult.name = baseName(path);
+
+        std::string json;
+        LevelConfig* config = nullptr;
+        if (!readText(path, json)) {
+            outResult.errors.push_back("无法读取文件");
+        }
+        else {
+            config = LevelConfigLoader::validateLevelConfig(json, outResult.errors);
+        }
+        if (config) {
+            GameModel model(config);
+            outResult.valid = true;
+            outResult.playfieldCount = static_cast<int>(config->getPlayfield().size());
+            outResult.stackCount = static_cast<int>(config->getStack().size());
+            outResult.variant = config->getRuleParams().variant;
+            LevelConfigLoader::releaseLevelConfig(config);
+
+            // 每个关卡新建评估器与求解器：置换表不带入上一关卡的内容，结果与关卡分到哪个线程无关
+            DifficultyEstimator estimator(options.nodes, options.playouts);
+            estimator.setTablebase(tablebase);
+            outResult.difficulty = estimator.estimate(model);
+
+            std::vector<uint8_t> packed;
+            const std::string stem = outResult.name.substr(0, outResult.name.size() - std::strlen(kLevelSuffix));
+            if (!SaveStateCodec::encode(model, model, 0, 0, packed) ||
+                !SaveStateCodec::writeFile(options.outDir + "/" + stem + kPackedSuffix, packed)) {
+                outResult.errors.push_back("打包文件写入失败");
+            }
+            outResult.packedBytes = packed.size();
+
+            std::vector<uint8_t> hints;
+            if (outResult.difficulty.solvable && options.hintNodes > 0) {
+                BoardSolver hintSolver;
+                hintSolver.setTablebase(tablebase);
+                outResult.hintEntries = SolutionTable::build(model, outResult.difficulty.solution, hintSolver,
+                    options.hintNodes, hints);
+                if (outResult.hintEntries > 0 &&
+                    !SaveStateCodec::writeFile(options.outDir + "/" + stem + kHintsSuffix, hints)) {
+                    outResult.errors.push_back("提示表写入失败");
+                }
+            }
+        }
+        outResult.elapsedMs = static_cast<double>(PerfMonitor::nowNs() - startNs) / 1e6;
+    }
+
+    bool writeReport(const std::string& path, const std::vector<LevelResult>& results) {
+        std::ofstream report(path, std::ios::binary);
+        report << "level,valid,playfield,stack,rule,solvable,solution_length,random_win_rate,avg_choices,"
+            "score,tier,nodes,packed_bytes,hint_states,ms,errors\n";
+        char numbers[256];
+        for (const LevelResult& result : results) {
+            std::string errors;
+            for (const std::string& error : result.errors) {
+                errors += errors.empty() ? error : "; " + error;
+            }
+            const DifficultyReport& difficulty = result.difficulty;
+            std::snprintf(numbers, sizeof(numbers), "%d,%d,%d,%s,%d,%d,%.3f,%.2f,%d,%s,%llu,%u,%u,%.1f",
+                result.valid ? 1 : 0, result.playfieldCount, result.stackCount,
+                result.valid ? RuleParams::variantName(result.variant) : "", difficulty.solvable ? 1 : 0,
+                static_cast<int>(difficulty.solution.size()), difficulty.randomWinRate, difficulty.averageChoices,
+                difficulty.score, result.valid ? DifficultyEstimator::tierName(difficulty.score) : "",
+                static_cast<unsigned long long>(difficulty.nodes), static_cast<unsigned>(result.packedBytes),
+                result.hintEntries, result.elapsedMs);
+            report << csvField(result.name) << ',' << numbers << ',' << csvField(errors) << '\n';
+        }
+        return static_cast<bool>(report.flush());
+    }
+
+    bool parseCompileOptions(int argc, char** argv, CompileOptions& outOptions) {
+        if (argc < 4) {
+            return false;
+        }
+        outOptions.levelDir = argv[2];
+        outOptions.outDir = argv[3];
+        for (int i = 4; i < argc; ++i) {
+            const bool hasValue = i + 1 < argc;
+            if (hasValue && std::strcmp(argv[i], "--threads") == 0) {
+                outOptions.threads = std::atoi(argv[++i]);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--nodes") == 0) {
+                outOptions.nodes = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--playouts") == 0) {
+                outOptions.playouts = std::atoi(argv[++i]);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--hint-nodes") == 0) {
+                outOptions.hintNodes = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--tablebase") == 0) {
+                outOptions.tablebase = argv[++i];
+            }
+            else {
+                std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+                return false;
+            }
+        }
+        return outOptions.nodes > 0 && outOptions.playouts >= 0;
+    }
+
+    int runCompile(const CompileOptions& options) {
+        cocos2d::FileUtils* fileUtils = cocos2d::FileUtils::getInstance();
+        std::vector<std::string> levels;
+        for (const std::string& path : fileUtils->listFiles(options.levelDir)) {
+            if (endsWith(path, kLevelSuffix)) {
+                levels.push_back(path);
+            }
+        }
+        std::sort(levels.begin(), levels.end());
+        if (levels.empty()) {
+            std::fprintf(stderr, "no %s files in %s\n", kLevelSuffix, options.levelDir.c_str());
+            return 1;
+        }
+        if (!fileUtils->isDirectoryExist(options.outDir) && !fileUtils->createDirectory(options.outDir)) {
+            std::fprintf(stderr, "cannot create %s\n", options.outDir.c_str());
+            return 1;
+        }
+
+        EndgameTablebase tablebase;
+        if (!options.tablebase.empty() && !tablebase.open(options.tablebase)) {
+            std::fprintf(stderr, "cannot open tablebase %s\n", options.tablebase.c_str());
+            return 1;
+        }
+
+        // 线程池：各工作线程从共享下标领取下一个关卡，结果按关卡下标写回
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        const int threadCount = std::max(1, std::min(options.threads > 0 ? options.threads : static_cast<int>(hardwareThreads),
+            static_cast<int>(levels.size())));
+        std::vector<LevelResult> results(levels.size());
+        std::atomic<size_t> nextLevel(0);
+        const uint64_t startNs = PerfMonitor::nowNs();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&] {
+                for (size_t i = nextLevel++; i < levels.size(); i = nextLevel++) {
+                    processLevel(levels[i], options, tablebase.isOpen() ? &tablebase : nullptr, results[i]);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        int invalid = 0;
+        int solvable = 0;
+        for (const LevelResult& result : results) {
+            invalid += result.valid && result.errors.empty() ? 0 : 1;
+            solvable += result.difficulty.solvable ? 1 : 0;
+        }
+        const std::string reportPath = options.outDir + "/" + kReportFile;
+        if (!writeReport(reportPath, results)) {
+            std::fprintf(stderr, "cannot write %s\n", reportPath.c_str());
+            return 1;
+        }
+        std::printf("%d levels, %d invalid, %d solvable, %d threads, %.1fs -> %s\n",
+            static_cast<int>(levels.size()), invalid, solvable, threadCount,
+            static_cast<double>(PerfMonitor::nowNs() - startNs) / 1e9, reportPath.c_str());
+        return invalid > 0 ? 1 : 0;
+    }
+
+    int runTablebase(int argc, char** argv) {
+        if (argc < 3) {
+            printUsage();
+            return 2;
+        }
+        RuleParams adjacent;
+        RuleParams wraparound;
+        wraparound.variant = RuleVariant::Wraparound;
+        return EndgameTablebase::generate({ adjacent, wraparound }, argv[2]) ? 0 : 1;
+    }
+
+    // 输出一组内置卡牌的constexpr数组
+    void writeBuiltinCards(std::ostringstream& header, const std::string& name, const std::vector<CardModel>& cards) {
+        header << "constexpr BuiltinCard " << name << "[] = {\n";
+        for (const CardModel& card : cards) {
+            header << "    { " << static_cast<int>(card.getFace()) << ", " << static_cast<int>(card.getSuit()) << ", "
+                << static_cast<int>(std::lround(card.getPosition().x)) << ", "
+                << static_cast<int>(std::lround(card.getPosition().y)) << " },\n";
+        }
+        header << "};\n\n";
+    }
+
+    int runBuiltin(int argc, char** argv) {
+        if (argc < 5) {
+            printUsage();
+            return 2;
+        }
+        const std::string resourceDir = argv[2];
+        const std::string outPath = argv[3];
+
+        // 零偏移布局加载，保存关卡文件中的原始坐标，运行时再按棋盘布局偏移
+        BoardLayout rawLayout;
+        rawLayout.playfieldOffset = cocos2d::Vec2::ZERO;
+        rawLayout.stackOffset = cocos2d::Vec2::ZERO;
+
+        std::ostringstream header;
+        header << "// 由 level_pipeline builtin 生成，请勿手工修改；改动下列关卡文件后重新生成并提交\n";
+        for (int i = 4; i < argc; ++i) {
+            header << "// " << argv[i] << "\n";
+        }
+        header << "#pragma once\n"
+            "#ifndef CONFIGS_GENERATED_BUILTINLEVELS_H\n"
+            "#define CONFIGS_GENERATED_BUILTINLEVELS_H\n\n"
+            "#include \"configs/models/BuiltinLevel.h\"\n\n";
+
+        std::ostringstream table;
+        bool valid = true;
+        for (int i = 4; i < argc; ++i) {
+            const std::string levelFile = argv[i];
+            std::string json;
+            std::vector<std::string> errors;
+            LevelConfig* config = nullptr;
+            if (!readText(resourceDir + "/" + levelFile, json)) {
+                errors.push_back("无法读取文件");
+            }
+            else {
+                config = LevelConfigLoader::validateLevelConfig(json, errors, rawLayout);
+            }
+            if (!config) {
+                for (const std::string& error : errors) {
+                    std::fprintf(stderr, "%s: %s\n", levelFile.c_str(), error.c_str());
+                }
+                valid = false;
+                continue;
+            }
+
+            const std::vector<CardModel> playfield = config->getPlayfield();
+            const std::vector<CardModel> stack = config->getStack();
+            const RuleParams ruleParams = config->getRuleParams();
+            LevelConfigLoader::releaseLevelConfig(config);
+
+            const std::string prefix = "kBuiltinLevel" + std::to_string(i - 4);
+            writeBuiltinCards(header, prefix + "Playfield", playfield);
+            if (!stack.empty()) {
+                writeBuiltinCards(header, prefix + "Stack", stack);
+            }
+            table << "    { \"" << levelFile << "\", RuleVariant::" << RuleParams::variantName(ruleParams.variant) << ", "
+                << ruleParams.wildFace << ", " << prefix << "Playfield, " << playfield.size() << ", "
+                << (stack.empty() ? std::string("nullptr") : prefix + "Stack") << ", " << stack.size() << " },\n";
+        }
+        if (!valid) {
+            return 1;
+        }
+        header << "constexpr BuiltinLevel kBuiltinLevels[] = {\n" << table.str() << "};\n\n"
+            "#endif // CONFIGS_GENERATED_BUILTINLEVELS_H\n";
+
+        std::string existing;
+        if (readText(outPath, existing) && existing == header.str()) {
+            std::printf("%s is up to date\n", outPath.c_str());
+            return 0;
+        }
+        std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+        out << header.str();
+        if (!out.flush()) {
+            std::fprintf(stderr, "cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+        std::printf("wrote %d built-in levels to %s\n", argc - 4, outPath.c_str());
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "compile") == 0) {
+        CompileOptions options;
+        if (!parseCompileOptions(argc, argv, options)) {
+            printUsage();
+            return 2;
+        }
+        return runCompile(options);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "tablebase") == 0) {
+        return runTablebase(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "builtin") == 0) {
+        return runBuiltin(argc, argv);
+    }
+    printUsage();
+    return 2;
+}